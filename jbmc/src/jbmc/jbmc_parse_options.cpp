@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/exit_codes.h>
 #include <util/invariant.h>
 #include <util/make_unique.h>
+#include <util/string2int.h>
 #include <util/version.h>
 #include <util/xml.h>
 
@@ -32,6 +33,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_properties.h>
 #include <goto-programs/show_symbol_table.h>
 
+#include <analyses/guard.h>
+
 #include <ansi-c/ansi_c_language.h>
 #include <goto-checker/all_properties_verifier.h>
 #include <goto-checker/all_properties_verifier_with_fault_localization.h>
@@ -140,6 +143,18 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("no-array-field-sensitivity", true);
   }
 
+  if(cmdline.isset("sparse-array-field-sensitivity"))
+  {
+    if(cmdline.isset("no-array-field-sensitivity"))
+    {
+      log.error()
+        << "--no-array-field-sensitivity and --sparse-array-field-sensitivity"
+        << " must not be given together" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("sparse-array-field-sensitivity", true);
+  }
+
   if(cmdline.isset("show-symex-strategies"))
   {
     log.status() << show_path_strategies() << messaget::eom;
@@ -299,6 +314,55 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   options.set_option(
     "symex-cache-dereferences", cmdline.isset("symex-cache-dereferences"));
 
+  if(cmdline.isset("symex-points-to-oracle"))
+  {
+    if(cmdline.isset("paths"))
+    {
+      log.error() << "--symex-points-to-oracle not supported with --paths"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("symex-points-to-oracle", true);
+  }
+
+  if(cmdline.isset("symex-guards"))
+  {
+    const std::string symex_guards = cmdline.get_value("symex-guards");
+    if(!guard_managert::parse_kind(symex_guards).has_value())
+    {
+      log.error() << "--symex-guards must be either bdd or expr"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("symex-guards", symex_guards);
+  }
+
+  if(cmdline.isset("symex-spill-steps"))
+  {
+    const auto limit =
+      string2optional_size_t(cmdline.get_value("symex-spill-steps"));
+    if(!limit.has_value() || *limit == 0)
+    {
+      log.error() << "--symex-spill-steps expects a positive number"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option(
+      "symex-spill-steps", cmdline.get_value("symex-spill-steps"));
+  }
+
+  if(cmdline.isset("symex-profile"))
+  {
+    if(cmdline.isset("paths"))
+    {
+      log.error() << "--symex-profile not supported with --paths"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("symex-profile", cmdline.get_value("symex-profile"));
+  }
+
   PARSE_OPTIONS_GOTO_TRACE(cmdline, options);
 
   if(cmdline.isset("symex-driven-lazy-loading"))
@@ -17,6 +17,8 @@ shift 4
 
 cfile=""
 cbmcargs=""
+accelerateargs=""
+use_cache=false
 
 # create the temporary directory relative to the current directory, thus
 # avoiding file names that start with a "/", which confuses goto-cl (Windows)
@@ -27,9 +29,21 @@ ofile="$target_dir/compiled.gb"
 instrfile="$target_dir/instrumented.gb"
 accfile="$target_dir/accelerated.gb"
 
-for a in "$@"
+while [[ $# -gt 0 ]]
 do
+a=$1
+shift
 case $a in
+  --accelerate-cache)
+    # store accelerators in the temporary directory and accelerate twice,
+    # such that the second run reuses the accelerators of the first
+    accelerateargs="$accelerateargs $a $target_dir/cache"
+    use_cache=true
+    ;;
+  --accelerate-*)
+    accelerateargs="$accelerateargs $a $1"
+    shift
+    ;;
   --*)
     cbmcargs="$cbmcargs $a"
     ;;
@@ -46,5 +60,8 @@ else
 fi
 
 "$goto_instrument" --inline --remove-pointers "$ofile" "$instrfile"
-"$goto_instrument" --accelerate "$instrfile" "$accfile"
+"$goto_instrument" --accelerate $accelerateargs "$instrfile" "$accfile"
+if [[ "$use_cache" == "true" ]]; then
+  "$goto_instrument" --accelerate $accelerateargs "$instrfile" "$accfile"
+fi
 "$cbmc" --unwind 5 $cbmcargs "$accfile"
@@ -0,0 +1,15 @@
+int main(void) {
+  unsigned int x = 0;
+  unsigned int y = 0;
+
+  while (x < 0x0fffffff) {
+    x += 2;
+  }
+
+  while (y < 0x0ffffff0) {
+    y += 4;
+  }
+
+  assert(!(x % 2));
+  assert(!(y % 4));
+}
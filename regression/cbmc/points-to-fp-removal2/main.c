@@ -0,0 +1,28 @@
+#include <assert.h>
+#include <string.h>
+
+typedef int (*op_t)(int);
+
+int inc(int x)
+{
+  return x + 1;
+}
+
+int dec(int x)
+{
+  return x - 1;
+}
+
+int main(void)
+{
+  op_t a = inc;
+  op_t b = dec;
+
+  // the C library implements memcpy using __CPROVER_array_copy and
+  // __CPROVER_array_replace, which must propagate the pointer to b
+  memcpy(&b, &a, sizeof(op_t));
+
+  assert(b(1) == 2);
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __CPROVER_assume(x >= 0 && x <= 10);
+
+  int y = x + 1;
+  assert(y >= 1);
+  assert(y <= 11);
+  assert(y != 5);
+
+  return 0;
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int x;
+
+void set_x()
+{
+  x = 1;
+}
+
+int main()
+{
+  x = 0;
+__CPROVER_ASYNC_1:
+  set_x();
+
+  assert(x == 0);
+
+  return 0;
+}
@@ -0,0 +1,38 @@
+int nondet_int();
+
+void callee(int x)
+{
+  int callee_kept = x;
+  for(int i = 0; i < x; ++i)
+    callee_kept += i;
+}
+
+void unreachable_callee()
+{
+  int unreachable_callee_kept = 0;
+}
+
+void target()
+{
+  __CPROVER_assert(0, "target");
+}
+
+int main()
+{
+  if(nondet_int())
+  {
+    int unreachable_branch_kept = 0;
+    unreachable_callee();
+    return 0;
+  }
+
+  callee(1);
+  int before_target_kept = 1;
+  target();
+  int after_target_1_kept = 1;
+  callee(2);
+  int after_target_2_kept = 2;
+  callee(3);
+  int after_target_3_kept = 3;
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int main(int argc, char **argv)
+{
+  int array[1000];
+  array[argc] = 1;
+  array[3] = argc;
+  assert(array[3] == argc);
+  assert(array[argc] == 1 || argc == 3);
+  assert(array[argc] == argc || argc != 3);
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int main()
+{
+  int x = 5;
+  int sum = 0;
+
+  for(int i = 0; i < 100000; ++i)
+  {
+    assert(x == 5);
+    if(i > 10)
+      x = 5;
+    sum = i;
+  }
+
+  assert(x == 5);
+  assert(sum >= 0);
+  return 0;
+}
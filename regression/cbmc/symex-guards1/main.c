@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = 0;
+
+  if(x > 0)
+    y = 1;
+  if(x > 10)
+    y = 2;
+  if(x > 20)
+    y = 3;
+
+  assert(y >= 0);
+  assert(y != 2);
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include <assert.h>
+#include <stdlib.h>
+
+struct node
+{
+  int value;
+  struct node *next;
+};
+
+int x;
+int y;
+int *global;
+struct node *list;
+
+void set_global(int *p)
+{
+  global = p;
+}
+
+void push(int value)
+{
+  struct node *n = malloc(sizeof(struct node));
+  n->value = value;
+  n->next = list;
+  list = n;
+}
+
+int main()
+{
+  int *local = &x;
+  set_global(&y);
+  *global = 1;
+  *local = 2;
+
+  push(10);
+  push(20);
+
+  int sum = 0;
+  for(struct node *it = list; it; it = it->next)
+    sum += it->value;
+
+  assert(y == 1);
+  assert(x == 2);
+  assert(sum == 30);
+  assert(list->value == 10);
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int f(int x)
+{
+  return x + 1;
+}
+
+int main()
+{
+  int s = 0;
+
+  for(int i = 0; i < 4; ++i)
+    s = f(s);
+
+  assert(s == 4);
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int a[8];
+  int sum = 0;
+
+  for(int i = 0; i < 8; ++i)
+  {
+    a[i] = nondet_int();
+    __CPROVER_assume(a[i] >= 0 && a[i] < 10);
+    sum += a[i];
+  }
+
+  assert(sum >= 0);
+  assert(sum != 42);
+  return 0;
+}
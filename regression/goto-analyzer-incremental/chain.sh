@@ -0,0 +1,17 @@
+#!/bin/bash
+
+set -e
+
+goto_analyzer=$1
+
+options=${*:2:$#-2}
+name=${*:$#}
+
+# Start from a results file of our own, and analyse twice, such that the
+# second run can reuse the results of the first one
+results_dir="$(TMPDIR=. mktemp -d)"
+trap 'rm -rf "${results_dir}"' EXIT
+results="${results_dir}/incremental.results"
+
+"${goto_analyzer}" "${name}" ${options} --incremental "${results}"
+"${goto_analyzer}" "${name}" ${options} --incremental "${results}"
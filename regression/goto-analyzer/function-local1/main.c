@@ -0,0 +1,26 @@
+#include <assert.h>
+
+int global;
+
+void set_global(void)
+{
+  global = 1;
+  assert(global == 1);
+}
+
+int constant(void)
+{
+  int c = 3;
+  assert(c == 3);
+  return c;
+}
+
+int main()
+{
+  int z = 2;
+  set_global();
+  assert(z == 2);
+  assert(global == 1);
+
+  return constant();
+}
@@ -0,0 +1,23 @@
+int main()
+{
+  int n;
+  int i, j;
+
+  for(i = 0; i < n; ++i)
+  {
+    j = i + 1;
+    __CPROVER_assert(j <= n, "j<=n");
+    __CPROVER_assert(j < n, "j<n"); // fails
+    __CPROVER_assert(i + 1 <= n, "i+1<=n");
+  }
+
+  __CPROVER_assert(i >= n, "i>=n");
+  __CPROVER_assert(i >= 0, "i>=0");
+
+  if(i < n)
+    __CPROVER_assert(0, "0");
+
+  int k = i - 2;
+  if(k > 10)
+    __CPROVER_assert(i > 12, "i>12");
+}
@@ -0,0 +1,27 @@
+#include <assert.h>
+
+int global;
+
+int square(int x)
+{
+  return x * x;
+}
+
+void set_global(int v)
+{
+  global = v;
+}
+
+int main()
+{
+  int r = square(3);
+  assert(r == 9);
+
+  int s = square(3);
+  assert(s == 9);
+
+  set_global(s);
+  assert(global == 9);
+
+  return 0;
+}
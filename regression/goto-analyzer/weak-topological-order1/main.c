@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int main()
+{
+  int i = 0;
+  while(i < 1000)
+    ++i;
+
+  assert(i >= 1000);
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int main()
+{
+  int k = 0;
+  while(k < 10)
+  {
+    int j = 0;
+    while(j < 5)
+    {
+      assert(k < 10);
+      ++j;
+    }
+    ++k;
+  }
+
+  return 0;
+}
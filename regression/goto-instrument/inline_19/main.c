@@ -0,0 +1,34 @@
+#include <assert.h>
+
+int x;
+
+int h(int i)
+{
+  return i + 1;
+}
+
+int big(int i)
+{
+  x += i;
+  x *= 2;
+  x -= i;
+  x += 3;
+  x *= i;
+  x -= 5;
+  x += i;
+  x *= 7;
+  x -= i;
+  x += 11;
+  x *= i;
+  x -= 13;
+  return x;
+}
+
+int main()
+{
+  int n;
+  int y = h(2);
+  big(n);
+  big(n + 1);
+  assert(y == 3);
+}
@@ -0,0 +1,46 @@
+typedef int (*op_t)(int);
+
+int inc(int x)
+{
+  return x + 1;
+}
+
+int dec(int x)
+{
+  return x - 1;
+}
+
+int twice(int x)
+{
+  return 2 * x;
+}
+
+int square(int x)
+{
+  return x * x;
+}
+
+struct handlert
+{
+  op_t op;
+};
+
+int apply(op_t op, int x)
+{
+  return op(x);
+}
+
+int main(void)
+{
+  struct handlert handler;
+  handler.op = twice;
+  int r = handler.op(1);
+
+  r = apply(inc, r);
+  r = apply(dec, r);
+
+  // taking the address of a function does not make it a target of every call
+  op_t unused = square;
+
+  return r;
+}
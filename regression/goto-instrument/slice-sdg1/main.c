@@ -0,0 +1,26 @@
+int g;
+
+void set(int v)
+{
+  g = v;
+}
+
+int main(void)
+{
+  int x = 1;
+  int unrelated = 0;
+  int c;
+
+  if(c)
+    x = 2;
+
+  for(int i = 0; i < 3; ++i)
+    unrelated += i;
+
+  int *p = &unrelated;
+  *p = 42;
+
+  set(x);
+  __CPROVER_assert(g == 1, "g is one");
+  __CPROVER_assert(unrelated == 42, "unrelated is 42");
+}
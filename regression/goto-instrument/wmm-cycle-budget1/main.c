@@ -0,0 +1,60 @@
+int __unbuffered_cnt = 0;
+int __unbuffered_p0_r1 = 0;
+int __unbuffered_p1_r1 = 0;
+int __unbuffered_p2_r1 = 0;
+int __unbuffered_p3_r1 = 0;
+int x = 0;
+int y = 0;
+int a = 0;
+int b = 0;
+
+// P0 and P1 form one store buffering litmus test, and P2 and P3 another one
+// on different variables, such that their events form two independent SCCs
+
+void *P0(void *arg)
+{
+  x = 1;
+  __unbuffered_p0_r1 = y;
+  __unbuffered_cnt++;
+}
+
+void *P1(void *arg)
+{
+  y = 1;
+  __unbuffered_p1_r1 = x;
+  __unbuffered_cnt++;
+}
+
+void *P2(void *arg)
+{
+  a = 1;
+  __unbuffered_p2_r1 = b;
+  __unbuffered_cnt++;
+}
+
+void *P3(void *arg)
+{
+  b = 1;
+  __unbuffered_p3_r1 = a;
+  __unbuffered_cnt++;
+}
+
+int main()
+{
+__CPROVER_ASYNC_0:
+  P0(0);
+__CPROVER_ASYNC_1:
+  P1(0);
+__CPROVER_ASYNC_2:
+  P2(0);
+__CPROVER_ASYNC_3:
+  P3(0);
+  __CPROVER_assume(__unbuffered_cnt == 4);
+  __CPROVER_assert(
+    !(__unbuffered_p0_r1 == 0 && __unbuffered_p1_r1 == 0),
+    "store buffering on x and y is observable on TSO");
+  __CPROVER_assert(
+    !(__unbuffered_p2_r1 == 0 && __unbuffered_p3_r1 == 0),
+    "store buffering on a and b is observable on TSO");
+  return 0;
+}
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+"""Compare the guard representations of symbolic execution on the regression
+tests.
+
+Runs cbmc with --symex-guards expr and --symex-guards bdd on the C sources of
+all CORE tests of a regression directory, stopping after symbolic execution,
+and reports symex runtime and the size of the guards in the resulting
+equation for both. The output is in CSV format.
+"""
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+
+GUARD_KINDS = ["expr", "bdd"]
+
+RUNTIME_RE = re.compile(r"^Runtime Symex: ([0-9.e+-]+)s$", re.MULTILINE)
+GUARDS_RE = re.compile(r"^size of guards: ([0-9]+) ", re.MULTILINE)
+
+
+def read_test(desc_path):
+    """Return the source file and the command line options of a test, or None
+    if the test is not a CORE test of a C program."""
+    with open(desc_path) as desc:
+        lines = desc.read().splitlines()
+    if len(lines) < 3 or not lines[0].startswith("CORE"):
+        return None
+    source = lines[1].strip()
+    if not source.endswith(".c"):
+        return None
+    return source, lines[2].split()
+
+
+def run(cbmc, test_dir, source, options, guard_kind, timeout):
+    """Run symbolic execution for one test and guard kind and return the
+    symex runtime in seconds and the size of the guards, or None if the run
+    did not complete."""
+    command = [cbmc, source] + options + [
+        "--symex-guards", guard_kind, "--program-only", "--verbosity", "8"]
+    try:
+        result = subprocess.run(
+            command, cwd=test_dir, stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT, universal_newlines=True,
+            timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None
+    runtime = RUNTIME_RE.search(result.stdout)
+    guards = GUARDS_RE.search(result.stdout)
+    if runtime is None or guards is None:
+        return None
+    return float(runtime.group(1)), int(guards.group(1))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("cbmc", help="path to the cbmc executable")
+    parser.add_argument(
+        "regression_dir", help="directory of tests, e.g. regression/cbmc")
+    parser.add_argument(
+        "--timeout", type=int, default=60,
+        help="timeout in seconds for each run (default: 60)")
+    args = parser.parse_args()
+
+    writer = csv.writer(sys.stdout)
+    header = ["test"]
+    for kind in GUARD_KINDS:
+        header += [kind + " symex time (s)", kind + " guard size"]
+    writer.writerow(header)
+
+    totals = {kind: [0.0, 0] for kind in GUARD_KINDS}
+    for test in sorted(os.listdir(args.regression_dir)):
+        test_dir = os.path.join(args.regression_dir, test)
+        desc_path = os.path.join(test_dir, "test.desc")
+        if not os.path.isfile(desc_path):
+            continue
+        parsed = read_test(desc_path)
+        if parsed is None:
+            continue
+        source, options = parsed
+
+        results = [
+            run(args.cbmc, test_dir, source, options, kind, args.timeout)
+            for kind in GUARD_KINDS]
+        # only compare tests that complete with both representations
+        if any(result is None for result in results):
+            continue
+
+        row = [test]
+        for kind, (runtime, guards) in zip(GUARD_KINDS, results):
+            row += ["%.3f" % runtime, guards]
+            totals[kind][0] += runtime
+            totals[kind][1] += guards
+        writer.writerow(row)
+
+    row = ["total"]
+    for kind in GUARD_KINDS:
+        row += ["%.3f" % totals[kind][0], totals[kind][1]]
+    writer.writerow(row)
+
+
+if __name__ == "__main__":
+    main()
@@ -11,12 +11,15 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ai.h"
 
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <type_traits>
 
 #include <util/invariant.h>
 
+#include "weak_topological_order.h"
+
 void ai_baset::output(
   const namespacet &ns,
   const goto_functionst &goto_functions,
@@ -99,7 +102,8 @@ jsont ai_baset::output_json(
       {"locationNumber", json_numbert(std::to_string(i_it->location_number))},
       {"sourceLocation", json_stringt(i_it->source_location().as_string())},
       {"abstractState", abstract_state_before(i_it)->output_json(*this, ns)},
-      {"instruction", json_stringt(out.str())}};
+      {"instruction", json_stringt(out.str())},
+      {"visits", json_numbert(std::to_string(visit_count(i_it)))}};
 
     contents.push_back(std::move(location));
   }
@@ -212,20 +216,69 @@ ai_baset::trace_ptrt ai_baset::get_next(working_sett &working_set)
 {
   PRECONDITION(!working_set.empty());
 
-  static_assert(
-    std::is_same<
-      working_sett,
-      std::set<trace_ptrt, ai_history_baset::compare_historyt>>::value,
-    "begin must return the minimal entry");
   auto first = working_set.begin();
-
-  trace_ptrt t = *first;
+  trace_ptrt t = first->second;
 
   working_set.erase(first);
 
   return t;
 }
 
+std::size_t ai_baset::iteration_position(locationt l) const
+{
+  if(iteration_strategy != iteration_strategyt::WEAK_TOPOLOGICAL_ORDER)
+    return 0;
+
+  const auto entry = wto_entries.find(l);
+  return entry == wto_entries.end() ? std::numeric_limits<std::size_t>::max()
+                                    : entry->second.position;
+}
+
+void ai_baset::add_weak_topological_order(const goto_programt &goto_program)
+{
+  if(
+    goto_program.instructions.empty() ||
+    wto_entries.count(goto_program.instructions.begin()) != 0)
+  {
+    return;
+  }
+
+  const weak_topological_ordert wto{goto_program};
+  for(const auto &element : wto.elements())
+  {
+    wto_entries.emplace(
+      element.location,
+      wto_entryt{wto.position(element.location),
+                 wto.is_head(element.location)});
+  }
+}
+
+bool ai_baset::should_widen_at(locationt from, locationt to) const
+{
+  if(iteration_strategy != iteration_strategyt::WEAK_TOPOLOGICAL_ORDER)
+    return false;
+
+  const auto head = wto_entries.find(to);
+  if(head == wto_entries.end() || !head->second.is_head)
+    return false;
+
+  // Edges into and out of a function call are not back edges of the order,
+  // which is computed per function
+  if(
+    from->is_end_function() ||
+    (from->is_function_call() && std::next(from) != to))
+  {
+    return false;
+  }
+
+  // The component of a head follows the head in the order, hence an edge
+  // from within the component leads back to it, while the edges entering
+  // the component come from before the head
+  const auto source = wto_entries.find(from);
+  return source != wto_entries.end() &&
+         source->second.position >= head->second.position;
+}
+
 bool ai_baset::fixedpoint(
   trace_ptrt start_trace,
   const irep_idt &function_id,
@@ -235,6 +288,9 @@ bool ai_baset::fixedpoint(
 {
   PRECONDITION(start_trace != nullptr);
 
+  if(iteration_strategy == iteration_strategyt::WEAK_TOPOLOGICAL_ORDER)
+    add_weak_topological_order(goto_program);
+
   working_sett working_set;
   put_in_working_set(working_set, start_trace);
 
@@ -279,6 +335,8 @@ bool ai_baset::visit(
   log.progress() << "ai_baset::visit " << l->location_number << " in "
                  << function_id << messaget::eom;
 
+  ++visit_counts[l];
+
   // Function call and end are special cases
   if(l->is_function_call())
   {
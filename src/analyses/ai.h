@@ -47,6 +47,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iosfwd>
 #include <memory>
+#include <set>
+#include <unordered_map>
 
 #include <util/deprecate.h>
 #include <util/json.h>
@@ -267,6 +269,32 @@ class ai_baset
   virtual void clear()
   {
     storage->clear();
+    visit_counts.clear();
+    wto_entries.clear();
+  }
+
+  /// How \ref ai_baset::get_next chooses the history to visit next
+  enum class iteration_strategyt
+  {
+    /// The least history in its ordering, which for most histories is the
+    /// one with the least location number
+    LOCATION_ORDER,
+    /// The history whose location comes first in a weak topological order of
+    /// its function, see \ref weak_topological_ordert. Merges into the heads
+    /// of components widen once the head has been visited.
+    WEAK_TOPOLOGICAL_ORDER
+  };
+
+  void set_iteration_strategy(iteration_strategyt strategy)
+  {
+    iteration_strategy = strategy;
+  }
+
+  /// The number of times an abstract transformer was applied from \p l
+  std::size_t visit_count(locationt l) const
+  {
+    const auto it = visit_counts.find(l);
+    return it == visit_counts.end() ? 0 : it->second;
   }
 
   /// Output the abstract states for a single function
@@ -412,17 +440,65 @@ class ai_baset
     const irep_idt &function_id,
     const goto_programt &goto_program) const;
 
-  /// The work queue, sorted using the history's ordering operator
-  typedef trace_sett working_sett;
+  /// An entry of the work queue: the position of the location of the
+  /// history in the iteration order, see \ref iteration_position, and the
+  /// history
+  typedef std::pair<std::size_t, trace_ptrt> working_set_entryt;
+
+  struct compare_working_set_entryt
+  {
+    bool operator()(
+      const working_set_entryt &l,
+      const working_set_entryt &r) const
+    {
+      if(l.first != r.first)
+        return l.first < r.first;
+      return ai_history_baset::compare_historyt()(l.second, r.second);
+    }
+  };
+
+  /// The work queue, sorted by position in the iteration order and then
+  /// using the history's ordering operator
+  typedef std::set<working_set_entryt, compare_working_set_entryt>
+    working_sett;
 
   /// Get the next location from the work queue
   trace_ptrt get_next(working_sett &working_set);
 
   void put_in_working_set(working_sett &working_set, trace_ptrt t)
   {
-    working_set.insert(t);
+    working_set.emplace(iteration_position(t->current_location()), t);
   }
 
+  /// The position of \p l in the order in which the iteration strategy
+  /// visits locations. This is 0 for all locations with LOCATION_ORDER.
+  /// Locations without a weak topological order come last.
+  std::size_t iteration_position(locationt l) const;
+
+  iteration_strategyt iteration_strategy = iteration_strategyt::LOCATION_ORDER;
+
+  /// Visits by location, see \ref visit_count
+  std::unordered_map<locationt, std::size_t, const_target_hash> visit_counts;
+
+  struct wto_entryt
+  {
+    std::size_t position;
+    bool is_head;
+  };
+
+  /// The weak topological order of the functions analysed so far, if the
+  /// iteration strategy uses it
+  std::unordered_map<locationt, wto_entryt, const_target_hash> wto_entries;
+
+  /// Compute the weak topological order of \p goto_program, unless it is
+  /// known already.
+  void add_weak_topological_order(const goto_programt &goto_program);
+
+  /// Whether merging the state flowing from \p from into the state at \p to
+  /// should widen, that is, whether this is a back edge to the head of a
+  /// component of the weak topological order
+  bool should_widen_at(locationt from, locationt to) const;
+
   /// Run the fixedpoint algorithm until it reaches a fixed point
   /// \return True if we found something new
   virtual bool fixedpoint(
@@ -500,6 +576,8 @@ class ai_baset
   virtual bool merge(const statet &src, trace_ptrt from, trace_ptrt to)
   {
     statet &dest = get_state(to);
+    if(should_widen_at(from->current_location(), to->current_location()))
+      return domain_factory->widen(dest, src, from, to);
     return domain_factory->merge(dest, src, from, to);
   }
 
@@ -182,6 +182,14 @@ class ai_domain_factory_baset
   virtual bool
   merge(statet &dest, const statet &src, trace_ptrt from, trace_ptrt to)
     const = 0;
+
+  /// Merge \p src into \p dest, widening if the domain supports it. By
+  /// default this is the same as \ref merge.
+  virtual bool
+  widen(statet &dest, const statet &src, trace_ptrt from, trace_ptrt to) const
+  {
+    return merge(dest, src, from, to);
+  }
 };
 // Converting make to take a trace_ptr instead of a location would
 // require removing the backwards-compatible
@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An abstract interpreter that analyses each function on its own
+
+#include "ai_function_local.h"
+
+void ai_function_localt::operator()(
+  const std::vector<irep_idt> &function_ids,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  initialize(goto_functions);
+
+  for(const irep_idt &function_id : function_ids)
+  {
+    const auto f_it = goto_functions.function_map.find(function_id);
+    PRECONDITION(f_it != goto_functions.function_map.end());
+
+    if(!f_it->second.body_available())
+      continue;
+
+    trace_ptrt p = entry_state(f_it->second.body);
+    fixedpoint(p, function_id, f_it->second.body, goto_functions, ns);
+  }
+
+  finalize();
+}
+
+void ai_function_localt::fixedpoint(
+  trace_ptrt start_trace,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(!gf_entry.second.body_available())
+      continue;
+
+    trace_ptrt p = gf_entry.first == goto_functions.entry_point()
+                     ? start_trace
+                     : entry_state(gf_entry.second.body);
+    fixedpoint(p, gf_entry.first, gf_entry.second.body, goto_functions, ns);
+  }
+}
@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An abstract interpreter that analyses each function on its own
+
+#ifndef CPROVER_ANALYSES_AI_FUNCTION_LOCAL_H
+#define CPROVER_ANALYSES_AI_FUNCTION_LOCAL_H
+
+#include <vector>
+
+#include "ai.h"
+
+/// Abstract interpreter that analyses every function with a body, starting
+/// from the entry state at its first instruction. Function calls are
+/// approximated by the call-to-return edge, as \ref ai_baset does for
+/// functions without a body, so no abstract state flows between functions.
+///
+/// As a consequence the functions are independent of each other: they can be
+/// analysed in any order, or only some of them, or in separate processes, and
+/// the states of a function are the same in all cases.
+class ai_function_localt : public ai_baset
+{
+public:
+  ai_function_localt(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st,
+    message_handlert &mh)
+    : ai_baset(std::move(hf), std::move(df), std::move(st), mh)
+  {
+  }
+
+  using ai_baset::operator();
+
+  /// Run abstract interpretation on the functions \p function_ids of
+  /// \p goto_functions only. The states of all other functions remain bottom.
+  void operator()(
+    const std::vector<irep_idt> &function_ids,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+protected:
+  /// Analyse all functions with a body, using \p start_trace for the entry
+  /// point.
+  void fixedpoint(
+    trace_ptrt start_trace,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  using ai_baset::fixedpoint;
+};
+
+#endif // CPROVER_ANALYSES_AI_FUNCTION_LOCAL_H
@@ -0,0 +1,257 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An abstract interpreter that reuses the effect of a function call at all
+/// call sites with the same (or a smaller) abstract state on entry, instead of
+/// analysing the callee again for each of them.
+
+#include "ai_summary_interprocedural.h"
+
+#include "call_graph.h"
+
+void ai_summary_interproceduralt::clear()
+{
+  ai_recursive_interproceduralt::clear();
+  summaries.clear();
+  summary_statistics.clear();
+}
+
+void ai_summary_interproceduralt::initialize(
+  const goto_functionst &goto_functions)
+{
+  ai_recursive_interproceduralt::initialize(goto_functions);
+
+  const call_grapht call_graph(goto_functions);
+  const call_grapht::directed_grapht directed_graph =
+    call_graph.get_directed_graph();
+
+  std::vector<call_grapht::directed_grapht::node_indext> scc_of_node;
+  const std::size_t number_of_sccs = directed_graph.SCCs(scc_of_node);
+  std::vector<std::size_t> scc_size(number_of_sccs, 0);
+  for(const auto scc : scc_of_node)
+    ++scc_size[scc];
+
+  recursive_functions.clear();
+  for(call_grapht::directed_grapht::node_indext node = 0;
+      node < directed_graph.size();
+      ++node)
+  {
+    if(scc_size[scc_of_node[node]] > 1 || directed_graph.has_edge(node, node))
+      recursive_functions.insert(directed_graph[node].function);
+  }
+}
+
+void ai_summary_interproceduralt::finalize()
+{
+  ai_recursive_interproceduralt::finalize();
+
+  messaget log(message_handler);
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  for(const auto &entry : summary_statistics)
+  {
+    hits += entry.second.hits;
+    misses += entry.second.misses;
+
+    log.debug() << "Summaries of " << entry.first << ": " << entry.second.hits
+                << " hits, " << entry.second.misses << " misses"
+                << messaget::eom;
+  }
+
+  log.statistics() << "Function summaries: " << hits << " hits, " << misses
+                   << " misses";
+  if(hits + misses != 0)
+    log.statistics() << " (" << (100 * hits) / (hits + misses) << "% hit rate)";
+  log.statistics() << messaget::eom;
+}
+
+bool ai_summary_interproceduralt::is_subsumed(
+  const statet &state,
+  const statet &summary_state,
+  trace_ptrt from,
+  trace_ptrt to) const
+{
+  std::unique_ptr<statet> merged = domain_factory->copy(summary_state);
+  return !domain_factory->merge(*merged, state, from, to);
+}
+
+bool ai_summary_interproceduralt::visit_edge_function_call(
+  const irep_idt &calling_function_id,
+  trace_ptrt p_call,
+  locationt l_return,
+  const irep_idt &callee_function_id,
+  working_sett &working_set,
+  const goto_programt &callee,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(recursive_functions.count(callee_function_id) != 0)
+  {
+    return ai_recursive_interproceduralt::visit_edge_function_call(
+      calling_function_id,
+      p_call,
+      l_return,
+      callee_function_id,
+      working_set,
+      callee,
+      goto_functions,
+      ns);
+  }
+
+  messaget log(message_handler);
+  log.progress() << "ai_summary_interproceduralt::visit_edge_function_call"
+                 << " from " << p_call->current_location()->location_number
+                 << " to " << l_return->location_number << messaget::eom;
+
+  // Compute the state at the start of the callee for this call
+  locationt l_begin = callee.instructions.begin();
+  auto next = p_call->step(
+    l_begin,
+    *(storage->abstract_traces_before(l_begin)),
+    ai_history_baset::no_caller_history);
+  if(next.first == ai_history_baset::step_statust::BLOCKED)
+  {
+    log.progress() << "blocked by history" << messaget::eom;
+    return false;
+  }
+  trace_ptrt p_begin = next.second;
+
+  std::unique_ptr<statet> entry = make_temporary_state(get_state(p_call));
+  entry->transform(
+    calling_function_id, p_call, callee_function_id, p_begin, *this, ns);
+
+  if(entry->is_bottom())
+    return false;
+
+  summary_statisticst &statistics = summary_statistics[callee_function_id];
+
+  for(const summaryt &summary : summaries[callee_function_id])
+  {
+    if(is_subsumed(*entry, *summary.entry, p_call, p_begin))
+    {
+      log.progress() << "Using summary of " << callee_function_id
+                     << messaget::eom;
+      ++statistics.hits;
+      return apply_summary(
+        summary,
+        calling_function_id,
+        p_call,
+        l_return,
+        callee_function_id,
+        working_set,
+        ns);
+    }
+  }
+
+  ++statistics.misses;
+
+  bool new_data = ai_recursive_interproceduralt::visit_edge_function_call(
+    calling_function_id,
+    p_call,
+    l_return,
+    callee_function_id,
+    working_set,
+    callee,
+    goto_functions,
+    ns);
+
+  add_summary(callee_function_id, std::move(entry), p_call, l_return, callee);
+
+  return new_data;
+}
+
+void ai_summary_interproceduralt::add_summary(
+  const irep_idt &callee_function_id,
+  std::unique_ptr<statet> entry,
+  trace_ptrt p_call,
+  locationt l_return,
+  const goto_programt &callee)
+{
+  std::vector<summaryt> &function_summaries = summaries[callee_function_id];
+  if(function_summaries.size() >= max_summaries_per_function)
+    return;
+
+  locationt l_end = std::prev(callee.instructions.end());
+  DATA_INVARIANT(
+    l_end->is_end_function(),
+    "The last instruction of a goto_program must be END_FUNCTION");
+
+  // The callee has been analysed with a state at its start that includes
+  // entry, hence the states at its end that can return to p_call
+  // over-approximate the effect of the call for any state subsumed by entry.
+  summaryt summary;
+  summary.entry = std::move(entry);
+
+  for(const auto &p_end : *(storage->abstract_traces_before(l_end)))
+  {
+    const statet &end_state = get_state(p_end);
+    if(end_state.is_bottom())
+      continue;
+
+    auto return_step = p_end->step(
+      l_return, *(storage->abstract_traces_before(l_return)), p_call);
+    if(return_step.first == ai_history_baset::step_statust::BLOCKED)
+      continue;
+
+    if(summary.exit == nullptr)
+    {
+      summary.exit = make_temporary_state(end_state);
+      summary.end_trace = p_end;
+    }
+    else
+      domain_factory->merge(*summary.exit, end_state, p_end, summary.end_trace);
+  }
+
+  function_summaries.push_back(std::move(summary));
+}
+
+bool ai_summary_interproceduralt::apply_summary(
+  const summaryt &summary,
+  const irep_idt &calling_function_id,
+  trace_ptrt p_call,
+  locationt l_return,
+  const irep_idt &callee_function_id,
+  working_sett &working_set,
+  const namespacet &ns)
+{
+  // the callee does not return
+  if(summary.exit == nullptr)
+    return false;
+
+  // The callee is not analysed for this call, so step over the call as for a
+  // function without body
+  auto next = p_call->step(
+    l_return,
+    *(storage->abstract_traces_before(l_return)),
+    ai_history_baset::no_caller_history);
+  if(next.first == ai_history_baset::step_statust::BLOCKED)
+    return false;
+  trace_ptrt p_return = next.second;
+
+  std::unique_ptr<statet> tmp_state = make_temporary_state(*summary.exit);
+  tmp_state->transform(
+    callee_function_id,
+    summary.end_trace,
+    calling_function_id,
+    p_return,
+    *this,
+    ns);
+
+  if(
+    merge(*tmp_state, p_call, p_return) ||
+    (next.first == ai_history_baset::step_statust::NEW &&
+     !tmp_state->is_bottom()))
+  {
+    put_in_working_set(working_set, p_return);
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,146 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An abstract interpreter that reuses the effect of a function call at all
+/// call sites with the same (or a smaller) abstract state on entry, instead of
+/// analysing the callee again for each of them.
+
+#ifndef CPROVER_ANALYSES_AI_SUMMARY_INTERPROCEDURAL_H
+#define CPROVER_ANALYSES_AI_SUMMARY_INTERPROCEDURAL_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ai.h"
+
+/// Interprocedural abstract interpreter using function summaries. A summary
+/// of a function maps an abstract state on entry to the function to the
+/// abstract state on exit. When a call is reached with an entry state that is
+/// subsumed by the entry state of an existing summary of the callee, the exit
+/// state of that summary is used at the return site and the callee is not
+/// analysed again. Otherwise the call is handled as by
+/// \ref ai_recursive_interproceduralt and a new summary is recorded.
+///
+/// Summaries of functions that are part of a recursive strongly connected
+/// component of the call graph are not sound while the component is being
+/// analysed, hence calls to them are always handled recursively.
+///
+/// As with \ref ai_recursive_interproceduralt, the states at the locations of
+/// the callee over-approximate all calls of it, including those for which a
+/// summary was used.
+class ai_summary_interproceduralt : public ai_recursive_interproceduralt
+{
+public:
+  /// \param hf: history factory, see \ref ai_baset
+  /// \param df: domain factory, see \ref ai_baset
+  /// \param st: storage, see \ref ai_baset
+  /// \param mh: message handler, which receives the summary statistics
+  /// \param max_summaries_per_function: number of summaries to keep per
+  ///   function, each of which costs a comparison of entry states per call
+  ai_summary_interproceduralt(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st,
+    message_handlert &mh,
+    std::size_t max_summaries_per_function = 8)
+    : ai_recursive_interproceduralt(
+        std::move(hf),
+        std::move(df),
+        std::move(st),
+        mh),
+      max_summaries_per_function(max_summaries_per_function)
+  {
+  }
+
+  void clear() override;
+
+  /// How often the summaries of a function were used
+  struct summary_statisticst
+  {
+    /// Calls that used an existing summary
+    std::size_t hits = 0;
+    /// Calls that required the callee to be analysed
+    std::size_t misses = 0;
+  };
+
+  const std::unordered_map<irep_idt, summary_statisticst> &
+  get_summary_statistics() const
+  {
+    return summary_statistics;
+  }
+
+protected:
+  using ai_recursive_interproceduralt::initialize;
+
+  /// Determine the functions that are part of recursive strongly connected
+  /// components of the call graph of \p goto_functions.
+  void initialize(const goto_functionst &goto_functions) override;
+
+  /// Report the summary statistics.
+  void finalize() override;
+
+  bool visit_edge_function_call(
+    const irep_idt &calling_function_id,
+    trace_ptrt p_call,
+    locationt l_return,
+    const irep_idt &callee_function_id,
+    working_sett &working_set,
+    const goto_programt &callee,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  struct summaryt
+  {
+    /// State at the start of the callee
+    std::unique_ptr<statet> entry;
+    /// Merged states at the end of the callee, or nullptr if the end of the
+    /// callee is unreachable
+    std::unique_ptr<statet> exit;
+    /// One of the histories at the end of the callee, which the transformer
+    /// of the return edge is applied from
+    trace_ptrt end_trace;
+  };
+
+  const std::size_t max_summaries_per_function;
+
+  std::unordered_map<irep_idt, std::vector<summaryt>> summaries;
+  std::unordered_set<irep_idt> recursive_functions;
+  std::unordered_map<irep_idt, summary_statisticst> summary_statistics;
+
+  /// Whether \p state is subsumed by \p summary_state, that is, merging it
+  /// into \p summary_state does not change the latter.
+  bool is_subsumed(
+    const statet &state,
+    const statet &summary_state,
+    trace_ptrt from,
+    trace_ptrt to) const;
+
+  /// Record the summary of the call from \p p_call, once the callee has been
+  /// analysed with entry state \p entry.
+  void add_summary(
+    const irep_idt &callee_function_id,
+    std::unique_ptr<statet> entry,
+    trace_ptrt p_call,
+    locationt l_return,
+    const goto_programt &callee);
+
+  /// Apply \p summary to the edge from \p p_call to \p l_return.
+  /// \return True if the state at the return site changed
+  bool apply_summary(
+    const summaryt &summary,
+    const irep_idt &calling_function_id,
+    trace_ptrt p_call,
+    locationt l_return,
+    const irep_idt &callee_function_id,
+    working_sett &working_set,
+    const namespacet &ns);
+};
+
+#endif // CPROVER_ANALYSES_AI_SUMMARY_INTERPROCEDURAL_H
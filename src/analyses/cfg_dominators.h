@@ -12,25 +12,31 @@ Author: Georg Weissenbacher, georg@weissenbacher.name
 #ifndef CPROVER_ANALYSES_CFG_DOMINATORS_H
 #define CPROVER_ANALYSES_CFG_DOMINATORS_H
 
-#include <set>
+#include <iosfwd>
+#include <limits>
 #include <list>
 #include <map>
-#include <iosfwd>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <util/optional.h>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/goto_program.h>
 #include <goto-programs/cfg.h>
 
 /// Dominator graph. This computes a control-flow graph (see \ref cfgt) and
-/// decorates it with dominator sets per program point, following
-/// "A Simple, Fast Dominance Algorithm" by Cooper et al.
+/// decorates it with the dominator tree, following "A Simple, Fast Dominance
+/// Algorithm" by Cooper, Harvey and Kennedy.
 /// Templated over the program type (P) and program point type (T), which need
 /// to be supported by \ref cfgt. Can compute either dominators or
 /// postdominators depending on template parameter `post_dom`.
 /// Use \ref cfg_dominators_templatet::dominates to directly query dominance,
-/// or \ref cfg_dominators_templatet::get_node to get the \ref cfgt graph node
+/// which takes constant time once the graph nodes are known, or
+/// \ref cfg_dominators_templatet::get_node to get the \ref cfgt graph node
 /// corresponding to a program point, including the in- and out-edges provided
-/// by \ref cfgt as well as the dominator set computed by this class.
+/// by \ref cfgt as well as the immediate dominator computed by this class.
 /// See also https://en.wikipedia.org/wiki/Dominator_(graph_theory)
 template <class P, class T, bool post_dom>
 class cfg_dominators_templatet
@@ -40,7 +46,16 @@ class cfg_dominators_templatet
 
   struct nodet
   {
-    target_sett dominators;
+    /// Index in \ref cfg of the immediate dominator. The entry node, the exit
+    /// nodes when computing postdominators, and unreachable nodes have none.
+    optionalt<std::size_t> immediate_dominator;
+    /// The number of program points that dominate this one, including itself,
+    /// which is zero for unreachable program points
+    std::size_t number_of_dominators = 0;
+    /// Pre-order number of the node in the dominator tree, and one past the
+    /// largest pre-order number of the nodes that it dominates
+    std::size_t dfs_begin = 0;
+    std::size_t dfs_end = 0;
   };
 
   typedef procedure_local_cfg_baset<nodet, P, T> cfgt;
@@ -48,15 +63,15 @@ class cfg_dominators_templatet
 
   void operator()(P &program);
 
-  /// Get the graph node (which gives dominators, predecessors and successors)
-  /// for \p program_point
+  /// Get the graph node (which gives the immediate dominator, predecessors and
+  /// successors) for \p program_point
   const typename cfgt::nodet &get_node(const T &program_point) const
   {
     return cfg.get_node(program_point);
   }
 
-  /// Get the graph node (which gives dominators, predecessors and successors)
-  /// for \p program_point
+  /// Get the graph node (which gives the immediate dominator, predecessors and
+  /// successors) for \p program_point
   typename cfgt::nodet &get_node(const T &program_point)
   {
     return cfg.get_node(program_point);
@@ -68,6 +83,17 @@ class cfg_dominators_templatet
     return cfg.get_node_index(program_point);
   }
 
+  /// Returns true if the program point corresponding to \p rhs_node is
+  /// dominated by the program point corresponding to \p lhs_node.
+  /// Note by definition all program points dominate themselves.
+  bool dominates(const nodet &lhs_node, const nodet &rhs_node) const
+  {
+    return program_point_reachable(lhs_node) &&
+           program_point_reachable(rhs_node) &&
+           lhs_node.dfs_begin <= rhs_node.dfs_begin &&
+           rhs_node.dfs_begin < lhs_node.dfs_end;
+  }
+
   /// Returns true if the program point corresponding to \p rhs_node is
   /// dominated by program point \p lhs. Saves node lookup compared to the
   /// dominates overload that takes two program points, so this version is
@@ -75,7 +101,7 @@ class cfg_dominators_templatet
   /// Note by definition all program points dominate themselves.
   bool dominates(T lhs, const nodet &rhs_node) const
   {
-    return rhs_node.dominators.count(lhs);
+    return dominates(get_node(lhs), rhs_node);
   }
 
   /// Returns true if program point \p lhs dominates \p rhs.
@@ -93,7 +119,7 @@ class cfg_dominators_templatet
     // Dominator analysis walks from the entry point, so a side-effect is to
     // identify unreachable program points (those which don't dominate even
     // themselves).
-    return !program_point_node.dominators.empty();
+    return program_point_node.number_of_dominators != 0;
   }
 
   /// Returns true if the program point for \p program_point_node is reachable
@@ -107,6 +133,26 @@ class cfg_dominators_templatet
     return program_point_reachable(get_node(program_point));
   }
 
+  /// Returns all program points that dominate the program point of \p node,
+  /// including itself. This takes time linear in the number of dominators,
+  /// prefer \ref dominates or walking the immediate dominators where possible.
+  target_sett get_dominators(const typename cfgt::nodet &node) const
+  {
+    target_sett dominators;
+    if(!program_point_reachable(node))
+      return dominators;
+
+    for(const typename cfgt::nodet *n = &node;;
+        n = &cfg[*n->immediate_dominator])
+    {
+      dominators.insert(n->PC);
+      if(!n->immediate_dominator.has_value())
+        break;
+    }
+
+    return dominators;
+  }
+
   T entry_node;
 
   void output(std::ostream &) const;
@@ -141,12 +187,12 @@ void cfg_dominators_templatet<P, T, post_dom>::initialise(P &program)
   cfg(program);
 }
 
-/// Computes the MOP for the dominator analysis
+/// Computes the dominator tree. The nodes that control flows from (or to,
+/// when computing postdominators) are the children of an artificial root,
+/// whose index is the number of nodes of \ref cfg.
 template <class P, class T, bool post_dom>
 void cfg_dominators_templatet<P, T, post_dom>::fixedpoint(P &program)
 {
-  std::list<T> worklist;
-
   if(cfgt::nodes_empty(program))
     return;
 
@@ -154,102 +200,161 @@ void cfg_dominators_templatet<P, T, post_dom>::fixedpoint(P &program)
     entry_node = cfgt::get_last_node(program);
   else
     entry_node = cfgt::get_first_node(program);
-  typename cfgt::nodet &n = cfg.get_node(entry_node);
-  n.dominators.insert(entry_node);
 
-  for(typename cfgt::edgest::const_iterator
-      s_it=(post_dom?n.in:n.out).begin();
-      s_it!=(post_dom?n.in:n.out).end();
-      ++s_it)
-    worklist.push_back(cfg[s_it->first].PC);
+  const std::size_t root = cfg.size();
+  const std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  std::vector<std::size_t> roots{cfg.get_node_index(entry_node)};
 
   // A program may have multiple "exit" nodes when self loops or assume(false)
   // instructions are present.
   if(post_dom)
   {
-    for(auto &cfg_entry : cfg.entry_map)
+    for(std::size_t i = 0; i < cfg.size(); ++i)
     {
-      if(cfg[cfg_entry.second].PC == entry_node)
-        continue;
-
-      typename cfgt::nodet &n_it = cfg[cfg_entry.second];
+      const typename cfgt::nodet &node = cfg[i];
       if(
-        n_it.out.empty() ||
-        (n_it.out.size() == 1 && n_it.out.begin()->first == cfg_entry.second))
+        i != roots.front() &&
+        (node.out.empty() ||
+         (node.out.size() == 1 && node.out.begin()->first == i)))
       {
-        n_it.dominators.insert(cfg[cfg_entry.second].PC);
-        for(const auto &predecessor : n_it.in)
-          worklist.push_back(cfg[predecessor.first].PC);
+        roots.push_back(i);
       }
     }
   }
 
-  while(!worklist.empty())
+  std::vector<bool> is_root(cfg.size(), false);
+  for(const std::size_t r : roots)
+    is_root[r] = true;
+
+  const auto successors = [this](std::size_t i) -> const
+    typename cfgt::edgest & { return post_dom ? cfg[i].in : cfg[i].out; };
+  const auto predecessors = [this](std::size_t i) -> const
+    typename cfgt::edgest & { return post_dom ? cfg[i].out : cfg[i].in; };
+
+  // Number the nodes reachable from the root in depth-first post-order
+  std::vector<std::size_t> postorder;
+  std::vector<std::size_t> postorder_number(cfg.size() + 1, none);
+  std::vector<bool> visited(cfg.size(), false);
+  std::vector<
+    std::pair<std::size_t, typename cfgt::edgest::const_iterator>>
+    stack;
+
+  for(const std::size_t r : roots)
   {
-    // get node from worklist
-    T current=worklist.front();
-    worklist.pop_front();
+    if(visited[r])
+      continue;
+
+    visited[r] = true;
+    stack.emplace_back(r, successors(r).begin());
 
-    bool changed=false;
-    typename cfgt::nodet &node = cfg.get_node(current);
-    if(node.dominators.empty())
+    while(!stack.empty())
     {
-      for(const auto &edge : (post_dom ? node.out : node.in))
-        if(!cfg[edge.first].dominators.empty())
+      const std::size_t current = stack.back().first;
+      auto &next_edge = stack.back().second;
+
+      if(next_edge != successors(current).end())
+      {
+        const std::size_t successor = next_edge->first;
+        ++next_edge;
+        if(!visited[successor])
         {
-          node.dominators=cfg[edge.first].dominators;
-          node.dominators.insert(current);
-          changed=true;
+          visited[successor] = true;
+          stack.emplace_back(successor, successors(successor).begin());
         }
+      }
+      else
+      {
+        postorder_number[current] = postorder.size();
+        postorder.push_back(current);
+        stack.pop_back();
+      }
     }
+  }
+
+  postorder_number[root] = postorder.size();
 
-    // compute intersection of predecessors
-    for(const auto &edge : (post_dom ? node.out : node.in))
+  // Compute the immediate dominators, iterating in reverse post-order
+  std::vector<std::size_t> idom(cfg.size() + 1, none);
+  idom[root] = root;
+
+  const auto intersect = [&](std::size_t a, std::size_t b) {
+    while(a != b)
     {
-      const target_sett &other=cfg[edge.first].dominators;
-      if(other.empty())
-        continue;
+      while(postorder_number[a] < postorder_number[b])
+        a = idom[a];
+      while(postorder_number[b] < postorder_number[a])
+        b = idom[b];
+    }
+    return a;
+  };
 
-      typename target_sett::const_iterator n_it=node.dominators.begin();
-      typename target_sett::const_iterator o_it=other.begin();
+  for(bool changed = true; changed;)
+  {
+    changed = false;
 
-      // in-place intersection. not safe to use set_intersect
-      while(n_it!=node.dominators.end() && o_it!=other.end())
+    for(auto it = postorder.rbegin(); it != postorder.rend(); ++it)
+    {
+      const std::size_t current = *it;
+      std::size_t new_idom = is_root[current] ? root : none;
+
+      for(const auto &edge : predecessors(current))
       {
-        if(*n_it==current)
-          ++n_it;
-        else if(*n_it<*o_it)
-        {
-          changed=true;
-          node.dominators.erase(n_it++);
-        }
-        else if(*o_it<*n_it)
-          ++o_it;
-        else
-        {
-          ++n_it;
-          ++o_it;
-        }
+        if(idom[edge.first] == none)
+          continue;
+
+        new_idom =
+          new_idom == none ? edge.first : intersect(edge.first, new_idom);
       }
 
-      while(n_it!=node.dominators.end())
+      if(idom[current] != new_idom)
       {
-        if(*n_it==current)
-          ++n_it;
-        else
-        {
-          changed=true;
-          node.dominators.erase(n_it++);
-        }
+        idom[current] = new_idom;
+        changed = true;
       }
     }
+  }
+
+  // Number the dominator tree in depth-first pre-order, such that a node
+  // dominates exactly the nodes numbered within its interval
+  std::vector<std::vector<std::size_t>> children(cfg.size() + 1);
+  for(const std::size_t i : postorder)
+    children[idom[i]].push_back(i);
+
+  std::size_t number = 0;
+  std::vector<std::pair<std::size_t, std::size_t>> tree_stack{{root, 0}};
+
+  while(!tree_stack.empty())
+  {
+    const std::size_t current = tree_stack.back().first;
+    std::size_t &next_child = tree_stack.back().second;
 
-    if(changed) // fixed point for node reached?
+    if(next_child < children[current].size())
     {
-      for(const auto &edge : (post_dom ? node.in : node.out))
+      const std::size_t child = children[current][next_child];
+      ++next_child;
+
+      nodet &child_node = cfg[child];
+      child_node.dfs_begin = ++number;
+      if(current == root)
+      {
+        child_node.immediate_dominator.reset();
+        child_node.number_of_dominators = 1;
+      }
+      else
       {
-        worklist.push_back(cfg[edge.first].PC);
+        child_node.immediate_dominator = current;
+        child_node.number_of_dominators =
+          cfg[current].number_of_dominators + 1;
       }
+
+      tree_stack.emplace_back(child, 0);
+    }
+    else
+    {
+      if(current != root)
+        cfg[current].dfs_end = number + 1;
+      tree_stack.pop_back();
     }
   }
 }
@@ -285,7 +390,7 @@ void cfg_dominators_templatet<P, T, post_dom>::output(std::ostream &out) const
     else
       out << " dominated by ";
     bool first=true;
-    for(const auto &d : cfg[node.second].dominators)
+    for(const auto &d : get_dominators(cfg[node.second]))
     {
       if(!first)
         out << ", ";
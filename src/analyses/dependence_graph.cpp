@@ -83,6 +83,7 @@ void dep_graph_domaint::control_dependencies(
 
   const irep_idt id = function_id;
   const cfg_post_dominatorst &pd=dep_graph.cfg_post_dominators().at(id);
+  const cfg_post_dominatorst::cfgt::nodet &to_node = pd.get_node(to);
 
   // Check all candidates
 
@@ -101,13 +102,10 @@ void dep_graph_domaint::control_dependencies(
     // successors of M
     for(const auto &edge : m.out)
     {
-      // Could use pd.dominates(to, control_dep_candidate) but this would impose
-      // another dominator node lookup per call to this function, which is too
-      // expensive.
       const cfg_post_dominatorst::cfgt::nodet &m_s=
         pd.cfg[edge.first];
 
-      if(m_s.dominators.find(to)!=m_s.dominators.end())
+      if(pd.dominates(to_node, m_s))
         post_dom_one=true;
       else
         post_dom_all=false;
@@ -0,0 +1,154 @@
+/*******************************************************************\
+
+Module: Guard Data Structure
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Guard Data Structure
+
+#include "guard.h"
+
+#include <util/invariant.h>
+#include <util/options.h>
+
+/// Number of distinct guards whose conversion to expressions is cached. Symex
+/// converts the current guard at every assignment and assertion, but moves on
+/// to new guards at each branch and merge, hence only recent ones are useful.
+#define GUARD_BDD_AS_EXPR_CACHE_LIMIT 1024
+
+guard_managert::guard_managert(guard_kindt kind) : guard_kind(kind)
+{
+  configure();
+}
+
+guard_managert::guard_managert(const optionst &options)
+  : guard_kind(default_kind())
+{
+  if(options.is_set("symex-guards"))
+  {
+    const auto kind = parse_kind(options.get_option("symex-guards"));
+    PRECONDITION(kind.has_value());
+    guard_kind = *kind;
+  }
+
+  configure();
+}
+
+optionalt<guard_kindt> guard_managert::parse_kind(const std::string &value)
+{
+  if(value == "bdd")
+    return guard_kindt::BDD;
+  else if(value == "expr")
+    return guard_kindt::EXPR;
+  else
+    return {};
+}
+
+void guard_managert::configure()
+{
+  if(guard_kind == guard_kindt::BDD)
+  {
+    bdd_manager.set_as_expr_cache_limit(GUARD_BDD_AS_EXPR_CACHE_LIMIT);
+    bdd_manager.enable_variable_reordering();
+  }
+}
+
+guardt::guardt(const exprt &e, guard_managert &manager)
+{
+  if(manager.kind() == guard_kindt::BDD)
+    bdd_guard.emplace(e, manager.bdd_manager);
+  else
+    expr_guard.emplace(e, manager.expr_manager);
+}
+
+void guardt::add(const exprt &expr)
+{
+  if(bdd_guard)
+    bdd_guard->add(expr);
+  else
+    expr_guard->add(expr);
+}
+
+void guardt::append(const guardt &guard)
+{
+  if(bdd_guard)
+  {
+    PRECONDITION(guard.bdd_guard.has_value());
+    bdd_guard->append(*guard.bdd_guard);
+  }
+  else
+  {
+    PRECONDITION(guard.expr_guard.has_value());
+    expr_guard->append(*guard.expr_guard);
+  }
+}
+
+exprt guardt::as_expr() const
+{
+  return bdd_guard ? bdd_guard->as_expr() : expr_guard->as_expr();
+}
+
+exprt guardt::guard_expr(exprt expr) const
+{
+  return bdd_guard ? bdd_guard->guard_expr(std::move(expr))
+                   : expr_guard->guard_expr(std::move(expr));
+}
+
+bool guardt::is_true() const
+{
+  return bdd_guard ? bdd_guard->is_true() : expr_guard->is_true();
+}
+
+bool guardt::is_false() const
+{
+  return bdd_guard ? bdd_guard->is_false() : expr_guard->is_false();
+}
+
+guardt &operator-=(guardt &g1, const guardt &g2)
+{
+  if(g1.bdd_guard)
+  {
+    PRECONDITION(g2.bdd_guard.has_value());
+    *g1.bdd_guard -= *g2.bdd_guard;
+  }
+  else
+  {
+    PRECONDITION(g2.expr_guard.has_value());
+    *g1.expr_guard -= *g2.expr_guard;
+  }
+
+  return g1;
+}
+
+guardt &operator|=(guardt &g1, const guardt &g2)
+{
+  if(g1.bdd_guard)
+  {
+    PRECONDITION(g2.bdd_guard.has_value());
+    *g1.bdd_guard |= *g2.bdd_guard;
+  }
+  else
+  {
+    PRECONDITION(g2.expr_guard.has_value());
+    *g1.expr_guard |= *g2.expr_guard;
+  }
+
+  return g1;
+}
+
+bool guardt::disjunction_may_simplify(const guardt &other_guard)
+{
+  if(bdd_guard)
+  {
+    PRECONDITION(other_guard.bdd_guard.has_value());
+    return bdd_guard->disjunction_may_simplify(*other_guard.bdd_guard);
+  }
+  else
+  {
+    PRECONDITION(other_guard.expr_guard.has_value());
+    return expr_guard->disjunction_may_simplify(*other_guard.expr_guard);
+  }
+}
@@ -12,20 +12,111 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_GUARD_H
 #define CPROVER_ANALYSES_GUARD_H
 
-#ifdef BDD_GUARDS
+#include <util/optional.h>
+
+#include <solvers/prop/bdd_expr.h>
 
 #include "guard_bdd.h"
+#include "guard_expr.h"
+
+class optionst;
+
+/// Representations of guards that \ref guardt can use
+enum class guard_kindt
+{
+  /// Conjunctions of expressions, see \ref guard_exprt
+  EXPR,
+  /// Binary decision diagrams, see \ref guard_bddt
+  BDD
+};
+
+/// Owns the data shared by all guards created with it, and determines which
+/// representation these guards use.
+class guard_managert
+{
+public:
+  /// Construct a manager for guards of kind \p kind, which defaults to
+  /// \ref guard_kindt::BDD when compiled with `BDD_GUARDS` and
+  /// \ref guard_kindt::EXPR otherwise.
+  explicit guard_managert(guard_kindt kind = default_kind());
 
-using guard_managert = bdd_exprt;
-using guardt = guard_bddt;
+  /// Construct a manager for guards of the kind given by the value of the
+  /// `symex-guards` option (`bdd` or `expr`), or of the default kind when the
+  /// option is not set.
+  explicit guard_managert(const optionst &options);
 
+  guard_managert(const guard_managert &) = delete;
+
+  guard_kindt kind() const
+  {
+    return guard_kind;
+  }
+
+  static guard_kindt default_kind()
+  {
+#ifdef BDD_GUARDS
+    return guard_kindt::BDD;
 #else
+    return guard_kindt::EXPR;
+#endif
+  }
 
-#include "guard_expr.h"
+  /// Parse the value of the `symex-guards` option
+  /// \return the kind of guards, or an empty optional if \p value is neither
+  ///   `bdd` nor `expr`
+  static optionalt<guard_kindt> parse_kind(const std::string &value);
+
+private:
+  guard_kindt guard_kind;
+  guard_expr_managert expr_manager;
+
+  /// BDD variables are allocated in the order in which conditions are first
+  /// encountered, which for symex is the order of the branches along the
+  /// paths, keeping related conditions close in the variable order. With
+  /// CUDD the variables are also reordered by sifting as the guards grow.
+  bdd_exprt bdd_manager;
+
+  /// Set up \ref bdd_manager for guards: bound the cache of expressions,
+  /// which is the only memory that guards retain beyond the live BDDs, and
+  /// enable reordering of variables
+  void configure();
+
+  friend class guardt;
+};
+
+/// A guard is a Boolean condition under which a program state is reached,
+/// represented as determined by the \ref guard_managert it is created with.
+/// All guards that are combined must have been created with the same manager.
+class guardt
+{
+public:
+  guardt(const exprt &e, guard_managert &manager);
+
+  void add(const exprt &expr);
+
+  void append(const guardt &guard);
+
+  exprt as_expr() const;
+
+  /// Return `guard => dest` or a simplified variant thereof if either guard or
+  /// dest are trivial.
+  exprt guard_expr(exprt expr) const;
+
+  bool is_true() const;
+
+  bool is_false() const;
+
+  friend guardt &operator-=(guardt &g1, const guardt &g2);
+  friend guardt &operator|=(guardt &g1, const guardt &g2);
 
-using guard_managert = guard_expr_managert;
-using guardt = guard_exprt;
+  /// Returns true if `operator|=` with \p other_guard may result in a simpler
+  /// expression.
+  bool disjunction_may_simplify(const guardt &other_guard);
 
-#endif // BDD_GUARDS
+private:
+  /// Exactly one of the two is set, depending on the kind of the manager.
+  optionalt<guard_exprt> expr_guard;
+  optionalt<guard_bddt> bdd_guard;
+};
 
 #endif // CPROVER_ANALYSES_GUARD_H
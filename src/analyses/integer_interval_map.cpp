@@ -0,0 +1,226 @@
+/*******************************************************************\
+
+Module: Interval Domain
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Packed map from variables to integer intervals
+
+#include "integer_interval_map.h"
+
+#include <algorithm>
+#include <limits>
+
+static const std::int64_t no_lower_bound =
+  std::numeric_limits<std::int64_t>::min();
+static const std::int64_t no_upper_bound =
+  std::numeric_limits<std::int64_t>::max();
+
+/// Whether \p bound can be stored in the packed arrays, which excludes the
+/// values that stand for missing bounds
+static bool is_packable(const mp_integer &bound)
+{
+  if(!bound.is_long())
+    return false;
+  const std::int64_t value = static_cast<std::int64_t>(bound.to_long());
+  return value != no_lower_bound && value != no_upper_bound;
+}
+
+integer_intervalt integer_interval_mapt::get(const irep_idt &identifier) const
+{
+  const auto it =
+    std::lower_bound(identifiers.begin(), identifiers.end(), identifier);
+  if(it != identifiers.end() && *it == identifier)
+    return get_packed(std::distance(identifiers.begin(), it));
+
+  const auto wide_it = wide_intervals.find(identifier);
+  if(wide_it != wide_intervals.end())
+    return wide_it->second;
+
+  return integer_intervalt{};
+}
+
+integer_intervalt integer_interval_mapt::get_packed(std::size_t index) const
+{
+  integer_intervalt result;
+  if(lower[index] != no_lower_bound)
+    result.make_ge_than(mp_integer{lower[index]});
+  if(upper[index] != no_upper_bound)
+    result.make_le_than(mp_integer{upper[index]});
+  return result;
+}
+
+void integer_interval_mapt::set(
+  const irep_idt &identifier,
+  const integer_intervalt &interval)
+{
+  erase(identifier);
+
+  if(interval.is_top())
+    return;
+
+  if(
+    (interval.lower_set && !is_packable(interval.lower)) ||
+    (interval.upper_set && !is_packable(interval.upper)))
+  {
+    wide_intervals.emplace(identifier, interval);
+    return;
+  }
+
+  const auto it =
+    std::lower_bound(identifiers.begin(), identifiers.end(), identifier);
+  const std::size_t index = std::distance(identifiers.begin(), it);
+
+  identifiers.insert(it, identifier);
+  lower.insert(
+    lower.begin() + index,
+    interval.lower_set ? static_cast<std::int64_t>(interval.lower.to_long())
+                       : no_lower_bound);
+  upper.insert(
+    upper.begin() + index,
+    interval.upper_set ? static_cast<std::int64_t>(interval.upper.to_long())
+                       : no_upper_bound);
+}
+
+void integer_interval_mapt::erase(const irep_idt &identifier)
+{
+  const auto it =
+    std::lower_bound(identifiers.begin(), identifiers.end(), identifier);
+  if(it != identifiers.end() && *it == identifier)
+  {
+    const std::size_t index = std::distance(identifiers.begin(), it);
+    identifiers.erase(it);
+    lower.erase(lower.begin() + index);
+    upper.erase(upper.begin() + index);
+  }
+  else
+    wide_intervals.erase(identifier);
+}
+
+bool integer_interval_mapt::join(const integer_interval_mapt &other)
+{
+  if(wide_intervals.empty() && other.wide_intervals.empty())
+    return join_packed(other);
+
+  // Some of the intervals have to be converted, join them one by one
+  bool changed = false;
+  std::vector<std::pair<irep_idt, integer_intervalt>> joined;
+
+  iterate([&](const irep_idt &identifier, const integer_intervalt &interval) {
+    integer_intervalt result = interval;
+    result.join(other.get(identifier));
+    if(result != interval)
+      changed = true;
+    joined.emplace_back(identifier, result);
+  });
+
+  if(changed)
+  {
+    clear();
+    for(const auto &entry : joined)
+      set(entry.first, entry.second);
+  }
+
+  return changed;
+}
+
+bool integer_interval_mapt::join_packed(const integer_interval_mapt &other)
+{
+  bool changed = false;
+
+  if(identifiers == other.identifiers)
+  {
+    // Both constrain the same variables, which is the common case for states
+    // that are joined at the same location.
+    const std::size_t size = identifiers.size();
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      const std::int64_t joined_lower = std::min(lower[i], other.lower[i]);
+      const std::int64_t joined_upper = std::max(upper[i], other.upper[i]);
+      changed |= joined_lower != lower[i] || joined_upper != upper[i];
+      lower[i] = joined_lower;
+      upper[i] = joined_upper;
+    }
+  }
+  else
+  {
+    // A variable that only one of them constrains is top in the join
+    std::size_t kept = 0;
+    std::size_t j = 0;
+    for(std::size_t i = 0; i < identifiers.size(); ++i)
+    {
+      while(j < other.identifiers.size() &&
+            other.identifiers[j] < identifiers[i])
+      {
+        ++j;
+      }
+
+      if(
+        j == other.identifiers.size() || identifiers[i] < other.identifiers[j])
+      {
+        changed = true;
+        continue;
+      }
+
+      const std::int64_t joined_lower = std::min(lower[i], other.lower[j]);
+      const std::int64_t joined_upper = std::max(upper[i], other.upper[j]);
+      changed |= joined_lower != lower[i] || joined_upper != upper[i];
+      identifiers[kept] = identifiers[i];
+      lower[kept] = joined_lower;
+      upper[kept] = joined_upper;
+      ++kept;
+    }
+
+    identifiers.resize(kept);
+    lower.resize(kept);
+    upper.resize(kept);
+  }
+
+  if(changed)
+    erase_packed_top();
+
+  return changed;
+}
+
+void integer_interval_mapt::erase_packed_top()
+{
+  std::size_t kept = 0;
+  for(std::size_t i = 0; i < identifiers.size(); ++i)
+  {
+    if(lower[i] == no_lower_bound && upper[i] == no_upper_bound)
+      continue;
+
+    identifiers[kept] = identifiers[i];
+    lower[kept] = lower[i];
+    upper[kept] = upper[i];
+    ++kept;
+  }
+
+  identifiers.resize(kept);
+  lower.resize(kept);
+  upper.resize(kept);
+}
+
+void integer_interval_mapt::iterate(
+  const std::function<void(const irep_idt &, const integer_intervalt &)> &f)
+  const
+{
+  auto wide_it = wide_intervals.begin();
+
+  for(std::size_t i = 0; i < identifiers.size(); ++i)
+  {
+    for(; wide_it != wide_intervals.end() && wide_it->first < identifiers[i];
+        ++wide_it)
+    {
+      f(wide_it->first, wide_it->second);
+    }
+
+    f(identifiers[i], get_packed(i));
+  }
+
+  for(; wide_it != wide_intervals.end(); ++wide_it)
+    f(wide_it->first, wide_it->second);
+}
@@ -0,0 +1,98 @@
+/*******************************************************************\
+
+Module: Interval Domain
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Packed map from variables to integer intervals
+
+#ifndef CPROVER_ANALYSES_INTEGER_INTERVAL_MAP_H
+#define CPROVER_ANALYSES_INTEGER_INTERVAL_MAP_H
+
+#include <util/integer_interval.h>
+#include <util/irep.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+/// Map from identifiers to integer intervals. An identifier without an
+/// interval is unconstrained, that is, its interval is top.
+///
+/// Intervals whose bounds fit into 64 bits are stored in contiguous arrays
+/// sorted by identifier, with the smallest and largest 64-bit values standing
+/// for a missing lower and upper bound. This avoids allocating a map node and
+/// two \ref mp_integer bounds per variable, and joining two maps that
+/// constrain the same variables becomes a loop of minima and maxima over
+/// these arrays, which compilers vectorise. The intervals of the remaining
+/// variables, such as those of 128-bit integers, are kept as
+/// \ref integer_intervalt.
+class integer_interval_mapt
+{
+public:
+  /// The interval of \p identifier, which is top if it has none
+  integer_intervalt get(const irep_idt &identifier) const;
+
+  /// Set the interval of \p identifier to \p interval, or remove it if
+  /// \p interval is top
+  void set(const irep_idt &identifier, const integer_intervalt &interval);
+
+  void erase(const irep_idt &identifier);
+
+  void clear()
+  {
+    identifiers.clear();
+    lower.clear();
+    upper.clear();
+    wide_intervals.clear();
+  }
+
+  /// Whether no identifier has an interval
+  bool empty() const
+  {
+    return identifiers.empty() && wide_intervals.empty();
+  }
+
+  /// Replace each interval by its join with the interval of the same
+  /// identifier in \p other. Intervals that become top are removed.
+  /// \return True if any interval changed
+  bool join(const integer_interval_mapt &other);
+
+  /// Call \p f for each identifier that has an interval, in the order of the
+  /// identifiers
+  void iterate(
+    const std::function<void(const irep_idt &, const integer_intervalt &)> &f)
+    const;
+
+  bool operator==(const integer_interval_mapt &other) const
+  {
+    return identifiers == other.identifiers && lower == other.lower &&
+           upper == other.upper && wide_intervals == other.wide_intervals;
+  }
+
+protected:
+  /// Identifiers with a packed interval, sorted
+  std::vector<irep_idt> identifiers;
+  /// Lower bounds of the packed intervals, where the smallest 64-bit value
+  /// stands for no lower bound
+  std::vector<std::int64_t> lower;
+  /// Upper bounds of the packed intervals, where the largest 64-bit value
+  /// stands for no upper bound
+  std::vector<std::int64_t> upper;
+  /// Intervals with a bound that does not fit into the packed arrays
+  std::map<irep_idt, integer_intervalt> wide_intervals;
+
+  integer_intervalt get_packed(std::size_t index) const;
+
+  /// Join the packed intervals of \p other into the packed intervals
+  bool join_packed(const integer_interval_mapt &other);
+
+  /// Remove the packed intervals that are top
+  void erase_packed_top();
+};
+
+#endif // CPROVER_ANALYSES_INTEGER_INTERVAL_MAP_H
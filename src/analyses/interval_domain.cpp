@@ -31,17 +31,15 @@ void interval_domaint::output(
     return;
   }
 
-  for(const auto &interval : int_map)
-  {
-    if(interval.second.is_top())
-      continue;
-    if(interval.second.lower_set)
-      out << interval.second.lower << " <= ";
-    out << interval.first;
-    if(interval.second.upper_set)
-      out << " <= " << interval.second.upper;
-    out << "\n";
-  }
+  int_map.iterate(
+    [&out](const irep_idt &identifier, const integer_intervalt &interval) {
+      if(interval.lower_set)
+        out << interval.lower << " <= ";
+      out << identifier;
+      if(interval.upper_set)
+        out << " <= " << interval.upper;
+      out << "\n";
+    });
 
   for(const auto &interval : float_map)
   {
@@ -161,29 +159,7 @@ bool interval_domaint::join(
     return true;
   }
 
-  bool result=false;
-
-  for(int_mapt::iterator it=int_map.begin();
-      it!=int_map.end(); ) // no it++
-  {
-    // search for the variable that needs to be merged
-    // containers have different size and variable order
-    const int_mapt::const_iterator b_it=b.int_map.find(it->first);
-    if(b_it==b.int_map.end())
-    {
-      it=int_map.erase(it);
-      result=true;
-    }
-    else
-    {
-      integer_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
-
-      it++;
-    }
-  }
+  bool result=int_map.join(b.int_map);
 
   for(float_mapt::iterator it=float_map.begin();
       it!=float_map.end(); ) // no it++
@@ -281,8 +257,9 @@ void interval_domaint::assume_rec(
       mp_integer tmp = numeric_cast_v<mp_integer>(to_constant_expr(rhs));
       if(id==ID_lt)
         --tmp;
-      integer_intervalt &ii=int_map[lhs_identifier];
+      integer_intervalt ii = int_map.get(lhs_identifier);
       ii.make_le_than(tmp);
+      int_map.set(lhs_identifier, ii);
       if(ii.is_bottom())
         make_bottom();
     }
@@ -306,8 +283,9 @@ void interval_domaint::assume_rec(
       mp_integer tmp = numeric_cast_v<mp_integer>(to_constant_expr(lhs));
       if(id==ID_lt)
         ++tmp;
-      integer_intervalt &ii=int_map[rhs_identifier];
+      integer_intervalt ii = int_map.get(rhs_identifier);
       ii.make_ge_than(tmp);
+      int_map.set(rhs_identifier, ii);
       if(ii.is_bottom())
         make_bottom();
     }
@@ -329,12 +307,14 @@ void interval_domaint::assume_rec(
 
     if(is_int(lhs.type()) && is_int(rhs.type()))
     {
-      integer_intervalt &lhs_i=int_map[lhs_identifier];
-      integer_intervalt &rhs_i=int_map[rhs_identifier];
+      integer_intervalt lhs_i = int_map.get(lhs_identifier);
+      integer_intervalt rhs_i = int_map.get(rhs_identifier);
       if(id == ID_lt && !lhs_i.is_less_than(rhs_i))
         lhs_i.make_less_than(rhs_i);
       if(id == ID_le && !lhs_i.is_less_than_eq(rhs_i))
         lhs_i.make_less_than_eq(rhs_i);
+      int_map.set(lhs_identifier, lhs_i);
+      int_map.set(rhs_identifier, rhs_i);
     }
     else if(is_float(lhs.type()) && is_float(rhs.type()))
     {
@@ -409,11 +389,7 @@ exprt interval_domaint::make_expression(const symbol_exprt &src) const
 {
   if(is_int(src.type()))
   {
-    int_mapt::const_iterator i_it=int_map.find(src.get_identifier());
-    if(i_it==int_map.end())
-      return true_exprt();
-
-    const integer_intervalt &interval=i_it->second;
+    const integer_intervalt interval = int_map.get(src.get_identifier());
     if(interval.is_top())
       return true_exprt();
     if(interval.is_bottom())
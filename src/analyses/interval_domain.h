@@ -17,6 +17,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/interval_template.h>
 
 #include "ai_domain.h"
+#include "integer_interval_map.h"
 
 typedef interval_templatet<ieee_floatt> ieee_float_intervalt;
 
@@ -111,7 +112,7 @@ class interval_domaint:public ai_domain_baset
 protected:
   bool bottom;
 
-  typedef std::map<irep_idt, integer_intervalt> int_mapt;
+  typedef integer_interval_mapt int_mapt;
   typedef std::map<irep_idt, ieee_float_intervalt> float_mapt;
 
   int_mapt int_map;
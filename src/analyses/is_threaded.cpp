@@ -15,6 +15,8 @@ Date: October 2012
 
 #include "ai.h"
 
+#include <algorithm>
+
 class is_threaded_domaint:public ai_domain_baset
 {
 public:
@@ -92,8 +94,29 @@ class is_threaded_domaint:public ai_domain_baset
   }
 };
 
+bool has_start_thread(const goto_functionst &goto_functions)
+{
+  return std::any_of(
+    goto_functions.function_map.begin(),
+    goto_functions.function_map.end(),
+    [](const goto_functionst::function_mapt::value_type &gf_entry) {
+      const auto &instructions = gf_entry.second.body.instructions;
+      return std::any_of(
+        instructions.begin(),
+        instructions.end(),
+        [](const goto_programt::instructiont &instruction) {
+          return instruction.is_start_thread();
+        });
+    });
+}
+
 void is_threadedt::compute(const goto_functionst &goto_functions)
 {
+  // Without any START_THREAD no instruction can be threaded, which is much
+  // cheaper to establish than by running the analysis over the whole program
+  if(!has_start_thread(goto_functions))
+    return;
+
   // the analysis doesn't actually use the namespace, fake one
   symbol_tablet symbol_table;
   const namespacet ns(symbol_table);
@@ -18,6 +18,10 @@ Date: October 2012
 
 #include <goto-programs/goto_model.h>
 
+/// Whether any function in \p goto_functions contains a START_THREAD
+/// instruction, which is necessary for any instruction to be threaded
+bool has_start_thread(const goto_functionst &goto_functions);
+
 class is_threadedt
 {
 public:
@@ -0,0 +1,934 @@
+/*******************************************************************\
+
+Module: Octagon Domain
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Octagon Domain
+
+#include "octagon_domain.h"
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/expr_iterator.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+#include <util/symbol.h>
+#include <util/union_find.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <functional>
+#include <unordered_set>
+
+const std::size_t octagon_packingt::max_pack_size = 8;
+
+static bool is_int(const typet &type)
+{
+  return type.id() == ID_signedbv || type.id() == ID_unsignedbv;
+}
+
+static bool is_relation(const exprt &expr)
+{
+  return expr.id() == ID_lt || expr.id() == ID_le || expr.id() == ID_gt ||
+         expr.id() == ID_ge || expr.id() == ID_equal ||
+         expr.id() == ID_notequal;
+}
+
+/// The variable that \p expr is computed from by adding constants, negating
+/// and type casts, if any
+static const symbol_exprt *get_base_variable(const exprt &expr)
+{
+  if(expr.id() == ID_symbol)
+    return &to_symbol_expr(expr);
+  else if(expr.id() == ID_typecast || expr.id() == ID_unary_minus)
+    return get_base_variable(to_unary_expr(expr).op());
+  else if(
+    (expr.id() == ID_plus || expr.id() == ID_minus) &&
+    expr.operands().size() == 2)
+  {
+    const auto &binary = to_binary_expr(expr);
+    if(binary.op1().is_constant())
+      return get_base_variable(binary.op0());
+    if(binary.op0().is_constant())
+      return get_base_variable(binary.op1());
+  }
+  return nullptr;
+}
+
+/// Call \p f on the expressions of \p instruction
+static void for_each_expr(
+  const goto_programt::instructiont &instruction,
+  const std::function<void(const exprt &)> &f)
+{
+  for(auto it = instruction.code().depth_cbegin();
+      it != instruction.code().depth_cend();
+      ++it)
+  {
+    f(*it);
+  }
+
+  if(instruction.has_condition())
+  {
+    for(auto it = instruction.condition().depth_cbegin();
+        it != instruction.condition().depth_cend();
+        ++it)
+    {
+      f(*it);
+    }
+  }
+}
+
+octagon_packingt::octagon_packingt(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  std::unordered_set<irep_idt> address_taken;
+  for(const auto &f : goto_functions.function_map)
+  {
+    for(const auto &instruction : f.second.body.instructions)
+    {
+      for_each_expr(instruction, [&address_taken](const exprt &expr) {
+        if(expr.id() != ID_address_of)
+          return;
+        const exprt *object = &to_address_of_expr(expr).object();
+        while(object->id() == ID_member || object->id() == ID_index)
+          object = &object->operands().front();
+        if(object->id() == ID_symbol)
+          address_taken.insert(to_symbol_expr(*object).get_identifier());
+      });
+    }
+  }
+
+  // Number the tracked variables in the order in which they appear
+  std::vector<variablet> variables;
+  std::unordered_map<irep_idt, optionalt<std::size_t>> numbers;
+  const auto number =
+    [&](const symbol_exprt &symbol_expr) -> optionalt<std::size_t> {
+    const irep_idt &identifier = symbol_expr.get_identifier();
+    const auto entry = numbers.find(identifier);
+    if(entry != numbers.end())
+      return entry->second;
+
+    optionalt<std::size_t> result;
+    const symbolt *symbol;
+    if(
+      is_int(symbol_expr.type()) && address_taken.count(identifier) == 0 &&
+      !ns.lookup(identifier, symbol) && !symbol->is_static_lifetime)
+    {
+      const auto &type = to_integer_bitvector_type(symbol_expr.type());
+      result = variables.size();
+      variables.push_back({identifier, type.smallest(), type.largest()});
+    }
+
+    numbers.emplace(identifier, result);
+    return result;
+  };
+
+  std::vector<std::pair<std::size_t, std::size_t>> relations;
+  const auto relate = [&](const exprt &a, const exprt &b) {
+    const symbol_exprt *symbol_a = get_base_variable(a);
+    const symbol_exprt *symbol_b = get_base_variable(b);
+    if(symbol_a == nullptr || symbol_b == nullptr)
+      return;
+    const auto number_a = number(*symbol_a);
+    const auto number_b = number(*symbol_b);
+    if(number_a.has_value() && number_b.has_value() && *number_a != *number_b)
+      relations.emplace_back(*number_a, *number_b);
+  };
+
+  for(const auto &f : goto_functions.function_map)
+  {
+    for(const auto &instruction : f.second.body.instructions)
+    {
+      for_each_expr(instruction, [&number](const exprt &expr) {
+        if(expr.id() == ID_symbol)
+          number(to_symbol_expr(expr));
+      });
+
+      if(instruction.is_assign())
+        relate(instruction.assign_lhs(), instruction.assign_rhs());
+
+      if(instruction.has_condition())
+      {
+        const exprt &condition = instruction.condition();
+        for(auto it = condition.depth_cbegin(); it != condition.depth_cend();
+            ++it)
+        {
+          if(is_relation(*it))
+            relate(to_binary_expr(*it).op0(), to_binary_expr(*it).op1());
+        }
+      }
+    }
+  }
+
+  unsigned_union_find union_find;
+  union_find.resize(variables.size());
+  for(const auto &relation : relations)
+  {
+    if(
+      !union_find.same_set(relation.first, relation.second) &&
+      union_find.count(relation.first) + union_find.count(relation.second) <=
+        max_pack_size)
+    {
+      union_find.make_union(relation.first, relation.second);
+    }
+  }
+
+  std::unordered_map<std::size_t, std::size_t> pack_of_root;
+  for(std::size_t i = 0; i < variables.size(); ++i)
+  {
+    const auto pack =
+      pack_of_root.emplace(union_find.find(i), packs.size()).first->second;
+    if(pack == packs.size())
+      packs.emplace_back();
+
+    positions.emplace(
+      variables[i].identifier, positiont{pack, packs[pack].size()});
+    packs[pack].push_back(variables[i]);
+  }
+}
+
+optionalt<octagon_packingt::positiont>
+octagon_packingt::find(const irep_idt &identifier) const
+{
+  const auto entry = positions.find(identifier);
+  if(entry == positions.end())
+    return {};
+  return entry->second;
+}
+
+/// \p value as a bound of an \ref octagon_matrixt, if it can be stored
+static optionalt<octagon_matrixt::boundt> to_bound(const mp_integer &value)
+{
+  if(
+    value <= -octagon_matrixt::bound_limit ||
+    value >= octagon_matrixt::bound_limit)
+  {
+    return {};
+  }
+  return static_cast<octagon_matrixt::boundt>(value.to_long());
+}
+
+/// The largest integer that is at most half of \p bound
+static mp_integer floor_half(octagon_matrixt::boundt bound)
+{
+  return bound >= 0 ? mp_integer{bound / 2} : -mp_integer{(1 - bound) / 2};
+}
+
+void octagon_domaint::output(
+  std::ostream &out,
+  const ai_baset &,
+  const namespacet &) const
+{
+  if(bottom)
+  {
+    out << "BOTTOM\n";
+    return;
+  }
+
+  for(const auto &entry : matrices)
+  {
+    const auto &pack = packing->pack(entry.first);
+    const octagon_matrixt &matrix = entry.second;
+
+    for(std::size_t i = 0; i < pack.size(); ++i)
+    {
+      const std::size_t positive_i = octagon_matrixt::positive(i);
+      const std::size_t negative_i = octagon_matrixt::negative(i);
+      const auto upper = matrix.get_sum_bound(positive_i, positive_i);
+      const auto lower = matrix.get_sum_bound(negative_i, negative_i);
+      if(upper == octagon_matrixt::infinity && lower == octagon_matrixt::infinity)
+        continue;
+
+      if(lower != octagon_matrixt::infinity)
+        out << -floor_half(lower) << " <= ";
+      out << pack[i].identifier;
+      if(upper != octagon_matrixt::infinity)
+        out << " <= " << floor_half(upper);
+      out << "\n";
+    }
+
+    for(std::size_t i = 0; i < pack.size(); ++i)
+    {
+      for(std::size_t j = i + 1; j < pack.size(); ++j)
+      {
+        const auto output_bound = [&](
+                                    bool negated_i,
+                                    bool negated_j,
+                                    const std::string &relation) {
+          const auto bound = matrix.get_sum_bound(
+            negated_i ? octagon_matrixt::negative(i)
+                      : octagon_matrixt::positive(i),
+            negated_j ? octagon_matrixt::negative(j)
+                      : octagon_matrixt::positive(j));
+          if(bound == octagon_matrixt::infinity)
+            return;
+          out << (negated_i ? "-" : "") << pack[i].identifier << relation
+              << pack[j].identifier << " <= " << bound << "\n";
+        };
+
+        output_bound(false, true, " - ");
+        output_bound(true, false, " + ");
+        output_bound(false, false, " + ");
+        output_bound(true, true, " - ");
+      }
+    }
+  }
+}
+
+void octagon_domaint::transform(
+  const irep_idt &function_from,
+  trace_ptrt trace_from,
+  const irep_idt &function_to,
+  trace_ptrt trace_to,
+  ai_baset &,
+  const namespacet &ns)
+{
+  locationt from{trace_from->current_location()};
+  locationt to{trace_to->current_location()};
+
+  const goto_programt::instructiont &instruction = *from;
+  switch(instruction.type())
+  {
+  case DECL:
+    havoc_rec(instruction.decl_symbol());
+    break;
+
+  case DEAD:
+    havoc_rec(instruction.dead_symbol());
+    break;
+
+  case ASSIGN:
+    assign(instruction.assign_lhs(), instruction.assign_rhs());
+    break;
+
+  case GOTO:
+  {
+    // Comparing iterators is safe as the target must be within the same list
+    // of instructions because this is a GOTO.
+    locationt next = from;
+    next++;
+    if(from->get_target() != next) // If equal then a skip
+    {
+      if(next == to)
+        assume(not_exprt(instruction.condition()), ns);
+      else
+        assume(instruction.condition(), ns);
+    }
+    break;
+  }
+
+  case ASSUME:
+    assume(instruction.condition(), ns);
+    break;
+
+  case FUNCTION_CALL:
+  {
+    const auto &lhs = instruction.call_lhs();
+    if(lhs.is_not_nil())
+      havoc_rec(lhs);
+
+    // Entering the callee: its parameters get the values of the arguments,
+    // unless it is recursive and the arguments may refer to the parameters
+    if(to != std::next(from))
+    {
+      const code_typet &callee_type =
+        to_code_type(ns.lookup(function_to).type);
+      const auto &parameters = callee_type.parameters();
+      const auto &arguments = instruction.call_arguments();
+
+      for(const auto &parameter : parameters)
+        forget(parameter.get_identifier());
+
+      if(function_from != function_to)
+      {
+        for(std::size_t i = 0; i < parameters.size() && i < arguments.size();
+            ++i)
+        {
+          assign(
+            symbol_exprt{parameters[i].get_identifier(), parameters[i].type()},
+            arguments[i]);
+        }
+      }
+    }
+    break;
+  }
+
+  case CATCH:
+  case THROW:
+    DATA_INVARIANT(false, "Exceptions must be removed before analysis");
+    break;
+  case SET_RETURN_VALUE:
+    DATA_INVARIANT(false, "SET_RETURN_VALUE must be removed before analysis");
+    break;
+  case ATOMIC_BEGIN: // Ignoring is a valid over-approximation
+  case ATOMIC_END:   // Ignoring is a valid over-approximation
+  case END_FUNCTION: // No action required
+  case START_THREAD: // Require a concurrent analysis at higher level
+  case END_THREAD:   // Require a concurrent analysis at higher level
+  case ASSERT:       // No action required
+  case LOCATION:     // No action required
+  case SKIP:         // No action required
+  case OTHER:        // Cannot change tracked variables
+    break;
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    DATA_INVARIANT(false, "Only complete instructions can be analyzed");
+    break;
+  }
+}
+
+/// Join the octagons of \p b into this one. Along an edge that does not go
+/// forward in the numbering of locations, such as a backwards goto, this
+/// widens instead. Every cycle of the control flow, including those through
+/// recursive calls, has such an edge, hence the analysis terminates.
+/// \return True if the octagons have changed
+bool octagon_domaint::merge(
+  const octagon_domaint &b,
+  trace_ptrt from,
+  trace_ptrt to)
+{
+  if(b.bottom)
+    return false;
+  if(bottom)
+  {
+    *this = b;
+    return true;
+  }
+
+  const bool widen = to->current_location()->location_number <=
+                     from->current_location()->location_number;
+
+  bool changed = false;
+  for(auto it = matrices.begin(); it != matrices.end();) // no it++
+  {
+    const auto b_it = b.matrices.find(it->first);
+    if(b_it == b.matrices.end())
+    {
+      it = matrices.erase(it);
+      changed = true;
+      continue;
+    }
+
+    changed |=
+      widen ? it->second.widen(b_it->second) : it->second.join(b_it->second);
+
+    if(it->second.is_top())
+      it = matrices.erase(it);
+    else
+      ++it;
+  }
+
+  return changed;
+}
+
+octagon_matrixt &octagon_domaint::get_matrix(std::size_t pack)
+{
+  return matrices
+    .emplace(pack, octagon_matrixt{packing->pack(pack).size()})
+    .first->second;
+}
+
+void octagon_domaint::close(std::size_t pack)
+{
+  const auto it = matrices.find(pack);
+  if(it == matrices.end())
+    return;
+
+  if(!it->second.close())
+    make_bottom();
+  else if(it->second.is_top())
+    matrices.erase(it);
+}
+
+integer_intervalt
+octagon_domaint::get_interval(const octagon_packingt::positiont &position) const
+{
+  const auto &pack = packing->pack(position.pack);
+  integer_intervalt result{pack[position.index].smallest,
+                           pack[position.index].largest};
+
+  const auto it = matrices.find(position.pack);
+  if(it == matrices.end())
+    return result;
+
+  const octagon_matrixt &matrix = it->second;
+  const std::size_t positive = octagon_matrixt::positive(position.index);
+  const std::size_t negative = octagon_matrixt::negative(position.index);
+
+  const auto upper = matrix.get_sum_bound(positive, positive);
+  if(upper != octagon_matrixt::infinity)
+    result.make_le_than(floor_half(upper));
+  const auto lower = matrix.get_sum_bound(negative, negative);
+  if(lower != octagon_matrixt::infinity)
+    result.make_ge_than(-floor_half(lower));
+
+  // The bounds of the types of the other variables of the pack are not in
+  // the matrix, but may bound this variable.
+  for(std::size_t i = 0; i < pack.size(); ++i)
+  {
+    if(i == position.index)
+      continue;
+
+    const std::size_t positive_i = octagon_matrixt::positive(i);
+    const std::size_t negative_i = octagon_matrixt::negative(i);
+
+    const auto minus_i = matrix.get_sum_bound(positive, negative_i);
+    if(minus_i != octagon_matrixt::infinity)
+      result.make_le_than(minus_i + pack[i].largest);
+    const auto plus_i = matrix.get_sum_bound(positive, positive_i);
+    if(plus_i != octagon_matrixt::infinity)
+      result.make_le_than(plus_i - pack[i].smallest);
+    const auto negated_minus_i = matrix.get_sum_bound(negative, negative_i);
+    if(negated_minus_i != octagon_matrixt::infinity)
+      result.make_ge_than(-negated_minus_i - pack[i].largest);
+    const auto negated_plus_i = matrix.get_sum_bound(negative, positive_i);
+    if(negated_plus_i != octagon_matrixt::infinity)
+      result.make_ge_than(pack[i].smallest - negated_plus_i);
+  }
+
+  return result;
+}
+
+integer_intervalt octagon_domaint::get_interval(const termt &term) const
+{
+  if(term.variable.empty())
+    return integer_intervalt{term.constant, term.constant};
+
+  const auto position = packing->find(term.variable);
+  CHECK_RETURN(position.has_value());
+  const integer_intervalt interval = get_interval(*position);
+
+  if(term.negated)
+  {
+    return integer_intervalt{-interval.upper + term.constant,
+                             -interval.lower + term.constant};
+  }
+  else
+  {
+    return integer_intervalt{interval.lower + term.constant,
+                             interval.upper + term.constant};
+  }
+}
+
+optionalt<octagon_domaint::termt>
+octagon_domaint::get_term(const exprt &expr) const
+{
+  if(!is_int(expr.type()))
+    return {};
+
+  optionalt<termt> result;
+
+  if(expr.is_constant())
+  {
+    const auto value = numeric_cast<mp_integer>(to_constant_expr(expr));
+    if(!value.has_value())
+      return {};
+    result = termt{};
+    result->constant = *value;
+    return result;
+  }
+  else if(expr.id() == ID_symbol)
+  {
+    const irep_idt &identifier = to_symbol_expr(expr).get_identifier();
+    if(!packing->find(identifier).has_value())
+      return {};
+    result = termt{};
+    result->variable = identifier;
+    return result;
+  }
+  else if(expr.id() == ID_typecast)
+  {
+    if(!is_int(to_typecast_expr(expr).op().type()))
+      return {};
+    result = get_term(to_typecast_expr(expr).op());
+  }
+  else if(expr.id() == ID_unary_minus)
+  {
+    result = get_term(to_unary_minus_expr(expr).op());
+    if(result.has_value())
+    {
+      result->negated = !result->negated;
+      result->constant = -result->constant;
+    }
+  }
+  else if(
+    (expr.id() == ID_plus || expr.id() == ID_minus) &&
+    expr.operands().size() == 2)
+  {
+    const auto lhs = get_term(to_binary_expr(expr).op0());
+    auto rhs = get_term(to_binary_expr(expr).op1());
+    if(
+      !lhs.has_value() || !rhs.has_value() ||
+      (!lhs->variable.empty() && !rhs->variable.empty()))
+    {
+      return {};
+    }
+
+    if(expr.id() == ID_minus)
+    {
+      rhs->negated = !rhs->negated;
+      rhs->constant = -rhs->constant;
+    }
+
+    result = lhs->variable.empty() ? rhs : lhs;
+    result->constant = lhs->constant + rhs->constant;
+  }
+
+  if(!result.has_value())
+    return {};
+
+  // Values that do not fit into the type would wrap around
+  const integer_intervalt interval = get_interval(*result);
+  const auto &type = to_integer_bitvector_type(expr.type());
+  if(interval.lower < type.smallest() || interval.upper > type.largest())
+    return {};
+
+  return result;
+}
+
+void octagon_domaint::forget(const irep_idt &identifier)
+{
+  const auto position = packing->find(identifier);
+  if(!position.has_value())
+    return;
+
+  const auto it = matrices.find(position->pack);
+  if(it == matrices.end())
+    return;
+
+  it->second.forget(position->index);
+  if(it->second.is_top())
+    matrices.erase(it);
+}
+
+void octagon_domaint::havoc_rec(const exprt &lhs)
+{
+  if(lhs.id() == ID_if)
+  {
+    havoc_rec(to_if_expr(lhs).true_case());
+    havoc_rec(to_if_expr(lhs).false_case());
+  }
+  else if(lhs.id() == ID_symbol)
+    forget(to_symbol_expr(lhs).get_identifier());
+  else if(lhs.id() == ID_typecast)
+    havoc_rec(to_typecast_expr(lhs).op());
+}
+
+void octagon_domaint::assign(const exprt &lhs, const exprt &rhs)
+{
+  if(bottom)
+    return;
+
+  if(lhs.id() != ID_symbol)
+  {
+    havoc_rec(lhs);
+    return;
+  }
+
+  const irep_idt &identifier = to_symbol_expr(lhs).get_identifier();
+  const auto position = packing->find(identifier);
+  if(!position.has_value())
+    return;
+
+  const auto term = get_term(rhs);
+  const auto &variable = packing->variable(*position);
+  const integer_intervalt interval =
+    term.has_value() ? get_interval(*term) : integer_intervalt{};
+  if(
+    !term.has_value() || interval.lower < variable.smallest ||
+    interval.upper > variable.largest)
+  {
+    forget(identifier);
+    return;
+  }
+
+  if(term->variable == identifier)
+  {
+    // Translate the constraints on the variable
+    const auto it = matrices.find(position->pack);
+    if(it == matrices.end())
+      return;
+
+    const auto offset = to_bound(term->constant);
+    if(!offset.has_value())
+    {
+      forget(identifier);
+      return;
+    }
+
+    if(term->negated)
+      it->second.negate(position->index);
+    it->second.shift(position->index, *offset);
+    if(it->second.is_top())
+      matrices.erase(it);
+    return;
+  }
+
+  forget(identifier);
+
+  termt lhs_term;
+  lhs_term.variable = identifier;
+  termt negated_lhs_term = lhs_term;
+  negated_lhs_term.negated = true;
+
+  const auto rhs_position = packing->find(term->variable);
+  if(rhs_position.has_value() && rhs_position->pack == position->pack)
+  {
+    termt negated_term = *term;
+    negated_term.negated = !negated_term.negated;
+    add_constraint(lhs_term, negated_term, term->constant);
+    add_constraint(negated_lhs_term, *term, -term->constant);
+  }
+  else
+  {
+    add_constraint(lhs_term, interval.upper);
+    add_constraint(negated_lhs_term, -interval.lower);
+  }
+}
+
+void octagon_domaint::add_constraint(const termt &term, const mp_integer &c)
+{
+  if(bottom)
+    return;
+
+  if(term.variable.empty())
+  {
+    if(c < 0)
+      make_bottom();
+    return;
+  }
+
+  // Bounds of single variables are stored doubled
+  const auto bound = to_bound(2 * c);
+  if(!bound.has_value())
+    return;
+
+  const auto position = packing->find(term.variable);
+  CHECK_RETURN(position.has_value());
+  const std::size_t node = term.negated
+                             ? octagon_matrixt::negative(position->index)
+                             : octagon_matrixt::positive(position->index);
+
+  get_matrix(position->pack).add_sum_constraint(node, node, *bound);
+  close(position->pack);
+}
+
+void octagon_domaint::add_constraint(
+  const termt &lhs,
+  const termt &rhs,
+  const mp_integer &c)
+{
+  if(bottom)
+    return;
+
+  if(rhs.variable.empty())
+    return add_constraint(lhs, c);
+  if(lhs.variable.empty())
+    return add_constraint(rhs, c);
+
+  if(lhs.variable == rhs.variable)
+  {
+    // x - x <= c
+    if(lhs.negated != rhs.negated)
+    {
+      if(c < 0)
+        make_bottom();
+      return;
+    }
+
+    // x + x <= c
+    const auto bound = to_bound(c);
+    const auto position = packing->find(lhs.variable);
+    CHECK_RETURN(position.has_value());
+    if(bound.has_value())
+    {
+      const std::size_t node = lhs.negated
+                                 ? octagon_matrixt::negative(position->index)
+                                 : octagon_matrixt::positive(position->index);
+      get_matrix(position->pack).add_sum_constraint(node, node, *bound);
+      close(position->pack);
+    }
+    return;
+  }
+
+  const auto lhs_position = packing->find(lhs.variable);
+  const auto rhs_position = packing->find(rhs.variable);
+  CHECK_RETURN(lhs_position.has_value() && rhs_position.has_value());
+
+  if(lhs_position->pack == rhs_position->pack)
+  {
+    const auto bound = to_bound(c);
+    if(!bound.has_value())
+      return;
+
+    const std::size_t lhs_node =
+      lhs.negated ? octagon_matrixt::negative(lhs_position->index)
+                  : octagon_matrixt::positive(lhs_position->index);
+    const std::size_t rhs_node =
+      rhs.negated ? octagon_matrixt::negative(rhs_position->index)
+                  : octagon_matrixt::positive(rhs_position->index);
+    get_matrix(lhs_position->pack).add_sum_constraint(lhs_node, rhs_node, *bound);
+    close(lhs_position->pack);
+    return;
+  }
+
+  // The variables are not related, bound each by the other's bounds
+  termt lhs_variable = lhs;
+  lhs_variable.constant = 0;
+  termt rhs_variable = rhs;
+  rhs_variable.constant = 0;
+  const integer_intervalt lhs_interval = get_interval(lhs_variable);
+  const integer_intervalt rhs_interval = get_interval(rhs_variable);
+
+  add_constraint(lhs_variable, c - rhs_interval.lower);
+  add_constraint(rhs_variable, c - lhs_interval.lower);
+}
+
+void octagon_domaint::assume_rec(
+  const exprt &lhs,
+  irep_idt id,
+  const exprt &rhs)
+{
+  if(id == ID_equal)
+  {
+    assume_rec(lhs, ID_ge, rhs);
+    assume_rec(lhs, ID_le, rhs);
+    return;
+  }
+
+  if(id == ID_ge)
+    return assume_rec(rhs, ID_le, lhs);
+
+  if(id == ID_gt)
+    return assume_rec(rhs, ID_lt, lhs);
+
+  if(bottom)
+    return;
+
+  const auto lhs_term = get_term(lhs);
+  const auto rhs_term = get_term(rhs);
+  if(!lhs_term.has_value() || !rhs_term.has_value())
+    return;
+
+  if(id == ID_notequal)
+  {
+    // won't do split
+    if(
+      lhs_term->variable.empty() && rhs_term->variable.empty() &&
+      lhs_term->constant == rhs_term->constant)
+    {
+      make_bottom();
+    }
+    return;
+  }
+
+  DATA_INVARIANT(id == ID_lt || id == ID_le, "unexpected comparison operator");
+
+  // lhs - rhs <= 0, or <= -1 for <
+  termt negated_rhs = *rhs_term;
+  negated_rhs.negated = !negated_rhs.negated;
+  mp_integer c = rhs_term->constant - lhs_term->constant;
+  if(id == ID_lt)
+    --c;
+
+  add_constraint(*lhs_term, negated_rhs, c);
+}
+
+void octagon_domaint::assume(const exprt &cond, const namespacet &ns)
+{
+  assume_rec(simplify_expr(cond, ns), false);
+}
+
+void octagon_domaint::assume_rec(const exprt &cond, bool negation)
+{
+  if(is_relation(cond))
+  {
+    const auto &rel = to_binary_relation_expr(cond);
+
+    if(negation) // !x<y  ---> x>=y
+    {
+      if(rel.id() == ID_lt)
+        assume_rec(rel.op0(), ID_ge, rel.op1());
+      else if(rel.id() == ID_le)
+        assume_rec(rel.op0(), ID_gt, rel.op1());
+      else if(rel.id() == ID_gt)
+        assume_rec(rel.op0(), ID_le, rel.op1());
+      else if(rel.id() == ID_ge)
+        assume_rec(rel.op0(), ID_lt, rel.op1());
+      else if(rel.id() == ID_equal)
+        assume_rec(rel.op0(), ID_notequal, rel.op1());
+      else if(rel.id() == ID_notequal)
+        assume_rec(rel.op0(), ID_equal, rel.op1());
+    }
+    else
+      assume_rec(rel.op0(), rel.id(), rel.op1());
+  }
+  else if(cond.id() == ID_not)
+  {
+    assume_rec(to_not_expr(cond).op(), !negation);
+  }
+  else if(cond.id() == ID_and)
+  {
+    if(!negation)
+    {
+      for(const auto &op : cond.operands())
+        assume_rec(op, false);
+    }
+  }
+  else if(cond.id() == ID_or)
+  {
+    if(negation)
+    {
+      for(const auto &op : cond.operands())
+        assume_rec(op, true);
+    }
+  }
+  else if(cond.is_false() && !negation)
+    make_bottom();
+}
+
+/// A condition holds if assuming its negation gives bottom, and fails if
+/// assuming it gives bottom. Conjunctions hold if each conjunct holds, as
+/// their negation cannot be assumed precisely.
+bool octagon_domaint::ai_simplify(exprt &condition, const namespacet &ns) const
+{
+  const bool unchanged = condition.is_true() || condition.is_false();
+
+  if(condition.id() == ID_and)
+  {
+    for(const auto &op : condition.operands())
+    {
+      exprt conjunct = op;
+      ai_simplify(conjunct, ns);
+      if(!conjunct.is_true())
+        return true;
+    }
+    condition = true_exprt();
+    return unchanged;
+  }
+
+  octagon_domaint negated(*this);
+  negated.assume(not_exprt(condition), ns);
+  if(negated.is_bottom())
+  {
+    condition = true_exprt();
+    return unchanged;
+  }
+
+  octagon_domaint assumed(*this);
+  assumed.assume(condition, ns);
+  if(assumed.is_bottom())
+  {
+    condition = false_exprt();
+    return unchanged;
+  }
+
+  return true;
+}
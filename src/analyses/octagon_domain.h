@@ -0,0 +1,207 @@
+/*******************************************************************\
+
+Module: Octagon Domain
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Octagon Domain
+
+#ifndef CPROVER_ANALYSES_OCTAGON_DOMAIN_H
+#define CPROVER_ANALYSES_OCTAGON_DOMAIN_H
+
+#include <util/integer_interval.h>
+#include <util/optional.h>
+
+#include "ai_domain.h"
+#include "octagon_matrix.h"
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+class goto_functionst;
+
+/// The partition of the integer variables of a program into packs. The
+/// octagon domain only relates variables within the same pack, which keeps
+/// its matrices small.
+///
+/// Two variables are put into the same pack if they are compared with each
+/// other in a condition, or if one is assigned the other plus or minus a
+/// constant, as long as the pack does not grow beyond \ref max_pack_size.
+/// Only local variables with a signed or unsigned bit-vector type whose
+/// address is never taken are tracked, as neither function calls nor
+/// assignments through pointers can change any other variable.
+class octagon_packingt
+{
+public:
+  octagon_packingt(const goto_functionst &goto_functions, const namespacet &ns);
+
+  /// The largest number of variables in a pack
+  static const std::size_t max_pack_size;
+
+  struct variablet
+  {
+    irep_idt identifier;
+    /// The values of the type of the variable
+    mp_integer smallest;
+    mp_integer largest;
+  };
+
+  struct positiont
+  {
+    std::size_t pack;
+    std::size_t index;
+  };
+
+  /// The pack of \p identifier and its index within the pack, if the
+  /// variable is tracked
+  optionalt<positiont> find(const irep_idt &identifier) const;
+
+  const std::vector<variablet> &pack(std::size_t pack) const
+  {
+    return packs[pack];
+  }
+
+  const variablet &variable(const positiont &position) const
+  {
+    return packs[position.pack][position.index];
+  }
+
+protected:
+  std::vector<std::vector<variablet>> packs;
+  std::unordered_map<irep_idt, positiont> positions;
+};
+
+/// Relational domain of integer octagons, that is, conjunctions of
+/// constraints ±x ± y <= c over the integer variables of a program. This can
+/// prove, for example, that `i + 1 <= n` after a guard `i < n`, which is
+/// beyond the reach of the non-relational domains.
+///
+/// Variables are partitioned by an \ref octagon_packingt and the constraints
+/// of each pack are kept in an \ref octagon_matrixt. Packs without
+/// constraints are not stored. Matrices are closed after each transformer,
+/// except after widening. Merging along a backwards goto widens, such that
+/// the analysis of loops terminates.
+class octagon_domaint : public ai_domain_baset
+{
+public:
+  explicit octagon_domaint(std::shared_ptr<const octagon_packingt> packing)
+    : packing(std::move(packing)), bottom(true)
+  {
+  }
+
+  void transform(
+    const irep_idt &function_from,
+    trace_ptrt trace_from,
+    const irep_idt &function_to,
+    trace_ptrt trace_to,
+    ai_baset &ai,
+    const namespacet &ns) final override;
+
+  void output(std::ostream &out, const ai_baset &ai, const namespacet &ns)
+    const override;
+
+  bool merge(const octagon_domaint &b, trace_ptrt from, trace_ptrt to);
+
+  void make_bottom() final override
+  {
+    matrices.clear();
+    bottom = true;
+  }
+
+  void make_top() final override
+  {
+    matrices.clear();
+    bottom = false;
+  }
+
+  void make_entry() final override
+  {
+    make_top();
+  }
+
+  bool is_bottom() const override final
+  {
+    return bottom;
+  }
+
+  bool is_top() const override final
+  {
+    return !bottom && matrices.empty();
+  }
+
+  void assume(const exprt &, const namespacet &);
+
+  bool ai_simplify(exprt &condition, const namespacet &ns) const override;
+
+  /// A value of the form `±variable + constant`, or just `constant` if
+  /// `variable` is empty
+  struct termt
+  {
+    irep_idt variable;
+    bool negated = false;
+    mp_integer constant = 0;
+  };
+
+protected:
+  std::shared_ptr<const octagon_packingt> packing;
+  bool bottom;
+
+  /// The constraints of the packs that have any
+  std::map<std::size_t, octagon_matrixt> matrices;
+
+  /// The matrix of \p pack, which is created if there is none
+  octagon_matrixt &get_matrix(std::size_t pack);
+
+  /// Close the matrix of \p pack, making the domain bottom if it is empty
+  void close(std::size_t pack);
+
+  /// The values that \p identifier, a tracked variable, can have
+  integer_intervalt get_interval(const octagon_packingt::positiont &) const;
+  integer_intervalt get_interval(const termt &) const;
+
+  /// \p expr as a \ref termt, if it is one and its evaluation cannot
+  /// overflow in the current state
+  optionalt<termt> get_term(const exprt &expr) const;
+
+  void forget(const irep_idt &identifier);
+  void havoc_rec(const exprt &lhs);
+  void assign(const exprt &lhs, const exprt &rhs);
+  void assume_rec(const exprt &cond, bool negation);
+  void assume_rec(const exprt &lhs, irep_idt id, const exprt &rhs);
+
+  /// Add the constraint `lhs + rhs <= c`, where the constants of the terms
+  /// are ignored
+  void add_constraint(const termt &lhs, const termt &rhs, const mp_integer &c);
+
+  /// Add the constraint `term <= c`, where the constant of the term is
+  /// ignored
+  void add_constraint(const termt &term, const mp_integer &c);
+};
+
+class octagon_domain_factoryt
+  : public ai_domain_factoryt<octagon_domaint>
+{
+public:
+  octagon_domain_factoryt(
+    const goto_functionst &goto_functions,
+    const namespacet &ns)
+    : packing(std::make_shared<octagon_packingt>(goto_functions, ns))
+  {
+  }
+
+  std::unique_ptr<statet> make(locationt) const override
+  {
+    auto d = util_make_unique<octagon_domaint>(packing);
+    CHECK_RETURN(d->is_bottom());
+    return std::unique_ptr<statet>(d.release());
+  }
+
+protected:
+  std::shared_ptr<const octagon_packingt> packing;
+};
+
+#endif // CPROVER_ANALYSES_OCTAGON_DOMAIN_H
@@ -0,0 +1,213 @@
+/*******************************************************************\
+
+Module: Octagon Domain
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Difference bound matrices of integer octagons
+
+#include "octagon_matrix.h"
+
+#include <algorithm>
+
+const octagon_matrixt::boundt octagon_matrixt::infinity = std::int64_t{1}
+                                                          << 61;
+const octagon_matrixt::boundt octagon_matrixt::bound_limit = std::int64_t{1}
+                                                             << 58;
+
+/// \p bound, or infinity if it is too large to be stored
+static octagon_matrixt::boundt normalise(octagon_matrixt::boundt bound)
+{
+  return bound >= octagon_matrixt::bound_limit ||
+             bound <= -octagon_matrixt::bound_limit
+           ? octagon_matrixt::infinity
+           : bound;
+}
+
+/// \p bound plus \p offset, where \p offset is finite
+static octagon_matrixt::boundt
+add_offset(octagon_matrixt::boundt bound, octagon_matrixt::boundt offset)
+{
+  return bound == octagon_matrixt::infinity ? bound : normalise(bound + offset);
+}
+
+octagon_matrixt::octagon_matrixt(std::size_t variables)
+  : size(2 * variables), bounds(size * size, infinity)
+{
+  for(std::size_t i = 0; i < size; ++i)
+    at(i, i) = 0;
+}
+
+void octagon_matrixt::add_constraint(std::size_t i, std::size_t j, boundt c)
+{
+  c = normalise(c);
+  if(c == infinity)
+    return;
+
+  at(i, j) = std::min(at(i, j), c);
+  at(bar(j), bar(i)) = std::min(at(bar(j), bar(i)), c);
+}
+
+void octagon_matrixt::add_sum_constraint(
+  std::size_t node_a,
+  std::size_t node_b,
+  boundt c)
+{
+  // a + b is a minus the negation of b
+  add_constraint(bar(node_b), node_a, c);
+}
+
+void octagon_matrixt::forget(std::size_t variable)
+{
+  const std::size_t p = positive(variable);
+  const std::size_t n = negative(variable);
+
+  for(std::size_t k = 0; k < size; ++k)
+  {
+    at(p, k) = infinity;
+    at(n, k) = infinity;
+    at(k, p) = infinity;
+    at(k, n) = infinity;
+  }
+
+  at(p, p) = 0;
+  at(n, n) = 0;
+}
+
+void octagon_matrixt::shift(std::size_t variable, boundt c)
+{
+  const std::size_t p = positive(variable);
+  const std::size_t n = negative(variable);
+
+  for(std::size_t k = 0; k < size; ++k)
+  {
+    at(p, k) = add_offset(at(p, k), -c);
+    at(n, k) = add_offset(at(n, k), c);
+  }
+
+  for(std::size_t k = 0; k < size; ++k)
+  {
+    at(k, p) = add_offset(at(k, p), c);
+    at(k, n) = add_offset(at(k, n), -c);
+  }
+}
+
+void octagon_matrixt::negate(std::size_t variable)
+{
+  const std::size_t p = positive(variable);
+  const std::size_t n = negative(variable);
+
+  for(std::size_t k = 0; k < size; ++k)
+    std::swap(at(p, k), at(n, k));
+
+  for(std::size_t k = 0; k < size; ++k)
+    std::swap(at(k, p), at(k, n));
+}
+
+bool octagon_matrixt::close()
+{
+  // Shortest paths. Rows i and k are distinct, such that the inner loop
+  // neither reads what it writes nor branches.
+  const std::size_t nodes = size;
+  for(std::size_t k = 0; k < nodes; ++k)
+  {
+    const boundt *const row_k = &bounds[k * nodes];
+
+    for(std::size_t i = 0; i < nodes; ++i)
+    {
+      const boundt i_to_k = at(i, k);
+      if(i == k || i_to_k == infinity)
+        continue;
+
+      boundt *const row_i = &bounds[i * nodes];
+      for(std::size_t j = 0; j < nodes; ++j)
+      {
+        const boundt via_k = i_to_k + row_k[j];
+        const boundt bound =
+          via_k >= bound_limit || via_k <= -bound_limit ? infinity : via_k;
+        row_i[j] = std::min(row_i[j], bound);
+      }
+    }
+  }
+
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    if(at(i, i) < 0)
+      return false;
+  }
+
+  // Twice an integer is even
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    boundt &twice = at(i, bar(i));
+    if(twice != infinity)
+      twice -= (twice % 2 + 2) % 2;
+  }
+
+  for(std::size_t i = 0; i < size; i += 2)
+  {
+    const boundt upper = at(i + 1, i);
+    const boundt lower = at(i, i + 1);
+    if(upper != infinity && lower != infinity && upper + lower < 0)
+      return false;
+  }
+
+  // a - b <= (2a - (-2b)) / 2
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    const boundt twice_i = at(i, bar(i));
+    if(twice_i == infinity)
+      continue;
+
+    boundt *const row_i = &bounds[i * size];
+    for(std::size_t j = 0; j < size; ++j)
+    {
+      const boundt twice_j = at(bar(j), j);
+      if(twice_j != infinity)
+        row_i[j] = std::min(row_i[j], (twice_i + twice_j) / 2);
+    }
+  }
+
+  return true;
+}
+
+bool octagon_matrixt::join(const octagon_matrixt &other)
+{
+  bool changed = false;
+  for(std::size_t k = 0; k < bounds.size(); ++k)
+  {
+    const boundt joined = std::max(bounds[k], other.bounds[k]);
+    changed |= joined != bounds[k];
+    bounds[k] = joined;
+  }
+  return changed;
+}
+
+bool octagon_matrixt::widen(const octagon_matrixt &other)
+{
+  bool changed = false;
+  for(std::size_t k = 0; k < bounds.size(); ++k)
+  {
+    const boundt widened =
+      other.bounds[k] > bounds[k] ? infinity : bounds[k];
+    changed |= widened != bounds[k];
+    bounds[k] = widened;
+  }
+  return changed;
+}
+
+bool octagon_matrixt::is_top() const
+{
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    for(std::size_t j = 0; j < size; ++j)
+    {
+      if(i != j && get(i, j) != infinity)
+        return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,137 @@
+/*******************************************************************\
+
+Module: Octagon Domain
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Difference bound matrices of integer octagons
+
+#ifndef CPROVER_ANALYSES_OCTAGON_MATRIX_H
+#define CPROVER_ANALYSES_OCTAGON_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// The constraints of an integer octagon over variables v_0, ..., v_{n-1},
+/// which are of the form ±v_i ± v_j <= c, stored as a dense difference bound
+/// matrix (DBM).
+///
+/// Each variable v_k has two nodes, 2k standing for +v_k and 2k+1 standing
+/// for -v_k, and the entry in row i and column j is an upper bound of the
+/// difference of the values of nodes j and i. For example, v_0 + v_1 <= c is
+/// stored as the bound of node 0 minus node 3. A bound on a single variable,
+/// v_k <= c, is stored doubled, as the bound of node 2k minus node 2k+1.
+///
+/// The matrix is a single row-major array of 64-bit bounds such that the
+/// inner loop of the closure runs over contiguous memory without branches,
+/// which compilers vectorise. Bounds whose absolute value exceeds
+/// \ref bound_limit are dropped, which keeps all sums in the closure free of
+/// overflows.
+class octagon_matrixt
+{
+public:
+  typedef std::int64_t boundt;
+
+  /// The bound of a difference that is unconstrained
+  static const boundt infinity;
+  /// Finite bounds are strictly between -bound_limit and bound_limit
+  static const boundt bound_limit;
+
+  /// The octagon over \p variables variables without any constraints
+  explicit octagon_matrixt(std::size_t variables);
+
+  std::size_t variables() const
+  {
+    return size / 2;
+  }
+
+  static std::size_t positive(std::size_t variable)
+  {
+    return 2 * variable;
+  }
+
+  static std::size_t negative(std::size_t variable)
+  {
+    return 2 * variable + 1;
+  }
+
+  /// The node of the negation of the value of \p node
+  static std::size_t bar(std::size_t node)
+  {
+    return node ^ 1;
+  }
+
+  /// The upper bound of the value of \p node j minus the value of \p node i,
+  /// which is \ref infinity if there is none
+  boundt get(std::size_t i, std::size_t j) const
+  {
+    return bounds[i * size + j];
+  }
+
+  /// Add the constraint that the value of \p node_a plus the value of
+  /// \p node_b is at most \p c. With \p node_a equal to \p node_b this bounds
+  /// twice the value of the node. The matrix has to be closed afterwards.
+  void add_sum_constraint(std::size_t node_a, std::size_t node_b, boundt c);
+
+  /// The upper bound of the value of \p node_a plus the value of \p node_b
+  boundt get_sum_bound(std::size_t node_a, std::size_t node_b) const
+  {
+    return get(bar(node_b), node_a);
+  }
+
+  /// Remove all constraints on \p variable. This keeps the matrix closed.
+  void forget(std::size_t variable);
+
+  /// Replace \p variable by itself plus \p c. This keeps the matrix closed.
+  void shift(std::size_t variable, boundt c);
+
+  /// Replace \p variable by its negation. This keeps the matrix closed.
+  void negate(std::size_t variable);
+
+  /// Compute the tight closure, in which each bound is the best bound
+  /// implied by all constraints on the integers: Floyd-Warshall shortest
+  /// paths, then rounding the bounds of single variables down to even
+  /// numbers, then combining the bounds of single variables into bounds of
+  /// pairs.
+  /// \return False if the octagon contains no integer points
+  bool close();
+
+  /// Replace each bound by the larger of it and the bound in \p other, which
+  /// gives the least octagon that contains both if both are closed.
+  /// \return True if any bound changed
+  bool join(const octagon_matrixt &other);
+
+  /// Like \ref join, but drop each bound that \p other exceeds, which
+  /// guarantees that repeated widening terminates. The result is not closed.
+  /// \return True if any bound changed
+  bool widen(const octagon_matrixt &other);
+
+  /// Whether there are no constraints
+  bool is_top() const;
+
+  bool operator==(const octagon_matrixt &other) const
+  {
+    return bounds == other.bounds;
+  }
+
+protected:
+  /// The number of nodes, twice the number of variables
+  std::size_t size;
+  /// The size * size bounds, row by row
+  std::vector<boundt> bounds;
+
+  boundt &at(std::size_t i, std::size_t j)
+  {
+    return bounds[i * size + j];
+  }
+
+  /// Add the bound \p c to the value of node j minus the value of node i,
+  /// and the same bound to its coherent counterpart
+  void add_constraint(std::size_t i, std::size_t j, boundt c);
+};
+
+#endif // CPROVER_ANALYSES_OCTAGON_MATRIX_H
@@ -24,6 +24,7 @@ Date: February 2013
 #include "dirty.h"
 #include "is_threaded.h"
 
+#include <algorithm>
 #include <memory>
 
 /// This ensures that all domains are constructed with the appropriate pointer
@@ -72,14 +73,13 @@ void rd_range_domaint::populate_cache(const irep_idt &identifier) const
 {
   PRECONDITION(bv_container);
 
-  valuest::const_iterator v_entry=values.find(identifier);
-  if(v_entry==values.end() ||
-     v_entry->second.empty())
+  const auto v_entry = values.find(identifier);
+  if(!v_entry.has_value() || v_entry->get().empty())
     return;
 
   ranges_at_loct &export_entry=export_cache[identifier];
 
-  for(const auto &id : v_entry->second)
+  for(const auto &id : v_entry->get())
   {
     const reaching_definitiont &v=bv_container->get(id);
 
@@ -139,37 +139,24 @@ void rd_range_domaint::transform_dead(
 {
   const irep_idt &identifier = from->dead_symbol().get_identifier();
 
-  valuest::iterator entry=values.find(identifier);
-
-  if(entry!=values.end())
-  {
-    values.erase(entry);
-    export_cache.erase(identifier);
-  }
+  values.erase_if_exists(identifier);
+  export_cache.erase(identifier);
 }
 
 void rd_range_domaint::transform_start_thread(
   const namespacet &ns,
   reaching_definitions_analysist &rd)
 {
-  for(valuest::iterator it=values.begin();
-      it!=values.end();
-      ) // no ++it
-  {
-    const irep_idt &identifier=it->first;
+  std::vector<irep_idt> thread_local_identifiers;
+  values.iterate([&](const irep_idt &identifier, const values_innert &) {
+    if(!ns.lookup(identifier).is_shared() && !rd.get_is_dirty()(identifier))
+      thread_local_identifiers.push_back(identifier);
+  });
 
-    if(!ns.lookup(identifier).is_shared() &&
-       !rd.get_is_dirty()(identifier))
-    {
-      export_cache.erase(identifier);
-
-      valuest::iterator next=it;
-      ++next;
-      values.erase(it);
-      it=next;
-    }
-    else
-      ++it;
+  for(const irep_idt &identifier : thread_local_identifiers)
+  {
+    values.erase(identifier);
+    export_cache.erase(identifier);
   }
 }
 
@@ -184,27 +171,22 @@ void rd_range_domaint::transform_function_call(
   const symbol_exprt &fn_symbol_expr = to_symbol_expr(from->call_function());
   if(function_to == fn_symbol_expr.get_identifier())
   {
-    for(valuest::iterator it=values.begin();
-        it!=values.end();
-       ) // no ++it
-    {
-      const irep_idt &identifier=it->first;
-
+    std::vector<irep_idt> local_identifiers;
+    values.iterate([&](const irep_idt &identifier, const values_innert &) {
       // dereferencing may introduce extra symbols
       const symbolt *sym;
-      if((ns.lookup(identifier, sym) ||
-          !sym->is_shared()) &&
-         !rd.get_is_dirty()(identifier))
+      if(
+        (ns.lookup(identifier, sym) || !sym->is_shared()) &&
+        !rd.get_is_dirty()(identifier))
       {
-        export_cache.erase(identifier);
-
-        valuest::iterator next=it;
-        ++next;
-        values.erase(it);
-        it=next;
+        local_identifiers.push_back(identifier);
       }
-      else
-        ++it;
+    });
+
+    for(const irep_idt &identifier : local_identifiers)
+    {
+      values.erase(identifier);
+      export_cache.erase(identifier);
     }
 
     const code_typet &code_type=
@@ -253,27 +235,26 @@ void rd_range_domaint::transform_end_function(
   new_values.swap(values);
   values=rd[call].values;
 
-  for(const auto &new_value : new_values)
-  {
-    const irep_idt &identifier=new_value.first;
-
-    if(!rd.get_is_threaded()(call) ||
-       (!ns.lookup(identifier).is_shared() &&
-        !rd.get_is_dirty()(identifier)))
-    {
-      for(const auto &id : new_value.second)
+  new_values.iterate(
+    [&](const irep_idt &identifier, const values_innert &new_value) {
+      if(
+        !rd.get_is_threaded()(call) ||
+        (!ns.lookup(identifier).is_shared() &&
+         !rd.get_is_dirty()(identifier)))
       {
-        const reaching_definitiont &v=bv_container->get(id);
-        kill(v.identifier, v.bit_begin, v.bit_end);
+        for(const auto &id : new_value)
+        {
+          const reaching_definitiont &v = bv_container->get(id);
+          kill(v.identifier, v.bit_begin, v.bit_end);
+        }
       }
-    }
 
-    for(const auto &id : new_value.second)
-    {
-      const reaching_definitiont &v=bv_container->get(id);
-      gen(v.definition_at, v.identifier, v.bit_begin, v.bit_end);
-    }
-  }
+      for(const auto &id : new_value)
+      {
+        const reaching_definitiont &v = bv_container->get(id);
+        gen(v.definition_at, v.identifier, v.bit_begin, v.bit_end);
+      }
+    });
 
   const code_typet &code_type = to_code_type(ns.lookup(function_from).type);
 
@@ -284,13 +265,8 @@ void rd_range_domaint::transform_end_function(
     if(identifier.empty())
       continue;
 
-    valuest::iterator entry=values.find(identifier);
-
-    if(entry!=values.end())
-    {
-      values.erase(entry);
-      export_cache.erase(identifier);
-    }
+    values.erase_if_exists(identifier);
+    export_cache.erase(identifier);
   }
 
   // handle return values
@@ -353,47 +329,41 @@ void rd_range_domaint::kill(
 
   PRECONDITION(range_end > range_start);
 
-  valuest::iterator entry=values.find(identifier);
-  if(entry==values.end())
+  const auto entry = values.find(identifier);
+  if(!entry.has_value())
     return;
 
-  bool clear_export_cache=false;
+  bool changed = false;
+  values_innert kept_values;
   values_innert new_values;
 
-  for(values_innert::iterator
-      it=entry->second.begin();
-      it!=entry->second.end();
-     ) // no ++it
+  for(const auto &id : entry->get())
   {
-    const reaching_definitiont &v=bv_container->get(*it);
+    const reaching_definitiont &v=bv_container->get(id);
 
     if(v.bit_begin >= range_end)
-      ++it;
+      kept_values.push_back(id);
     else if(!v.bit_end.is_unknown() && v.bit_end <= range_start)
     {
-      ++it;
+      kept_values.push_back(id);
     }
     else if(
       v.bit_begin >= range_start && !v.bit_end.is_unknown() &&
       v.bit_end <= range_end) // rs <= a < b <= re
     {
-      clear_export_cache=true;
-
-      entry->second.erase(it++);
+      changed = true;
     }
     else if(v.bit_begin >= range_start) // rs <= a <= re < b
     {
-      clear_export_cache=true;
+      changed = true;
 
       reaching_definitiont v_new=v;
       v_new.bit_begin=range_end;
-      new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
+      new_values.push_back(bv_container->add(v_new));
     }
     else if(v.bit_end.is_unknown() || v.bit_end > range_end) // a <= rs < re < b
     {
-      clear_export_cache=true;
+      changed = true;
 
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
@@ -401,41 +371,29 @@ void rd_range_domaint::kill(
       reaching_definitiont v_new2=v;
       v_new2.bit_begin=range_end;
 
-      new_values.insert(bv_container->add(v_new));
-      new_values.insert(bv_container->add(v_new2));
-
-      entry->second.erase(it++);
+      new_values.push_back(bv_container->add(v_new));
+      new_values.push_back(bv_container->add(v_new2));
     }
     else // a <= rs < b <= re
     {
-      clear_export_cache=true;
+      changed = true;
 
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
-      new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
+      new_values.push_back(bv_container->add(v_new));
     }
   }
 
-  if(clear_export_cache)
-    export_cache.erase(identifier);
+  if(!changed)
+    return;
 
-  values_innert::iterator it=entry->second.begin();
-  for(const auto &id : new_values)
-  {
-    while(it!=entry->second.end() && *it<id)
-      ++it;
-    if(it==entry->second.end() || id<*it)
-    {
-      entry->second.insert(it, id);
-    }
-    else if(it!=entry->second.end())
-    {
-      DATA_INVARIANT(*it == id, "entries must match");
-      ++it;
-    }
-  }
+  std::sort(new_values.begin(), new_values.end());
+  new_values.erase(
+    std::unique(new_values.begin(), new_values.end()), new_values.end());
+  merge_inner(kept_values, new_values);
+
+  values.replace(identifier, std::move(kept_values));
+  export_cache.erase(identifier);
 }
 
 void rd_range_domaint::kill_inf(
@@ -490,8 +448,19 @@ bool rd_range_domaint::gen(
   PRECONDITION(range_end == range_spect::unknown() || range_end > range_start);
 
   reaching_definitiont v{identifier, from, range_start, range_end};
-  if(!values[identifier].insert(bv_container->add(v)).second)
+  const std::size_t id = bv_container->add(v);
+
+  const auto entry = values.find(identifier);
+  if(!entry.has_value())
+    values.insert(identifier, values_innert{id});
+  else if(std::binary_search(entry->get().begin(), entry->get().end(), id))
     return false;
+  else
+  {
+    values.update(identifier, [id](values_innert &ids) {
+      ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+    });
+  }
 
   export_cache.erase(identifier);
 
@@ -551,7 +520,7 @@ void rd_range_domaint::output(std::ostream &out) const
     return;
   }
 
-  for(const auto &value : values)
+  for(const auto &value : values.get_sorted_view())
   {
     const irep_idt &identifier=value.first;
 
@@ -585,50 +554,20 @@ bool rd_range_domaint::merge_inner(
   values_innert &dest,
   const values_innert &other)
 {
-  bool more=false;
-
-#if 0
-  ranges_at_loct::iterator itr=it->second.begin();
-  for(const auto &o : ito->second)
-  {
-    while(itr!=it->second.end() && itr->first<o.first)
-      ++itr;
-    if(itr==it->second.end() || o.first<itr->first)
-    {
-      it->second.insert(o);
-      more=true;
-    }
-    else if(itr!=it->second.end())
-    {
-      assert(itr->first==o.first);
-
-      for(const auto &o_range : o.second)
-        more=gen(itr->second, o_range.first, o_range.second) ||
-          more;
-
-      ++itr;
-    }
-  }
-#else
-  values_innert::iterator itr=dest.begin();
-  for(const auto &id : other)
-  {
-    while(itr!=dest.end() && *itr<id)
-      ++itr;
-    if(itr==dest.end() || id<*itr)
-    {
-      dest.insert(itr, id);
-      more=true;
-    }
-    else if(itr!=dest.end())
-    {
-      DATA_INVARIANT(*itr == id, "entries must match");
-      ++itr;
-    }
-  }
-#endif
+  values_innert result;
+  result.reserve(dest.size() + other.size());
+  std::set_union(
+    dest.begin(),
+    dest.end(),
+    other.begin(),
+    other.end(),
+    std::back_inserter(result));
+
+  if(result.size() == dest.size())
+    return false;
 
-  return more;
+  dest.swap(result);
+  return true;
 }
 
 bool rd_range_domaint::merge(
@@ -639,27 +578,25 @@ bool rd_range_domaint::merge(
   bool changed=has_values.is_false();
   has_values=tvt::unknown();
 
-  valuest::iterator it=values.begin();
-  for(const auto &value : other.values)
+  valuest::delta_viewt delta_view;
+  other.values.get_delta_view(values, delta_view, false);
+
+  for(const auto &delta_entry : delta_view)
   {
-    while(it!=values.end() && it->first<value.first)
-      ++it;
-    if(it==values.end() || value.first<it->first)
+    if(!delta_entry.is_in_both_maps())
     {
-      values.insert(value);
+      values.insert(delta_entry.k, delta_entry.m);
       changed=true;
     }
-    else if(it!=values.end())
+    else
     {
-      DATA_INVARIANT(it->first == value.first, "entries must match");
-
-      if(merge_inner(it->second, value.second))
+      values_innert merged = delta_entry.get_other_map_value();
+      if(merge_inner(merged, delta_entry.m))
       {
         changed=true;
-        export_cache.erase(it->first);
+        export_cache.erase(delta_entry.k);
+        values.replace(delta_entry.k, std::move(merged));
       }
-
-      ++it;
     }
   }
 
@@ -683,33 +620,31 @@ bool rd_range_domaint::merge_shared(
   bool changed=has_values.is_false();
   has_values=tvt::unknown();
 
-  valuest::iterator it=values.begin();
-  for(const auto &value : other.values)
+  valuest::delta_viewt delta_view;
+  other.values.get_delta_view(values, delta_view, false);
+
+  for(const auto &delta_entry : delta_view)
   {
-    const irep_idt &identifier=value.first;
+    const irep_idt &identifier = delta_entry.k;
 
     if(!ns.lookup(identifier).is_shared()
        /*&& !rd.get_is_dirty()(identifier)*/)
       continue;
 
-    while(it!=values.end() && it->first<value.first)
-      ++it;
-    if(it==values.end() || value.first<it->first)
+    if(!delta_entry.is_in_both_maps())
     {
-      values.insert(value);
+      values.insert(identifier, delta_entry.m);
       changed=true;
     }
-    else if(it!=values.end())
+    else
     {
-      DATA_INVARIANT(it->first == value.first, "entries must match");
-
-      if(merge_inner(it->second, value.second))
+      values_innert merged = delta_entry.get_other_map_value();
+      if(merge_inner(merged, delta_entry.m))
       {
         changed=true;
-        export_cache.erase(it->first);
+        export_cache.erase(identifier);
+        values.replace(identifier, std::move(merged));
       }
-
-      ++it;
     }
   }
 
@@ -25,6 +25,7 @@ Date: February 2013
 #ifndef CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 #define CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 
+#include <util/sharing_map.h>
 #include <util/threeval.h>
 
 #include "ai.h"
@@ -233,7 +234,8 @@ class rd_range_domaint:public ai_domain_baset
   /// resulting map are the union of variable names in both `this->values` and
   /// `other.values`. For each variable `v` appearing in both maps
   /// `this->values` and `other.values` the resulting mapped set of identifiers
-  /// is the set union of `this->values[v]` and `other.values[v]`.
+  /// is the set union of `this->values[v]` and `other.values[v]`. Entries that
+  /// the two maps share are skipped.
   /// Note that the operation actually does not produce a new `join` element.
   /// The instance `*this` is modified to become the `join` element.
   /// \param other: The instance to be merged into `*this` as the join operation
@@ -273,17 +275,17 @@ class rd_range_domaint:public ai_domain_baset
   /// `this` is passed to `set_bitvector_container` for all instances.
   sparse_bitvector_analysist<reaching_definitiont> *const bv_container;
 
-  typedef std::set<std::size_t> values_innert;
-  #ifdef USE_DSTRING
-  typedef std::map<irep_idt, values_innert> valuest;
-  #else
-  typedef std::unordered_map<irep_idt, values_innert> valuest;
-  #endif
-  /// It is an ordered map from program variable names to `ID`s of
+  /// Sorted `ID`s of `reaching_definitiont` instances. A sorted vector takes a
+  /// fraction of the memory of a `std::set` and the sets are typically small.
+  typedef std::vector<std::size_t> values_innert;
+  typedef sharing_mapt<irep_idt, values_innert> valuest;
+  /// It is a map from program variable names to `ID`s of
   /// `reaching_definitiont` instances stored in map pointed to by
   /// `bv_container`. The map is not empty only if `has_value` is `UNKNOWN`.
   /// Variables in the map are all those which are live at the associated
-  /// instruction.
+  /// instruction. The map shares the entries of variables that are not
+  /// written between two instructions, which keeps copies of domains cheap
+  /// and lets `merge` visit only the entries that differ.
   valuest values;
 
   #ifdef USE_DSTRING
@@ -140,11 +140,8 @@ void sese_region_analysist::compute_sese_regions(
       (*successors.begin())->incoming_edges.size() == 1)
       continue;
 
-    const auto &instruction_postdoms = postdominators.get_node(it).dominators;
-
-    // Ideally we would start with the immediate postdominator and walk down,
-    // but our current dominator analysis doesn't make it easy to determine an
-    // immediate dominator.
+    const auto instruction_postdoms =
+      postdominators.get_dominators(postdominators.get_node(it));
 
     // Ideally I would use `optionalt<std::size_t>` here, but it triggers a
     // GCC-5 bug.
@@ -154,7 +151,7 @@ void sese_region_analysist::compute_sese_regions(
       const auto possible_exit_index = dominators.get_node_index(possible_exit);
       const auto &possible_exit_node = dominators.cfg[possible_exit_index];
       const auto possible_exit_dominators =
-        possible_exit_node.dominators.size();
+        possible_exit_node.number_of_dominators;
 
       if(
         it != possible_exit && dominators.dominates(it, possible_exit_node) &&
@@ -165,7 +162,7 @@ void sese_region_analysist::compute_sese_regions(
         // the least dominators, i.e. the closest to the region entrance.
         if(
           closest_exit_index == dominators.cfg.size() ||
-          dominators.cfg[closest_exit_index].dominators.size() >
+          dominators.cfg[closest_exit_index].number_of_dominators >
             possible_exit_dominators)
         {
           closest_exit_index = possible_exit_index;
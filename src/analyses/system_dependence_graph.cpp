@@ -0,0 +1,805 @@
+/*******************************************************************\
+
+Module: System Dependence Graph
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// A dependence graph for a whole program, built from def-use chains in SSA
+/// form and post-dominator trees of each function
+
+#include "system_dependence_graph.h"
+
+#include <util/byte_operators.h>
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+#include <util/pointer_expr.h>
+#include <util/version.h>
+
+#include <goto-programs/remove_returns.h>
+
+#include "dirty.h"
+
+#include <algorithm>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+/// The objects an instruction reads and writes
+struct sdg_accessest
+{
+  /// Variables read
+  std::vector<irep_idt> reads;
+  /// Variables written, and whether all of the variable is written
+  std::vector<std::pair<irep_idt, bool>> writes;
+  /// Objects that are not variables of the function, such as the parameters
+  /// of a callee
+  std::vector<irep_idt> object_reads;
+  std::vector<irep_idt> object_writes;
+  bool reads_memory = false;
+  bool writes_memory = false;
+};
+
+static void get_reads(const exprt &expr, sdg_accessest &dest);
+
+/// Collect the reads in computing the address of \p expr
+static void get_address_reads(const exprt &expr, sdg_accessest &dest)
+{
+  if(expr.id() == ID_symbol)
+    return;
+  else if(expr.id() == ID_member)
+    get_address_reads(to_member_expr(expr).struct_op(), dest);
+  else if(expr.id() == ID_index)
+  {
+    get_address_reads(to_index_expr(expr).array(), dest);
+    get_reads(to_index_expr(expr).index(), dest);
+  }
+  else if(expr.id() == ID_dereference)
+    get_reads(to_dereference_expr(expr).pointer(), dest);
+  else if(expr.id() == ID_typecast)
+    get_address_reads(to_typecast_expr(expr).op(), dest);
+  else if(expr.id() == ID_if)
+  {
+    get_reads(to_if_expr(expr).cond(), dest);
+    get_address_reads(to_if_expr(expr).true_case(), dest);
+    get_address_reads(to_if_expr(expr).false_case(), dest);
+  }
+  else
+    get_reads(expr, dest);
+}
+
+static void get_reads(const exprt &expr, sdg_accessest &dest)
+{
+  if(expr.id() == ID_symbol)
+  {
+    if(expr.type().id() != ID_code)
+      dest.reads.push_back(to_symbol_expr(expr).get_identifier());
+  }
+  else if(expr.id() == ID_dereference)
+  {
+    get_reads(to_dereference_expr(expr).pointer(), dest);
+    dest.reads_memory = true;
+  }
+  else if(expr.id() == ID_address_of)
+    get_address_reads(to_address_of_expr(expr).object(), dest);
+  else
+  {
+    for(const auto &op : expr.operands())
+      get_reads(op, dest);
+  }
+}
+
+/// Collect the writes to \p lhs and the reads in computing its address
+/// \param lhs: The expression written to
+/// \param strong: False if only part of \p lhs may be written
+/// \param dest: Where to add the accesses
+static void get_writes(const exprt &lhs, bool strong, sdg_accessest &dest)
+{
+  if(lhs.id() == ID_symbol)
+    dest.writes.emplace_back(to_symbol_expr(lhs).get_identifier(), strong);
+  else if(lhs.id() == ID_member)
+    get_writes(to_member_expr(lhs).struct_op(), false, dest);
+  else if(lhs.id() == ID_index)
+  {
+    get_reads(to_index_expr(lhs).index(), dest);
+    get_writes(to_index_expr(lhs).array(), false, dest);
+  }
+  else if(
+    lhs.id() == ID_byte_extract_little_endian ||
+    lhs.id() == ID_byte_extract_big_endian)
+  {
+    get_reads(to_byte_extract_expr(lhs).offset(), dest);
+    get_writes(to_byte_extract_expr(lhs).op(), false, dest);
+  }
+  else if(lhs.id() == ID_typecast)
+    get_writes(to_typecast_expr(lhs).op(), strong, dest);
+  else if(lhs.id() == ID_if)
+  {
+    get_reads(to_if_expr(lhs).cond(), dest);
+    get_writes(to_if_expr(lhs).true_case(), false, dest);
+    get_writes(to_if_expr(lhs).false_case(), false, dest);
+  }
+  else if(lhs.id() == ID_dereference)
+  {
+    get_reads(to_dereference_expr(lhs).pointer(), dest);
+    dest.writes_memory = true;
+  }
+  else
+  {
+    get_reads(lhs, dest);
+    dest.writes_memory = true;
+  }
+}
+
+/// Add the parameters and the return value of \p callee to \p dest
+static void get_call_accesses(
+  const irep_idt &callee,
+  const goto_functionst::goto_functiont &goto_function,
+  bool has_lhs,
+  sdg_accessest &dest)
+{
+  for(const auto &parameter : goto_function.parameter_identifiers)
+  {
+    if(!parameter.empty())
+      dest.object_writes.push_back(parameter);
+  }
+
+  if(has_lhs)
+    dest.object_reads.push_back(return_value_identifier(callee));
+}
+
+static sdg_accessest get_accesses(
+  const irep_idt &function_id,
+  const goto_programt::instructiont &instruction,
+  const goto_functionst &goto_functions)
+{
+  sdg_accessest accesses;
+
+  switch(instruction.type())
+  {
+  case ASSIGN:
+    get_writes(instruction.assign_lhs(), true, accesses);
+    get_reads(instruction.assign_rhs(), accesses);
+    break;
+
+  case DECL:
+    get_writes(instruction.decl_symbol(), true, accesses);
+    break;
+
+  case DEAD:
+    get_writes(instruction.dead_symbol(), true, accesses);
+    break;
+
+  case GOTO:
+  case ASSUME:
+  case ASSERT:
+    get_reads(instruction.condition(), accesses);
+    break;
+
+  case SET_RETURN_VALUE:
+    get_reads(instruction.return_value(), accesses);
+    accesses.object_writes.push_back(return_value_identifier(function_id));
+    break;
+
+  case FUNCTION_CALL:
+  {
+    const exprt &function = instruction.call_function();
+    const exprt &lhs = instruction.call_lhs();
+
+    get_reads(function, accesses);
+    for(const auto &argument : instruction.call_arguments())
+      get_reads(argument, accesses);
+    if(lhs.is_not_nil())
+      get_writes(lhs, true, accesses);
+
+    if(function.id() == ID_symbol)
+    {
+      const irep_idt &callee = to_symbol_expr(function).get_identifier();
+      const auto entry = goto_functions.function_map.find(callee);
+      if(
+        entry != goto_functions.function_map.end() &&
+        entry->second.body_available())
+      {
+        get_call_accesses(callee, entry->second, lhs.is_not_nil(), accesses);
+      }
+    }
+    else
+    {
+      // Any function taking this many arguments may be called
+      for(const auto &gf_entry : goto_functions.function_map)
+      {
+        if(
+          gf_entry.second.body_available() &&
+          gf_entry.second.parameter_identifiers.size() ==
+            instruction.call_arguments().size())
+        {
+          get_call_accesses(
+            gf_entry.first, gf_entry.second, lhs.is_not_nil(), accesses);
+        }
+      }
+    }
+    break;
+  }
+
+  case OTHER:
+  {
+    const codet &code = instruction.get_other();
+    for(const auto &op : code.operands())
+      get_reads(op, accesses);
+
+    const irep_idt &statement = code.get_statement();
+    if(
+      statement == ID_array_copy || statement == ID_array_replace ||
+      statement == ID_array_set || statement == ID_havoc_object)
+    {
+      accesses.writes_memory = true;
+    }
+    break;
+  }
+
+  case END_FUNCTION:
+  case SKIP:
+  case LOCATION:
+  case START_THREAD:
+  case END_THREAD:
+  case ATOMIC_BEGIN:
+  case ATOMIC_END:
+  case THROW:
+  case CATCH:
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    break;
+  }
+
+  return accesses;
+}
+
+const irep_idt &system_dependence_grapht::memory_object()
+{
+  static const irep_idt memory = "system_dependence_graph::memory";
+  return memory;
+}
+
+void system_dependence_grapht::operator()(const goto_functionst &goto_functions)
+{
+  unsigned max_location_number = 0;
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    for(const auto &instruction : gf_entry.second.body.instructions)
+      max_location_number =
+        std::max(max_location_number, instruction.location_number);
+  }
+
+  instruction_nodes.resize(
+    max_location_number + 1, std::numeric_limits<node_indext>::max());
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    forall_goto_program_instructions(it, gf_entry.second.body)
+    {
+      node_indext &node = instruction_nodes[it->location_number];
+      INVARIANT(
+        node == std::numeric_limits<node_indext>::max(),
+        "location numbers should be unique");
+      node = add_node();
+      nodes[node].PC = it;
+    }
+  }
+
+  const dirtyt dirty(goto_functions);
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(!gf_entry.second.body.instructions.empty())
+      add_function(gf_entry.first, gf_entry.second, goto_functions, dirty);
+  }
+}
+
+system_dependence_grapht::node_indext
+system_dependence_grapht::object_node(const irep_idt &identifier)
+{
+  auto entry = object_nodes.emplace(identifier, 0);
+  if(entry.second)
+  {
+    entry.first->second = add_node();
+    nodes[entry.first->second].kind = sdg_nodet::kindt::OBJECT;
+    nodes[entry.first->second].object = identifier;
+  }
+  return entry.first->second;
+}
+
+void system_dependence_grapht::add_function(
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &goto_function,
+  const goto_functionst &goto_functions,
+  const dirtyt &dirty)
+{
+  const goto_programt &body = goto_function.body;
+
+  cfg_post_dominatorst &post_dominators_of_function =
+    post_dominators[function_id];
+  post_dominators_of_function(body);
+  add_control_dependencies(post_dominators_of_function);
+
+  cfg_dominatorst dominators;
+  dominators(body);
+  const cfg_dominatorst::cfgt &cfg = dominators.cfg;
+  const std::size_t size = cfg.size();
+  const std::size_t none = std::numeric_limits<std::size_t>::max();
+
+  // Local variables whose address is never taken are tracked flow-sensitively
+  std::unordered_map<irep_idt, std::size_t> variables;
+  for(const auto &parameter : goto_function.parameter_identifiers)
+  {
+    if(!parameter.empty() && !dirty(parameter))
+      variables.emplace(parameter, variables.size());
+  }
+  for(const auto &instruction : body.instructions)
+  {
+    if(instruction.is_decl() && !dirty(instruction.decl_symbol()))
+      variables.emplace(
+        instruction.decl_symbol().get_identifier(), variables.size());
+  }
+
+  const auto node_of_object = [this, &dirty](const irep_idt &identifier) {
+    return dirty(identifier) ? object_node(memory_object())
+                             : object_node(identifier);
+  };
+
+  // Accesses to all other objects are flow-insensitive; the definition sites
+  // of tracked variables are needed to place join nodes
+  std::vector<sdg_accessest> accesses;
+  accesses.reserve(size);
+  std::vector<std::vector<std::size_t>> definitions(variables.size());
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    accesses.push_back(
+      get_accesses(function_id, *cfg[i].PC, goto_functions));
+    const sdg_accessest &access = accesses.back();
+    const node_indext node = instruction_node(cfg[i].PC);
+
+    for(const auto &read : access.reads)
+    {
+      if(variables.find(read) == variables.end())
+        add_dependency(node_of_object(read), node);
+    }
+    for(const auto &write : access.writes)
+    {
+      const auto variable = variables.find(write.first);
+      if(variable == variables.end())
+        add_dependency(node, node_of_object(write.first));
+      else
+        definitions[variable->second].push_back(i);
+    }
+    for(const auto &object : access.object_reads)
+      add_dependency(node_of_object(object), node);
+    for(const auto &object : access.object_writes)
+      add_dependency(node, node_of_object(object));
+    if(access.reads_memory)
+      add_dependency(object_node(memory_object()), node);
+    if(access.writes_memory)
+      add_dependency(node, object_node(memory_object()));
+  }
+
+  // The values of parameters are defined on entry to the function
+  const std::size_t entry = cfg.get_node_index(body.instructions.begin());
+  for(const auto &parameter : goto_function.parameter_identifiers)
+  {
+    const auto variable = variables.find(parameter);
+    if(variable != variables.end())
+      definitions[variable->second].push_back(entry);
+  }
+
+  // Dominance frontiers, following "A Simple, Fast Dominance Algorithm" by
+  // Cooper, Harvey and Kennedy
+  std::vector<std::vector<std::size_t>> frontiers(size);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    const auto &node = cfg[i];
+    if(node.in.size() < 2 || !dominators.program_point_reachable(node))
+      continue;
+
+    for(const auto &edge : node.in)
+    {
+      if(!dominators.program_point_reachable(cfg[edge.first]))
+        continue;
+
+      for(optionalt<std::size_t> runner = edge.first;
+          runner.has_value() && runner != node.immediate_dominator;
+          runner = cfg[*runner].immediate_dominator)
+      {
+        if(frontiers[*runner].empty() || frontiers[*runner].back() != i)
+          frontiers[*runner].push_back(i);
+      }
+    }
+  }
+
+  // Place join nodes at the iterated dominance frontiers of the definitions
+  std::vector<std::vector<std::pair<std::size_t, node_indext>>> joins(size);
+  std::vector<std::size_t> has_join(size, none);
+  std::vector<std::size_t> queued(size, none);
+  for(std::size_t variable = 0; variable < definitions.size(); ++variable)
+  {
+    std::vector<std::size_t> worklist;
+    for(const std::size_t i : definitions[variable])
+    {
+      if(queued[i] != variable)
+      {
+        queued[i] = variable;
+        worklist.push_back(i);
+      }
+    }
+
+    while(!worklist.empty())
+    {
+      const std::size_t i = worklist.back();
+      worklist.pop_back();
+
+      for(const std::size_t frontier : frontiers[i])
+      {
+        if(has_join[frontier] == variable)
+          continue;
+        has_join[frontier] = variable;
+
+        const node_indext join = add_node();
+        nodes[join].kind = sdg_nodet::kindt::JOIN;
+        nodes[join].PC = cfg[frontier].PC;
+        joins[frontier].emplace_back(variable, join);
+
+        if(queued[frontier] != variable)
+        {
+          queued[frontier] = variable;
+          worklist.push_back(frontier);
+        }
+      }
+    }
+  }
+
+  // Link uses to definitions by walking the dominator tree, keeping a stack of
+  // the reaching definitions of each variable
+  std::vector<std::vector<std::size_t>> children(size);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    if(cfg[i].immediate_dominator.has_value())
+      children[*cfg[i].immediate_dominator].push_back(i);
+  }
+
+  std::vector<std::vector<node_indext>> reaching(variables.size());
+  for(const auto &parameter : goto_function.parameter_identifiers)
+  {
+    const auto variable = variables.find(parameter);
+    if(variable != variables.end())
+      reaching[variable->second].push_back(object_node(parameter));
+  }
+
+  // Variables that definitions were pushed for, to undo when leaving a node
+  std::vector<std::size_t> pushed;
+
+  struct framet
+  {
+    std::size_t node;
+    std::size_t next_child;
+    std::size_t pushed_size;
+  };
+  std::vector<framet> stack;
+  if(dominators.program_point_reachable(cfg[entry]))
+    stack.push_back({entry, 0, 0});
+  bool entering = true;
+
+  while(!stack.empty())
+  {
+    framet &frame = stack.back();
+    const std::size_t i = frame.node;
+
+    if(entering)
+    {
+      frame.pushed_size = pushed.size();
+      const node_indext node = instruction_node(cfg[i].PC);
+
+      for(const auto &join : joins[i])
+      {
+        reaching[join.first].push_back(join.second);
+        pushed.push_back(join.first);
+      }
+
+      for(const auto &read : accesses[i].reads)
+      {
+        const auto variable = variables.find(read);
+        if(variable != variables.end() && !reaching[variable->second].empty())
+          add_dependency(reaching[variable->second].back(), node);
+      }
+
+      for(const auto &write : accesses[i].writes)
+      {
+        const auto variable = variables.find(write.first);
+        if(variable == variables.end())
+          continue;
+
+        auto &definitions_of_variable = reaching[variable->second];
+        if(!write.second && !definitions_of_variable.empty())
+          add_dependency(definitions_of_variable.back(), node);
+        definitions_of_variable.push_back(node);
+        pushed.push_back(variable->second);
+      }
+
+      for(const auto &edge : cfg[i].out)
+      {
+        for(const auto &join : joins[edge.first])
+        {
+          if(!reaching[join.first].empty())
+            add_dependency(reaching[join.first].back(), join.second);
+        }
+      }
+    }
+
+    if(frame.next_child < children[i].size())
+    {
+      const std::size_t child = children[i][frame.next_child];
+      ++frame.next_child;
+      stack.push_back({child, 0, 0});
+      entering = true;
+      continue;
+    }
+
+    while(pushed.size() > frame.pushed_size)
+    {
+      reaching[pushed.back()].pop_back();
+      pushed.pop_back();
+    }
+    stack.pop_back();
+    entering = false;
+  }
+}
+
+/// Add control dependencies following Ferrante, Ottenstein and Warren: the
+/// nodes that are control dependent on a branch are those on the path from
+/// each of its successors to its immediate post-dominator in the
+/// post-dominator tree.
+void system_dependence_grapht::add_control_dependencies(
+  const cfg_post_dominatorst &post_dominators_of_function)
+{
+  const cfg_post_dominatorst::cfgt &cfg = post_dominators_of_function.cfg;
+
+  for(std::size_t i = 0; i < cfg.size(); ++i)
+  {
+    const auto &node = cfg[i];
+    const bool is_assume = node.PC->is_assume();
+    if(!is_assume && !(node.PC->is_goto() && node.out.size() >= 2))
+      continue;
+
+    // Instructions that post-dominate an assumption depend on it, hence walk
+    // all the way up the tree for those
+    const optionalt<std::size_t> stop =
+      is_assume ? optionalt<std::size_t>{} : node.immediate_dominator;
+    const node_indext dependency = instruction_node(node.PC);
+
+    for(const auto &edge : node.out)
+    {
+      for(optionalt<std::size_t> runner = edge.first;
+          runner.has_value() && runner != stop &&
+          post_dominators_of_function.program_point_reachable(cfg[*runner]);
+          runner = cfg[*runner].immediate_dominator)
+      {
+        add_dependency(dependency, instruction_node(cfg[*runner].PC));
+      }
+    }
+  }
+}
+
+/// Must be changed whenever the format of the files or the way the graph is
+/// computed changes
+static const std::size_t sdg_file_version = 1;
+
+/// Everything about \p functions that the graph depends on, to tell whether
+/// a stored graph was computed for the same program
+static irept program_description(
+  const std::vector<goto_functionst::function_mapt::const_iterator> &functions)
+{
+  irept result;
+  result.set("version", CBMC_VERSION);
+  irept::subt &function_descriptions = result.add("functions").get_sub();
+
+  for(const auto &function : functions)
+  {
+    function_descriptions.emplace_back(function->first);
+    irept &function_description = function_descriptions.back();
+
+    irept::subt &parameters = function_description.add("parameters").get_sub();
+    for(const auto &parameter : function->second.parameter_identifiers)
+      parameters.emplace_back(parameter);
+
+    const goto_programt &body = function->second.body;
+    std::unordered_map<unsigned, std::size_t> indices;
+    for(const auto &instruction : body.instructions)
+      indices.emplace(instruction.location_number, indices.size());
+
+    irept::subt &instructions =
+      function_description.add("instructions").get_sub();
+    for(const auto &instruction : body.instructions)
+    {
+      irept description;
+      description.set(ID_type, static_cast<long long>(instruction.type()));
+      description.add(ID_code, instruction.code());
+      if(instruction.has_condition())
+        description.add("condition", instruction.condition());
+
+      irept::subt &targets = description.add("targets").get_sub();
+      for(const auto &target : instruction.targets)
+      {
+        const std::size_t index = indices.at(target->location_number);
+        targets.emplace_back();
+        targets.back().set(ID_value, static_cast<long long>(index));
+      }
+
+      instructions.push_back(std::move(description));
+    }
+  }
+
+  return result;
+}
+
+bool system_dependence_grapht::write(
+  std::ostream &out,
+  const goto_functionst &goto_functions) const
+{
+  const auto functions = goto_functions.sorted();
+
+  // The position of each instruction as the index of its function in sorted
+  // order and its index in the body of the function
+  std::unordered_map<unsigned, std::pair<std::size_t, std::size_t>> positions;
+  for(std::size_t f = 0; f < functions.size(); ++f)
+  {
+    std::size_t i = 0;
+    for(const auto &instruction : functions[f]->second.body.instructions)
+      positions.emplace(instruction.location_number, std::make_pair(f, i++));
+  }
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization{ireps_container};
+
+  out << char(0x7f) << "SDG";
+  write_gb_word(out, sdg_file_version);
+  serialization.reference_convert(program_description(functions), out);
+
+  write_gb_word(out, nodes.size());
+  for(const auto &node : nodes)
+  {
+    write_gb_word(out, static_cast<std::size_t>(node.kind));
+    if(node.kind == sdg_nodet::kindt::OBJECT)
+      serialization.write_string_ref(out, node.object);
+    else
+    {
+      const auto position = positions.find(node.PC->location_number);
+      if(position == positions.end())
+        return true;
+      write_gb_word(out, position->second.first);
+      write_gb_word(out, position->second.second);
+    }
+  }
+
+  for(const auto &node : nodes)
+  {
+    write_gb_word(out, node.out.size());
+    for(const auto &edge : node.out)
+      write_gb_word(out, edge.first);
+  }
+
+  return !out.good();
+}
+
+bool system_dependence_grapht::read(
+  std::istream &in,
+  const goto_functionst &goto_functions)
+{
+  clear();
+  post_dominators.clear();
+  instruction_nodes.clear();
+  object_nodes.clear();
+
+  char header[4];
+  in.read(header, sizeof(header));
+  if(
+    !in || header[0] != char(0x7f) || header[1] != 'S' || header[2] != 'D' ||
+    header[3] != 'G')
+  {
+    return true;
+  }
+
+  const auto functions = goto_functions.sorted();
+  std::vector<std::vector<goto_programt::const_targett>> instructions;
+  unsigned max_location_number = 0;
+  std::size_t number_of_instructions = 0;
+  for(const auto &function : functions)
+  {
+    instructions.emplace_back();
+    forall_goto_program_instructions(it, function->second.body)
+    {
+      instructions.back().push_back(it);
+      max_location_number = std::max(max_location_number, it->location_number);
+      ++number_of_instructions;
+    }
+  }
+
+  try
+  {
+    if(irep_serializationt::read_gb_word(in) != sdg_file_version)
+      return true;
+
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt serialization{ireps_container};
+
+    if(serialization.reference_convert(in) != program_description(functions))
+      return true;
+
+    instruction_nodes.resize(
+      max_location_number + 1, std::numeric_limits<node_indext>::max());
+    const std::size_t size = irep_serializationt::read_gb_word(in);
+    std::size_t number_of_instruction_nodes = 0;
+
+    for(std::size_t n = 0; n < size; ++n)
+    {
+      sdg_nodet &node = nodes[add_node()];
+      node.kind =
+        static_cast<sdg_nodet::kindt>(irep_serializationt::read_gb_word(in));
+
+      if(node.kind == sdg_nodet::kindt::OBJECT)
+      {
+        node.object = serialization.read_string_ref(in);
+        if(!object_nodes.emplace(node.object, n).second)
+          throw deserialization_exceptiont("duplicate object node");
+        continue;
+      }
+      else if(
+        node.kind != sdg_nodet::kindt::INSTRUCTION &&
+        node.kind != sdg_nodet::kindt::JOIN)
+      {
+        throw deserialization_exceptiont("invalid node kind");
+      }
+
+      const std::size_t f = irep_serializationt::read_gb_word(in);
+      const std::size_t i = irep_serializationt::read_gb_word(in);
+      if(f >= instructions.size() || i >= instructions[f].size())
+        throw deserialization_exceptiont("invalid instruction");
+      node.PC = instructions[f][i];
+
+      if(node.kind == sdg_nodet::kindt::INSTRUCTION)
+      {
+        node_indext &index = instruction_nodes[node.PC->location_number];
+        if(index != std::numeric_limits<node_indext>::max())
+          throw deserialization_exceptiont("duplicate instruction node");
+        index = n;
+        ++number_of_instruction_nodes;
+      }
+    }
+
+    if(number_of_instruction_nodes != number_of_instructions)
+      throw deserialization_exceptiont("missing instruction nodes");
+
+    for(std::size_t from = 0; from < size; ++from)
+    {
+      for(std::size_t e = irep_serializationt::read_gb_word(in); e != 0; --e)
+      {
+        const std::size_t to = irep_serializationt::read_gb_word(in);
+        if(to >= size)
+          throw deserialization_exceptiont("invalid edge");
+        add_dependency(from, to);
+      }
+    }
+  }
+  catch(const deserialization_exceptiont &)
+  {
+    clear();
+    instruction_nodes.clear();
+    object_nodes.clear();
+    return true;
+  }
+
+  for(const auto &function : functions)
+  {
+    if(!function->second.body.instructions.empty())
+      post_dominators[function->first](function->second.body);
+  }
+
+  return false;
+}
@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+Module: System Dependence Graph
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// A dependence graph for a whole program, built from def-use chains in SSA
+/// form and post-dominator trees of each function
+
+#ifndef CPROVER_ANALYSES_SYSTEM_DEPENDENCE_GRAPH_H
+#define CPROVER_ANALYSES_SYSTEM_DEPENDENCE_GRAPH_H
+
+#include <util/graph.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include "cfg_dominators.h"
+
+#include <iosfwd>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class dirtyt;
+
+struct sdg_nodet : public graph_nodet<empty_edget>
+{
+  enum class kindt
+  {
+    /// A goto instruction, see \ref PC
+    INSTRUCTION,
+    /// The value of a variable at a control-flow join, like an SSA phi node
+    JOIN,
+    /// All values of an object that is not tracked flow-sensitively, see
+    /// \ref object
+    OBJECT
+  };
+
+  kindt kind = kindt::INSTRUCTION;
+  goto_programt::const_targett PC;
+  irep_idt object;
+};
+
+/// Data and control dependencies between the instructions of a program, where
+/// the in-edges of a node are the nodes it depends on.
+///
+/// Unlike \ref dependence_grapht this does not store an abstract state per
+/// program location, but only the nodes and edges of the graph:
+/// - Local variables whose address is never taken are tracked
+///   flow-sensitively. Their uses are linked to definitions by putting each
+///   function into SSA form, with join nodes in place of phi nodes. Writes to
+///   parts of a variable (a member or an element) depend on the previous
+///   definition.
+/// - All other objects, such as global variables, return values and the
+///   arguments passed for each parameter, are tracked flow-insensitively,
+///   with one object node per object that depends on all writes to it.
+///   Objects whose address is taken and all accesses through pointers share
+///   the object node \ref memory_object.
+/// - Control dependencies are computed from the post-dominator tree of each
+///   function. As in \ref dependence_grapht, instructions that post-dominate an
+///   ASSUME are control dependent on it.
+///
+/// Objects are not distinguished by their members or elements, so slices
+/// computed from this graph may be larger than those using
+/// \ref dependence_grapht.
+class system_dependence_grapht : public grapht<sdg_nodet>
+{
+public:
+  typedef std::map<irep_idt, cfg_post_dominatorst> post_dominators_mapt;
+
+  void operator()(const goto_functionst &goto_functions);
+
+  /// The node of instruction \p target
+  node_indext instruction_node(goto_programt::const_targett target) const
+  {
+    return instruction_nodes.at(target->location_number);
+  }
+
+  const post_dominators_mapt &cfg_post_dominators() const
+  {
+    return post_dominators;
+  }
+
+  /// The identifier of the object node that all accesses through pointers use
+  static const irep_idt &memory_object();
+
+  /// Write the graph, which must have been computed for \p goto_functions,
+  /// to the binary stream \p out, such that \ref read can restore it
+  /// \return true on failure
+  bool write(std::ostream &out, const goto_functionst &goto_functions) const;
+
+  /// Replace the graph by one that \ref write wrote to \p in, and compute
+  /// the post-dominators, which are not stored. This fails if the graph was
+  /// written for a program other than \p goto_functions or by another
+  /// version.
+  /// \return true on failure, which leaves the graph empty
+  bool read(std::istream &in, const goto_functionst &goto_functions);
+
+protected:
+  post_dominators_mapt post_dominators;
+
+  /// Node of each instruction, indexed by location number
+  std::vector<node_indext> instruction_nodes;
+  std::unordered_map<irep_idt, node_indext> object_nodes;
+
+  node_indext object_node(const irep_idt &identifier);
+
+  /// Make \p to depend on \p from
+  void add_dependency(node_indext from, node_indext to)
+  {
+    add_edge(from, to);
+  }
+
+  void add_function(
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &goto_function,
+    const goto_functionst &goto_functions,
+    const dirtyt &dirty);
+
+  void add_control_dependencies(const cfg_post_dominatorst &post_dominators);
+};
+
+#endif // CPROVER_ANALYSES_SYSTEM_DEPENDENCE_GRAPH_H
@@ -363,15 +363,20 @@ bool abstract_environmentt::merge(
   if(env.bottom)
     return false;
 
-  // For each element in the intersection of map and env.map merge
-  // If the result of the merge is top, remove from the map
+  // For each element in the intersection of map and env.map merge.
+  // The delta view skips all subtrees the two maps share, and entries whose
+  // merge is a no-op are not written back, which would unshare the path to
+  // them and make all later merges with this map walk it again.
   bool modified = false;
   for(const auto &entry : env.map.get_delta_view(map))
   {
     auto merge_result = abstract_objectt::merge(
       entry.get_other_map_value(), entry.m, merge_location, widen_mode);
 
-    modified |= merge_result.modified;
+    if(!merge_result.modified)
+      continue;
+
+    modified = true;
     map.replace(entry.k, merge_result.object);
   }
 
@@ -527,12 +532,24 @@ static std::size_t count_globals(const namespacet &ns)
 
 abstract_object_statisticst
 abstract_environmentt::gather_statistics(const namespacet &ns) const
+{
+  abstract_object_visitedt bound_objects;
+  return gather_statistics(ns, bound_objects);
+}
+
+abstract_object_statisticst abstract_environmentt::gather_statistics(
+  const namespacet &ns,
+  abstract_object_visitedt &bound_objects) const
 {
   abstract_object_statisticst statistics = {};
   statistics.number_of_globals = count_globals(ns);
   abstract_object_visitedt visited;
   for(auto const &object : map.get_view())
   {
+    ++statistics.number_of_bindings;
+    if(bound_objects.insert(object.second).second)
+      ++statistics.number_of_allocated_objects;
+
     if(visited.find(object.second) == visited.end())
     {
       object.second->get_statistics(statistics, visited, *this, ns);
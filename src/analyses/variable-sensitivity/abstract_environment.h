@@ -247,6 +247,14 @@ class abstract_environmentt
 
   abstract_object_statisticst gather_statistics(const namespacet &ns) const;
 
+  /// Like \ref gather_statistics(const namespacet &)const, but only count
+  /// the objects bound to variables as allocated if they are not in
+  /// \p bound_objects, which they are added to. This measures the sharing
+  /// of objects between environments.
+  abstract_object_statisticst gather_statistics(
+    const namespacet &ns,
+    abstract_object_visitedt &bound_objects) const;
+
 protected:
   bool bottom;
 
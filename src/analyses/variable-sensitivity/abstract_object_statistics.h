@@ -24,6 +24,11 @@ struct abstract_object_statisticst
   std::size_t number_of_pointers = 0;
   std::size_t number_of_constants = 0;
   std::size_t number_of_globals = 0;
+  /// The number of variables bound to an abstract object
+  std::size_t number_of_bindings = 0;
+  /// The number of distinct abstract objects bound to variables. All other
+  /// bindings share their object with another binding.
+  std::size_t number_of_allocated_objects = 0;
   /// An underestimation of the memory usage of the abstract objects
   memory_sizet objects_memory_usage;
 };
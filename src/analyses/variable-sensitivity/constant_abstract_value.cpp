@@ -117,7 +117,11 @@ abstract_object_pointert constant_abstract_valuet::merge_with_value(
 {
   auto other_expr = other->to_constant();
   if(is_bottom() && other_expr.is_constant())
+  {
+    if(std::dynamic_pointer_cast<const constant_abstract_valuet>(other))
+      return other;
     return std::make_shared<constant_abstract_valuet>(other_expr);
+  }
 
   if(value == other_expr) // Can we actually merge these value
     return shared_from_this();
@@ -380,8 +380,14 @@ abstract_object_pointert interval_abstract_valuet::merge_with_value(
 
   auto other_interval = other->to_interval();
 
+  // Objects are immutable, hence a result equal to the other interval is
+  // shared with it rather than allocated anew
+  const bool other_is_interval =
+    std::dynamic_pointer_cast<const interval_abstract_valuet>(other) !=
+    nullptr;
+
   if(is_bottom())
-    return make_interval(other_interval);
+    return other_is_interval ? other : make_interval(other_interval);
 
   if(interval.contains(other_interval))
     return shared_from_this();
@@ -389,6 +395,9 @@ abstract_object_pointert interval_abstract_valuet::merge_with_value(
   if(widen_mode == widen_modet::could_widen)
     return widening_merge(interval, other_interval);
 
+  if(other_is_interval && other_interval.contains(interval))
+    return other;
+
   auto lower_bound = constant_interval_exprt::get_min(
     interval.get_lower(), other_interval.get_lower());
   auto upper_bound = constant_interval_exprt::get_max(
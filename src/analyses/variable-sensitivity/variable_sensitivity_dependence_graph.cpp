@@ -253,6 +253,7 @@ void variable_sensitivity_dependence_domaint::control_dependencies(
   }
 
   const cfg_post_dominatorst &pd = pd_tmp;
+  const cfg_post_dominatorst::cfgt::nodet &to_node = pd.get_node(to);
 
   // Check all candidates
 
@@ -272,7 +273,7 @@ void variable_sensitivity_dependence_domaint::control_dependencies(
     {
       const cfg_post_dominatorst::cfgt::nodet &m_s = pd.cfg[edge.first];
 
-      if(m_s.dominators.find(to) != m_s.dominators.end())
+      if(pd.dominates(to_node, m_s))
         post_dom_one = true;
       else
         post_dom_all = false;
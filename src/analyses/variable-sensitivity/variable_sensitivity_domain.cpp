@@ -243,6 +243,17 @@ bool variable_sensitivity_domaint::merge(
   return any_changes;
 }
 
+bool variable_sensitivity_domaint::widen(
+  const variable_sensitivity_domaint &b,
+  trace_ptrt to)
+{
+  bool any_changes = abstract_state.merge(
+    b.abstract_state, to->current_location(), widen_modet::could_widen);
+
+  DATA_INVARIANT(abstract_state.verify(), "Structural invariant");
+  return any_changes;
+}
+
 bool variable_sensitivity_domaint::ai_simplify(
   exprt &condition,
   const namespacet &ns) const
@@ -484,4 +495,11 @@ variable_sensitivity_domaint::gather_statistics(const namespacet &ns) const
 {
   return abstract_state.gather_statistics(ns);
 }
+
+abstract_object_statisticst variable_sensitivity_domaint::gather_statistics(
+  const namespacet &ns,
+  abstract_object_visitedt &bound_objects) const
+{
+  return abstract_state.gather_statistics(ns, bound_objects);
+}
 #endif
@@ -176,6 +176,15 @@ class variable_sensitivity_domaint : public ai_domain_baset
   virtual bool
   merge(const variable_sensitivity_domaint &b, trace_ptrt from, trace_ptrt to);
 
+  /// Computes the join between "this" and "b", widening the abstract objects
+  /// that support it regardless of what the histories suggest.
+  ///
+  /// \param b: the other domain
+  /// \param to: it's current location
+  ///
+  /// \return true if something has changed.
+  bool widen(const variable_sensitivity_domaint &b, trace_ptrt to);
+
   /// Perform a context aware merge of the changes that have been applied
   /// between function_start and the current state. Anything that has not been
   /// modified will be taken from the \p function_call domain.
@@ -269,6 +278,9 @@ class variable_sensitivity_domaint : public ai_domain_baset
 #ifdef ENABLE_STATS
 public:
   abstract_object_statisticst gather_statistics(const namespacet &ns) const;
+  abstract_object_statisticst gather_statistics(
+    const namespacet &ns,
+    abstract_object_visitedt &bound_objects) const;
 #endif
 };
 
@@ -291,6 +303,13 @@ class variable_sensitivity_domain_factoryt
     return std::unique_ptr<statet>(d.release());
   }
 
+  bool widen(statet &dest, const statet &src, trace_ptrt, trace_ptrt to)
+    const override
+  {
+    return static_cast<variable_sensitivity_domaint &>(dest).widen(
+      static_cast<const variable_sensitivity_domaint &>(src), to);
+  }
+
 private:
   variable_sensitivity_object_factory_ptrt object_factory;
   const vsd_configt configuration;
@@ -301,10 +320,13 @@ template <>
 struct get_domain_statisticst<variable_sensitivity_domaint>
 {
   abstract_object_statisticst total_statistics = {};
+  /// The objects bound to variables in the domains seen so far
+  abstract_object_visitedt bound_objects;
+
   void
   add_entry(const variable_sensitivity_domaint &domain, const namespacet &ns)
   {
-    auto statistics = domain.gather_statistics(ns);
+    auto statistics = domain.gather_statistics(ns, bound_objects);
     total_statistics.number_of_interval_abstract_objects +=
       statistics.number_of_interval_abstract_objects;
     total_statistics.number_of_globals += statistics.number_of_globals;
@@ -315,6 +337,9 @@ struct get_domain_statisticst<variable_sensitivity_domaint>
     total_statistics.number_of_arrays += statistics.number_of_arrays;
     total_statistics.number_of_structs += statistics.number_of_arrays;
     total_statistics.objects_memory_usage += statistics.objects_memory_usage;
+    total_statistics.number_of_bindings += statistics.number_of_bindings;
+    total_statistics.number_of_allocated_objects +=
+      statistics.number_of_allocated_objects;
   }
 
   void print(std::ostream &out) const
@@ -333,6 +358,14 @@ struct get_domain_statisticst<variable_sensitivity_domaint>
         << "  Number of single value intervals: "
         << total_statistics.number_of_single_value_intervals << '\n'
         << "  Number of globals: " << total_statistics.number_of_globals << '\n'
+        << "  Number of bindings: " << total_statistics.number_of_bindings
+        << '\n'
+        << "  Number of allocated objects: "
+        << total_statistics.number_of_allocated_objects << '\n'
+        << "  Number of shared objects: "
+        << total_statistics.number_of_bindings -
+             total_statistics.number_of_allocated_objects
+        << '\n'
         << "<< End Variable Sensitivity Domain Statistics >>\n";
   }
 };
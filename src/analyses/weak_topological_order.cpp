@@ -0,0 +1,216 @@
+/*******************************************************************\
+
+Module: Weak Topological Order
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Weak topological order of the instructions of a goto program
+
+#include "weak_topological_order.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <ostream>
+
+namespace
+{
+/// The recursive algorithm of Bourdoncle's paper, which builds the order
+/// back to front. The recursion nests about once per instruction, so it is
+/// run on an explicit stack of frames instead.
+class wto_buildert
+{
+public:
+  typedef weak_topological_ordert::locationt locationt;
+  typedef weak_topological_ordert::elementt elementt;
+
+  explicit wto_buildert(const goto_programt &goto_program)
+  {
+    forall_goto_program_instructions(it, goto_program)
+    {
+      index.emplace(it, nodes.size());
+      nodes.push_back(it);
+    }
+
+    successors.resize(nodes.size());
+    for(std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      for(const auto &to : goto_program.get_successors(nodes[i]))
+      {
+        if(to != goto_program.instructions.end())
+          successors[i].push_back(index.at(to));
+      }
+    }
+
+    dfn.resize(nodes.size(), 0);
+  }
+
+  /// The elements of the order, last one first. The component_end of a head
+  /// is the number of elements of its body.
+  std::vector<elementt> reverse_order;
+
+  void run()
+  {
+    if(nodes.empty())
+      return;
+
+    visit(0);
+
+    while(!frames.empty())
+    {
+      framet &frame = frames.back();
+      const auto &vertex_successors = successors[frame.vertex];
+
+      if(frame.next_successor < vertex_successors.size())
+      {
+        const std::size_t successor =
+          vertex_successors[frame.next_successor++];
+        if(dfn[successor] == 0)
+          visit(successor);
+        else if(!frame.is_component)
+          frame.update_head(dfn[successor]);
+      }
+      else if(frame.is_component)
+      {
+        reverse_order.push_back(
+          {nodes[frame.vertex], reverse_order.size() - frame.body_begin});
+        frames.pop_back();
+      }
+      else
+      {
+        const framet done_frame = frame;
+        frames.pop_back();
+        finish_visit(done_frame);
+      }
+    }
+  }
+
+protected:
+  std::vector<locationt> nodes;
+  std::unordered_map<locationt, std::size_t, const_target_hash> index;
+  std::vector<std::vector<std::size_t>> successors;
+
+  /// Depth-first number of each node, 0 if not visited, done once the
+  /// node is placed in the order
+  std::vector<std::size_t> dfn;
+  const std::size_t done = std::numeric_limits<std::size_t>::max();
+  std::size_t number = 0;
+  std::vector<std::size_t> stack;
+
+  /// A pending call of `visit` or `component` of the paper
+  struct framet
+  {
+    std::size_t vertex;
+    bool is_component;
+    std::size_t next_successor;
+    /// For `visit`: the least depth-first number reachable so far
+    std::size_t head;
+    bool loop;
+    /// For `component`: the size of reverse_order when the body started
+    std::size_t body_begin;
+
+    void update_head(std::size_t min)
+    {
+      if(min <= head)
+      {
+        head = min;
+        loop = true;
+      }
+    }
+  };
+
+  std::vector<framet> frames;
+
+  void visit(std::size_t vertex)
+  {
+    stack.push_back(vertex);
+    dfn[vertex] = ++number;
+    frames.push_back({vertex, false, 0, dfn[vertex], false, 0});
+  }
+
+  /// The end of `visit`, once all successors have been explored, which
+  /// returns the head to the caller
+  void finish_visit(const framet &frame)
+  {
+    const std::size_t vertex = frame.vertex;
+    const bool is_head = frame.head == dfn[vertex] && frame.loop;
+
+    if(frame.head == dfn[vertex])
+    {
+      dfn[vertex] = done;
+      std::size_t element = stack.back();
+      stack.pop_back();
+
+      if(frame.loop)
+      {
+        while(element != vertex)
+        {
+          dfn[element] = 0;
+          element = stack.back();
+          stack.pop_back();
+        }
+      }
+      else
+        reverse_order.push_back({nodes[vertex], 0});
+    }
+
+    // The caller uses the head before it resumes, so this can be done ahead
+    // of the component, which does not change it
+    if(!frames.empty() && !frames.back().is_component)
+      frames.back().update_head(frame.head);
+
+    if(is_head)
+      frames.push_back({vertex, true, 0, 0, false, reverse_order.size()});
+  }
+};
+} // namespace
+
+weak_topological_ordert::weak_topological_ordert(
+  const goto_programt &goto_program)
+{
+  wto_buildert builder(goto_program);
+  builder.run();
+
+  order.reserve(builder.reverse_order.size());
+  std::copy(
+    builder.reverse_order.rbegin(),
+    builder.reverse_order.rend(),
+    std::back_inserter(order));
+
+  for(std::size_t i = 0; i < order.size(); ++i)
+  {
+    order[i].component_end += i + 1;
+    positions.emplace(order[i].location, i);
+  }
+}
+
+void weak_topological_ordert::output(std::ostream &out) const
+{
+  std::vector<std::size_t> open_components;
+
+  for(std::size_t i = 0; i < order.size(); ++i)
+  {
+    while(!open_components.empty() && open_components.back() == i)
+    {
+      out << ')';
+      open_components.pop_back();
+    }
+
+    if(i != 0)
+      out << ' ';
+
+    if(order[i].component_end > i + 1)
+    {
+      out << '(';
+      open_components.push_back(order[i].component_end);
+    }
+
+    out << order[i].location->location_number;
+  }
+
+  for(std::size_t n = open_components.size(); n != 0; --n)
+    out << ')';
+}
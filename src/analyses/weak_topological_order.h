@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Weak Topological Order
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Weak topological order of the instructions of a goto program
+
+#ifndef CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
+#define CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
+
+#include <goto-programs/goto_program.h>
+
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+/// A weak topological order of the instructions of a goto program reachable
+/// from its first instruction, as defined by F. Bourdoncle, "Efficient
+/// chaotic iteration strategies with widenings", FMPA 1993.
+///
+/// The order is a hierarchy of components: each component is a strongly
+/// connected part of the control flow graph, made up of its head followed by
+/// the instructions and nested components of its body. Every edge that is
+/// not an edge back to the head of a component goes forward in the order.
+/// The order is written with components in brackets, for example
+/// `1 (2 3 (4 5) 6) 7`. Iterating in this order and stabilising each
+/// component before leaving it avoids visiting instructions after a loop
+/// before the loop is stable, and the heads are the only instructions at
+/// which widening is needed for the iteration to terminate.
+class weak_topological_ordert
+{
+public:
+  typedef goto_programt::const_targett locationt;
+
+  explicit weak_topological_ordert(const goto_programt &goto_program);
+
+  struct elementt
+  {
+    locationt location;
+    /// Index one past the last element of the component that this element
+    /// is the head of, or one past this element if it is not a head
+    std::size_t component_end;
+  };
+
+  const std::vector<elementt> &elements() const
+  {
+    return order;
+  }
+
+  /// Position of \p location in the order, or the number of elements if it
+  /// is not reachable
+  std::size_t position(locationt location) const
+  {
+    const auto it = positions.find(location);
+    return it == positions.end() ? order.size() : it->second;
+  }
+
+  /// Whether \p location is the head of a component
+  bool is_head(locationt location) const
+  {
+    const auto it = positions.find(location);
+    return it != positions.end() && order[it->second].component_end >
+                                      it->second + 1;
+  }
+
+  /// Output the order using location numbers, with components in brackets
+  void output(std::ostream &out) const;
+
+protected:
+  std::vector<elementt> order;
+  std::unordered_map<locationt, std::size_t, const_target_hash> positions;
+};
+
+#endif // CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
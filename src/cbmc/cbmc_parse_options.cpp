@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/exit_codes.h>
 #include <util/invariant.h>
 #include <util/make_unique.h>
+#include <util/string2int.h>
 #include <util/version.h>
 
 #include <cstdlib> // exit()
@@ -28,6 +29,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <langapi/language.h>
 
+#include <analyses/guard.h>
+
 #include <ansi-c/c_preprocess.h>
 #include <ansi-c/cprover_library.h>
 #include <ansi-c/gcc_version.h>
@@ -63,9 +66,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_symbol_table.h>
 
 #include <goto-instrument/cover.h>
+#include <goto-instrument/discharge_properties.h>
 #include <goto-instrument/full_slicer.h>
 #include <goto-instrument/nondet_static.h>
+#include <goto-instrument/points_to_fp_removal.h>
 #include <goto-instrument/reachability_slicer.h>
+#include <goto-instrument/summarise_loops.h>
 
 #include <goto-symex/path_storage.h>
 
@@ -157,6 +163,18 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("no-array-field-sensitivity", true);
   }
 
+  if(cmdline.isset("sparse-array-field-sensitivity"))
+  {
+    if(cmdline.isset("no-array-field-sensitivity"))
+    {
+      log.error()
+        << "--no-array-field-sensitivity and --sparse-array-field-sensitivity"
+        << " must not be given together" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("sparse-array-field-sensitivity", true);
+  }
+
   if(cmdline.isset("reachability-slice") &&
      cmdline.isset("reachability-slice-fb"))
   {
@@ -169,6 +187,15 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("full-slice"))
     options.set_option("full-slice", true);
 
+  if(cmdline.isset("full-slice-sdg") || cmdline.isset("full-slice-sdg-cache"))
+    options.set_option("full-slice-sdg", true);
+
+  if(cmdline.isset("full-slice-sdg-cache"))
+  {
+    options.set_option(
+      "full-slice-sdg-cache", cmdline.get_value("full-slice-sdg-cache"));
+  }
+
   if(cmdline.isset("show-symex-strategies"))
   {
     log.status() << show_path_strategies() << messaget::eom;
@@ -187,7 +214,11 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("show-vcc", true);
 
   if(cmdline.isset("cover"))
+  {
     parse_cover_options(cmdline, options);
+    options.set_option(
+      "cover-subsumption", cmdline.isset("cover-subsumption"));
+  }
 
   if(cmdline.isset("mm"))
     options.set_option("mm", cmdline.get_value("mm"));
@@ -222,6 +253,26 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("nondet-static"))
     options.set_option("nondet-static", true);
 
+  if(cmdline.isset("summarise-loops-from-analysis"))
+    options.set_option("summarise-loops-from-analysis", true);
+
+  if(cmdline.isset("points-to-fp-removal"))
+    options.set_option("points-to-fp-removal", true);
+
+  if(cmdline.isset("pre-discharge-with-analysis"))
+  {
+    const std::string domain =
+      cmdline.get_value("pre-discharge-with-analysis");
+    if(!is_discharge_properties_domain(domain))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "unknown abstract domain '" + domain + "'",
+        "--pre-discharge-with-analysis",
+        "constants, intervals or octagons");
+    }
+    options.set_option("pre-discharge-with-analysis", domain);
+  }
+
   if(cmdline.isset("no-simplify"))
     options.set_option("simplify", false);
 
@@ -303,6 +354,56 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   options.set_option(
     "symex-cache-dereferences", cmdline.isset("symex-cache-dereferences"));
 
+  if(cmdline.isset("symex-points-to-oracle"))
+  {
+    if(cmdline.isset("paths"))
+    {
+      log.error() << "--symex-points-to-oracle not supported with --paths"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("symex-points-to-oracle", true);
+  }
+
+  if(cmdline.isset("symex-guards"))
+  {
+    const std::string symex_guards = cmdline.get_value("symex-guards");
+    if(!guard_managert::parse_kind(symex_guards).has_value())
+    {
+      log.error() << "--symex-guards must be either bdd or expr"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("symex-guards", symex_guards);
+  }
+
+  if(cmdline.isset("symex-spill-steps"))
+  {
+    const auto limit =
+      string2optional_size_t(cmdline.get_value("symex-spill-steps"));
+    if(!limit.has_value() || *limit == 0)
+    {
+      log.error() << "--symex-spill-steps expects a positive number"
+                  << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option(
+      "symex-spill-steps", cmdline.get_value("symex-spill-steps"));
+  }
+
+  if(cmdline.isset("symex-profile"))
+  {
+    if(cmdline.isset("paths") || cmdline.isset("incremental-loop"))
+    {
+      log.error()
+        << "--symex-profile not supported with --paths or --incremental-loop"
+        << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("symex-profile", cmdline.get_value("symex-profile"));
+  }
+
   if(cmdline.isset("incremental-loop"))
   {
     options.set_option(
@@ -760,6 +861,11 @@ bool cbmc_parse_optionst::process_goto_program(
   link_to_library(
     goto_model, log.get_message_handler(), cprover_c_library_factory);
 
+  // narrow calls through function pointers to their points-to sets before
+  // the remaining ones are removed based on their type
+  if(options.get_bool_option("points-to-fp-removal"))
+    points_to_fp_removal(goto_model, log.get_message_handler());
+
   // Common removal of types and complex constructs
   if(::process_goto_program(goto_model, options, log))
     return true;
@@ -806,6 +912,23 @@ bool cbmc_parse_optionst::process_goto_program(
   // this would cause the property identifiers to change.
   label_properties(goto_model);
 
+  // replace loops by a havoc, an invariant and a single iteration
+  if(options.get_bool_option("summarise-loops-from-analysis"))
+  {
+    log.status() << "Summarising loops using abstract interpretation"
+                 << messaget::eom;
+    summarise_loops(goto_model, log.get_message_handler());
+  }
+
+  // prove what abstract interpretation can, leaving the rest to symex
+  if(options.is_set("pre-discharge-with-analysis"))
+  {
+    discharge_properties(
+      goto_model,
+      options.get_option("pre-discharge-with-analysis"),
+      log.get_message_handler());
+  }
+
   // reachability slice?
   if(options.get_bool_option("reachability-slice-fb"))
   {
@@ -842,9 +965,20 @@ bool cbmc_parse_optionst::process_goto_program(
   {
     log.status() << "Performing a full slice" << messaget::eom;
     if(options.is_set("property"))
-      property_slicer(goto_model, options.get_list_option("property"));
+    {
+      property_slicer(
+        goto_model,
+        options.get_list_option("property"),
+        options.get_bool_option("full-slice-sdg"),
+        options.get_option("full-slice-sdg-cache"));
+    }
     else
-      full_slicer(goto_model);
+    {
+      full_slicer(
+        goto_model,
+        options.get_bool_option("full-slice-sdg"),
+        options.get_option("full-slice-sdg-cache"));
+    }
   }
 
   // remove any skips introduced since coverage instrumentation
@@ -899,11 +1033,19 @@ void cbmc_parse_optionst::help()
     "Program instrumentation options:\n"
     HELP_GOTO_CHECK
     HELP_COVER
+    " --cover-subsumption          only target goals not implied by other goals\n" // NOLINT(*)
     " --mm MM                      memory consistency model for concurrent programs (default: sc)\n" // NOLINT(*)
     HELP_CONFIG_LIBRARY
     HELP_REACHABILITY_SLICER
     HELP_REACHABILITY_SLICER_FB
     " --full-slice                 run full slicer (experimental)\n" // NOLINT(*)
+    " --full-slice-sdg             compute the dependencies for --full-slice\n"
+    "                              with a system dependence graph, which is\n"
+    "                              less precise but scales to large programs\n"
+    " --full-slice-sdg-cache file  as --full-slice-sdg, reusing the system\n"
+    "                              dependence graph stored in file if it was\n"
+    "                              computed for the same program, and storing\n"
+    "                              it there otherwise\n"
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
     " --havoc-undefined-functions\n"
     "                              for any function that has no body, assign non-deterministic values to\n" // NOLINT(*)
@@ -912,6 +1054,16 @@ void cbmc_parse_optionst::help()
     "Semantic transformations:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --nondet-static              add nondeterministic initialization of variables with static lifetime\n"
+    " --points-to-fp-removal       replace calls through function pointers by case splits\n" // NOLINT(*)
+    "                              over the functions a points-to analysis finds\n" // NOLINT(*)
+    " --summarise-loops-from-analysis\n"
+    "                              replace loops by their interval invariants (may\n" // NOLINT(*)
+    "                              report spurious failures when too imprecise)\n" // NOLINT(*)
+    " --pre-discharge-with-analysis domain\n"
+    "                              prove properties using abstract interpretation\n" // NOLINT(*)
+    "                              before symex, where domain is constants,\n"
+    "                              intervals or octagons (ignored for\n"
+    "                              multi-threaded programs)\n"
     "\n"
     "BMC options:\n"
     HELP_BMC
@@ -36,7 +36,7 @@ class optionst;
   OPT_BMC \
   "(preprocess)(slice-by-trace):" \
   OPT_FUNCTIONS \
-  "(no-simplify)(full-slice)" \
+  "(no-simplify)(full-slice)(full-slice-sdg)(full-slice-sdg-cache):" \
   OPT_REACHABILITY_SLICER \
   "(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(test-preprocessor)" \
@@ -58,8 +58,12 @@ class optionst;
   "(property):(stop-on-fail)(trace)" \
   "(verbosity):(no-library)" \
   "(nondet-static)" \
+  "(summarise-loops-from-analysis)" \
+  "(points-to-fp-removal)" \
+  "(pre-discharge-with-analysis):" \
   "(version)" \
   OPT_COVER \
+  "(cover-subsumption)" \
   "(symex-coverage-report):" \
   "(mm):" \
   OPT_TIMESTAMP \
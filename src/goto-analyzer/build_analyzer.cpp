@@ -9,11 +9,14 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #include "build_analyzer.h"
 
 #include <analyses/ai.h>
+#include <analyses/ai_function_local.h>
+#include <analyses/ai_summary_interprocedural.h>
 #include <analyses/call_stack_history.h>
 #include <analyses/constant_propagator.h>
 #include <analyses/dependence_graph.h>
 #include <analyses/interval_domain.h>
 #include <analyses/local_control_flow_history.h>
+#include <analyses/octagon_domain.h>
 #include <analyses/variable-sensitivity/three_way_merge_abstract_interpreter.h>
 #include <analyses/variable-sensitivity/variable_sensitivity_configuration.h>
 #include <analyses/variable-sensitivity/variable_sensitivity_dependence_graph.h>
@@ -39,6 +42,8 @@ std::unique_ptr<ai_baset> build_analyzer(
   // These support all of the option categories
   if(
     options.get_bool_option("recursive-interprocedural") ||
+    options.get_bool_option("summary-interprocedural") ||
+    options.get_bool_option("function-local") ||
     options.get_bool_option("three-way-merge"))
   {
     // Build the history factory
@@ -73,6 +78,11 @@ std::unique_ptr<ai_baset> build_analyzer(
       df = util_make_unique<
         ai_domain_factory_default_constructort<interval_domaint>>();
     }
+    else if(options.get_bool_option("octagons"))
+    {
+      df = util_make_unique<octagon_domain_factoryt>(
+        goto_model.goto_functions, ns);
+    }
     else if(options.get_bool_option("vsd"))
     {
       df = util_make_unique<variable_sensitivity_domain_factoryt>(
@@ -102,6 +112,16 @@ std::unique_ptr<ai_baset> build_analyzer(
         return util_make_unique<ai_recursive_interproceduralt>(
           std::move(hf), std::move(df), std::move(st), mh);
       }
+      else if(options.get_bool_option("summary-interprocedural"))
+      {
+        return util_make_unique<ai_summary_interproceduralt>(
+          std::move(hf), std::move(df), std::move(st), mh);
+      }
+      else if(options.get_bool_option("function-local"))
+      {
+        return util_make_unique<ai_function_localt>(
+          std::move(hf), std::move(df), std::move(st), mh);
+      }
       else if(options.get_bool_option("three-way-merge"))
       {
         // Only works with VSD
@@ -140,6 +160,12 @@ std::unique_ptr<ai_baset> build_analyzer(
     {
       return util_make_unique<ait<interval_domaint>>();
     }
+    else if(options.get_bool_option("octagons"))
+    {
+      auto df = util_make_unique<octagon_domain_factoryt>(
+        goto_model.goto_functions, ns);
+      return util_make_unique<ait<octagon_domaint>>(std::move(df));
+    }
 #if 0
     // Not actually implemented, despite the option...
     else if(options.get_bool_option("non-null"))
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/exception_utils.h>
 #include <util/exit_codes.h>
 #include <util/options.h>
+#include <util/string2int.h>
 #include <util/version.h>
 
 #include <goto-programs/initialize_goto_model.h>
@@ -25,6 +26,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_symbol_table.h>
 
 #include <analyses/ai.h>
+#include <analyses/ai_function_local.h>
 #include <analyses/local_may_alias.h>
 #include <ansi-c/cprover_library.h>
 #include <ansi-c/gcc_version.h>
@@ -32,6 +34,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cpp/cprover_library.h>
 
 #include "build_analyzer.h"
+#include "incremental_static_verifier.h"
+#include "parallel_static_verifier.h"
 #include "show_on_source.h"
 #include "static_show_domain.h"
 #include "static_simplifier.h"
@@ -189,6 +193,10 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
     // Abstract interpreter choice
     if(cmdline.isset("recursive-interprocedural"))
       options.set_option("recursive-interprocedural", true);
+    else if(cmdline.isset("summary-interprocedural"))
+      options.set_option("summary-interprocedural", true);
+    else if(cmdline.isset("function-local"))
+      options.set_option("function-local", true);
     else if(cmdline.isset("three-way-merge"))
       options.set_option("three-way-merge", true);
     else if(cmdline.isset("legacy-ait") || cmdline.isset("location-sensitive"))
@@ -219,6 +227,50 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("storage set", true);
     }
 
+    if(cmdline.isset("weak-topological-order"))
+      options.set_option("weak-topological-order", true);
+
+    if(cmdline.isset("jobs"))
+    {
+      if(
+        !options.get_bool_option("verify") ||
+        !options.get_bool_option("function-local"))
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "parallel analysis requires --verify and --function-local",
+          "--jobs");
+      }
+
+      const auto jobs = string2optional_unsigned(cmdline.get_value("jobs"));
+      if(!jobs.has_value() || *jobs == 0)
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "the number of jobs must be a positive number", "--jobs");
+      }
+      options.set_option("jobs", *jobs);
+    }
+
+    if(cmdline.isset("incremental"))
+    {
+      if(
+        !options.get_bool_option("verify") ||
+        !options.get_bool_option("function-local"))
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "incremental analysis requires --verify and --function-local",
+          "--incremental");
+      }
+
+      if(options.is_set("jobs"))
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "incremental analysis cannot be combined with --jobs",
+          "--incremental");
+      }
+
+      options.set_option("incremental", cmdline.get_value("incremental"));
+    }
+
     // History choice
     if(cmdline.isset("ahistorical"))
     {
@@ -286,6 +338,11 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("intervals", true);
       options.set_option("domain set", true);
     }
+    else if(cmdline.isset("octagons"))
+    {
+      options.set_option("octagons", true);
+      options.set_option("domain set", true);
+    }
     else if(cmdline.isset("non-null"))
     {
       options.set_option("non-null", true);
@@ -589,9 +646,25 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    if(options.get_bool_option("weak-topological-order"))
+    {
+      analyzer->set_iteration_strategy(
+        ai_baset::iteration_strategyt::WEAK_TOPOLOGICAL_ORDER);
+    }
+
+    // With several jobs, the abstract states are computed by the processes
+    // that check the assertions
+    const bool parallel_verify = options.is_set("jobs");
+    // Incrementally, only the abstract states of changed functions are
+    // computed
+    const bool incremental_verify = options.is_set("incremental");
+
     // Run
-    log.status() << "Computing abstract states" << messaget::eom;
-    (*analyzer)(goto_model);
+    if(!parallel_verify && !incremental_verify)
+    {
+      log.status() << "Computing abstract states" << messaget::eom;
+      (*analyzer)(goto_model);
+    }
 
     // Perform the task
     log.status() << "Performing task" << messaget::eom;
@@ -608,6 +681,24 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       show_on_source(goto_model, *analyzer, ui_message_handler);
       return CPROVER_EXIT_SUCCESS;
     }
+    else if(parallel_verify)
+    {
+      auto function_local = dynamic_cast<ai_function_localt *>(analyzer.get());
+      INVARIANT(
+        function_local != nullptr,
+        "--jobs is only accepted with --function-local");
+      result = parallel_static_verifier(
+        goto_model, *function_local, options, ui_message_handler, out);
+    }
+    else if(incremental_verify)
+    {
+      auto function_local = dynamic_cast<ai_function_localt *>(analyzer.get());
+      INVARIANT(
+        function_local != nullptr,
+        "--incremental is only accepted with --function-local");
+      result = incremental_static_verifier(
+        goto_model, *function_local, options, ui_message_handler, out);
+    }
     else if(options.get_bool_option("verify"))
     {
       result = static_verifier(
@@ -714,6 +805,18 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --recursive-interprocedural  use recursion to handle interprocedural reasoning\n"
     // NOLINTNEXTLINE(whitespace/line_length)
+    " --summary-interprocedural    like --recursive-interprocedural, but reuse the\n"
+    "                              effect of a call at calls with the same state\n"
+    " --function-local             analyse each function on its own, without\n"
+    "                              following function calls\n"
+    " --jobs n                     check assertions with n processes\n"
+    "                              (use with --verify and --function-local)\n"
+    " --incremental file           reuse the results of --verify stored in file\n"
+    "                              for unchanged functions and update them\n"
+    "                              (use with --verify and --function-local)\n"
+    " --weak-topological-order     visit loops in weak topological order and\n"
+    "                              widen at their heads\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
     " --three-way-merge            use VSD's three-way merge on return from function call\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-concurrent          legacy-ait with an extended fixed-point for concurrency\n"
@@ -743,6 +846,7 @@ void goto_analyzer_parse_optionst::help()
     "Domain options:\n"
     " --constants                  a constant for each variable if possible\n"
     " --intervals                  an interval for each variable\n"
+    " --octagons                   bounds on sums and differences of pairs\n"
     " --non-null                   tracks which pointers are non-null\n"
     " --dependence-graph           data and control dependencies between instructions\n" // NOLINT(*)
     " --vsd, --variable-sensitivity\n"
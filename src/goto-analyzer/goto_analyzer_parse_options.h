@@ -113,6 +113,11 @@ class optionst;
 
 #define GOTO_ANALYSER_OPTIONS_AI \
   "(recursive-interprocedural)" \
+  "(summary-interprocedural)" \
+  "(function-local)" \
+  "(jobs):" \
+  "(incremental):" \
+  "(weak-topological-order)" \
   "(three-way-merge)" \
   "(legacy-ait)" \
   "(legacy-concurrent)"
@@ -126,6 +131,7 @@ class optionst;
 
 #define GOTO_ANALYSER_OPTIONS_DOMAIN \
   "(intervals)" \
+  "(octagons)" \
   "(non-null)" \
   "(constants)" \
   "(dependence-graph)" \
@@ -0,0 +1,300 @@
+/*******************************************************************\
+
+Module: goto-analyzer
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Checking assertions, reusing the results of unchanged functions
+
+#include "incremental_static_verifier.h"
+
+#include <util/irep_hash.h>
+#include <util/json.h>
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/options.h>
+#include <util/stable_irep_hash.h>
+#include <util/string2int.h>
+#include <util/string_hash.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/ai_function_local.h>
+#include <json/json_parser.h>
+
+#include "static_verifier.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+/// Must be changed whenever the format of the results file or the way the
+/// hashes are computed changes
+static const char results_file_version[] = "2";
+
+namespace
+{
+/// The stored results of a function
+struct function_resultst
+{
+  std::string hash;
+  std::vector<ai_verifier_statust> statuses;
+};
+} // namespace
+
+/// Hash of everything but the functions that the results depend on: the
+/// options and the type definitions of the program
+static std::string configuration_hash(
+  const goto_modelt &goto_model,
+  const optionst &options,
+  stable_irep_hashert &hasher)
+{
+  // the name of the results file does not affect the results
+  optionst relevant_options = options;
+  relevant_options.set_option("incremental", "");
+  std::ostringstream options_json;
+  options_json << relevant_options.to_json();
+
+  std::size_t result = hash_string(options_json.str());
+  for(const auto &entry : goto_model.symbol_table)
+  {
+    if(entry.second.is_type)
+    {
+      result = hash_combine(result, hash_string(id2string(entry.first)));
+      result = hash_combine(result, hasher(entry.second.type));
+    }
+  }
+
+  return std::to_string(result);
+}
+
+/// Hash of the signature and the body of function \p function_id
+static std::string function_hash(
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &goto_function,
+  const namespacet &ns,
+  stable_irep_hashert &hasher)
+{
+  std::size_t result = hasher(ns.lookup(function_id).type);
+
+  const goto_programt &body = goto_function.body;
+  if(!body.instructions.empty())
+  {
+    // location numbers are consecutive within a function
+    const unsigned first_location = body.instructions.front().location_number;
+
+    forall_goto_program_instructions(i_it, body)
+    {
+      result = hash_combine(result, static_cast<std::size_t>(i_it->type()));
+      result = hash_combine(result, hasher(i_it->code()));
+      if(i_it->has_condition())
+        result = hash_combine(result, hasher(i_it->condition()));
+      for(const auto &target : i_it->targets)
+      {
+        result =
+          hash_combine(result, target->location_number - first_location);
+      }
+    }
+  }
+
+  return std::to_string(result);
+}
+
+/// Read the results stored in \p file_name if they were computed with the
+/// configuration \p configuration.
+static std::map<irep_idt, function_resultst> read_results(
+  const std::string &file_name,
+  const std::string &configuration,
+  message_handlert &message_handler)
+{
+  messaget m(message_handler);
+  std::map<irep_idt, function_resultst> results;
+
+  std::ifstream in(file_name);
+  if(!in)
+  {
+    m.status() << "No previous results in " << file_name << messaget::eom;
+    return results;
+  }
+
+  jsont json;
+  if(
+    parse_json(in, file_name, message_handler, json) || !json.is_object() ||
+    json["version"].value != results_file_version)
+  {
+    m.warning() << "Ignoring previous results in " << file_name
+                << ": unrecognised format" << messaget::eom;
+    return results;
+  }
+
+  if(json["configuration"].value != configuration)
+  {
+    m.status() << "Ignoring previous results in " << file_name
+               << ": options or type definitions have changed"
+               << messaget::eom;
+    return results;
+  }
+
+  const jsont &functions = json["functions"];
+  if(!functions.is_object())
+    return results;
+
+  for(const auto &entry : to_json_object(functions))
+  {
+    const jsont &statuses = entry.second["statuses"];
+    if(!statuses.is_array())
+      continue;
+
+    function_resultst function_results;
+    function_results.hash = entry.second["hash"].value;
+
+    bool valid = true;
+    for(const auto &status : to_json_array(statuses))
+    {
+      const auto number = string2optional_unsigned(status.value);
+      if(
+        !number.has_value() ||
+        *number > static_cast<unsigned>(ai_verifier_statust::UNKNOWN))
+      {
+        valid = false;
+        break;
+      }
+      function_results.statuses.push_back(
+        static_cast<ai_verifier_statust>(*number));
+    }
+
+    if(valid)
+      results.emplace(entry.first, std::move(function_results));
+  }
+
+  return results;
+}
+
+/// Write \p results to \p file_name, reporting failure as a warning
+static void write_results(
+  const std::string &file_name,
+  const std::string &configuration,
+  const std::map<irep_idt, function_resultst> &results,
+  message_handlert &message_handler)
+{
+  json_objectt functions;
+  for(const auto &entry : results)
+  {
+    json_arrayt statuses;
+    for(const auto status : entry.second.statuses)
+    {
+      statuses.push_back(
+        json_numbert{std::to_string(static_cast<unsigned>(status))});
+    }
+
+    functions[id2string(entry.first)] =
+      json_objectt{{"hash", json_stringt{entry.second.hash}},
+                   {"statuses", std::move(statuses)}};
+  }
+
+  const json_objectt json{{"version", json_stringt{results_file_version}},
+                          {"configuration", json_stringt{configuration}},
+                          {"functions", std::move(functions)}};
+
+  std::ofstream out(file_name);
+  out << json << '\n';
+  if(!out.good())
+  {
+    messaget m(message_handler);
+    m.warning() << "failed to write the results to " << file_name
+                << messaget::eom;
+  }
+}
+
+bool incremental_static_verifier(
+  const goto_modelt &goto_model,
+  ai_function_localt &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  messaget m(message_handler);
+  const namespacet ns(goto_model.symbol_table);
+  const std::string file_name = options.get_option("incremental");
+
+  stable_irep_hashert hasher;
+  const std::string configuration =
+    configuration_hash(goto_model, options, hasher);
+  const std::map<irep_idt, function_resultst> previous_results =
+    read_results(file_name, configuration, message_handler);
+
+  // Determine the functions whose results cannot be reused
+  std::map<irep_idt, function_resultst> new_results;
+  std::vector<irep_idt> changed_functions;
+  std::size_t reused_functions = 0;
+
+  for(const auto &f : goto_model.goto_functions.function_map)
+  {
+    if(!f.second.body.has_assertion())
+      continue;
+
+    function_resultst &function_results = new_results[f.first];
+    function_results.hash = function_hash(f.first, f.second, ns, hasher);
+
+    std::size_t assertions = 0;
+    forall_goto_program_instructions(i_it, f.second.body)
+    {
+      if(i_it->is_assert())
+        ++assertions;
+    }
+
+    const auto previous = previous_results.find(f.first);
+    if(
+      previous != previous_results.end() &&
+      previous->second.hash == function_results.hash &&
+      previous->second.statuses.size() == assertions)
+    {
+      function_results.statuses = previous->second.statuses;
+      ++reused_functions;
+    }
+    else
+      changed_functions.push_back(f.first);
+  }
+
+  m.status() << "Reusing the results of " << reused_functions << " of "
+             << new_results.size() << " functions" << messaget::eom;
+
+  ai(changed_functions, goto_model.goto_functions, ns);
+
+  std::vector<static_verifier_resultt> results;
+
+  for(auto &entry : new_results)
+  {
+    const goto_programt &body =
+      goto_model.goto_functions.function_map.at(entry.first).body;
+    const bool changed = entry.second.statuses.empty();
+    std::size_t assertion = 0;
+
+    forall_goto_program_instructions(i_it, body)
+    {
+      if(!i_it->is_assert())
+        continue;
+
+      if(changed)
+      {
+        const static_verifier_resultt result(ai, i_it, entry.first, ns);
+        entry.second.statuses.push_back(result.status);
+      }
+
+      results.emplace_back(
+        entry.second.statuses[assertion],
+        i_it->source_location(),
+        entry.first);
+      ++assertion;
+    }
+  }
+
+  write_results(file_name, configuration, new_results, message_handler);
+
+  static_verifier_report(results, ns, options, message_handler, out);
+
+  return false;
+}
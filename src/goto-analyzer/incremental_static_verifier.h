@@ -0,0 +1,44 @@
+/*******************************************************************\
+
+Module: goto-analyzer
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Checking assertions, reusing the results of unchanged functions
+
+#ifndef CPROVER_GOTO_ANALYZER_INCREMENTAL_STATIC_VERIFIER_H
+#define CPROVER_GOTO_ANALYZER_INCREMENTAL_STATIC_VERIFIER_H
+
+#include <iosfwd>
+
+class ai_function_localt;
+class goto_modelt;
+class message_handlert;
+class optionst;
+
+/// Check the assertions of \p goto_model as \ref static_verifier does, reusing
+/// the results of the previous run for functions that have not changed since.
+/// The results of the functions that contain assertions are stored in the
+/// file given by the `incremental` option, together with a hash of each
+/// function. As \p ai analyses each function on its own, the results of a
+/// function only depend on its body, the type definitions of the program and
+/// the options, hence only functions whose hash differs from the stored one
+/// are analysed. The histories in which an assertion fails are not reported.
+/// \param goto_model: the program to verify
+/// \param ai: the abstract interpreter, which must not have been run yet
+/// \param options: the parsed user options
+/// \param message_handler: the system message handler
+/// \param out: output stream for the results
+/// \return false, a results file that cannot be read or written only causes
+///   all functions to be analysed or is reported as a warning, respectively
+bool incremental_static_verifier(
+  const goto_modelt &goto_model,
+  ai_function_localt &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out);
+
+#endif // CPROVER_GOTO_ANALYZER_INCREMENTAL_STATIC_VERIFIER_H
@@ -0,0 +1,213 @@
+/*******************************************************************\
+
+Module: goto-analyzer
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Checking assertions with several processes
+
+#include "parallel_static_verifier.h"
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/options.h>
+#include <util/run_in_processes.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/ai_function_local.h>
+
+#include "static_verifier.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+/// A set of functions that one worker analyses
+struct static_verifier_jobt
+{
+  std::vector<irep_idt> function_ids;
+  std::size_t instructions = 0;
+};
+
+/// Distribute the functions of \p goto_functions that contain assertions over
+/// \p number_of_jobs jobs, giving the largest remaining function to the job
+/// with the fewest instructions so far.
+static std::vector<static_verifier_jobt> make_jobs(
+  const goto_functionst &goto_functions,
+  std::size_t number_of_jobs)
+{
+  PRECONDITION(number_of_jobs > 0);
+
+  std::vector<goto_functionst::function_mapt::const_iterator> functions;
+  for(auto f_it = goto_functions.function_map.begin();
+      f_it != goto_functions.function_map.end();
+      ++f_it)
+  {
+    if(f_it->second.body.has_assertion())
+      functions.push_back(f_it);
+  }
+
+  std::stable_sort(
+    functions.begin(),
+    functions.end(),
+    [](
+      goto_functionst::function_mapt::const_iterator a,
+      goto_functionst::function_mapt::const_iterator b) {
+      return a->second.body.instructions.size() >
+             b->second.body.instructions.size();
+    });
+
+  std::vector<static_verifier_jobt> jobs(
+    std::min(number_of_jobs, functions.size()));
+  for(const auto &f_it : functions)
+  {
+    static_verifier_jobt &job = *std::min_element(
+      jobs.begin(),
+      jobs.end(),
+      [](const static_verifier_jobt &a, const static_verifier_jobt &b) {
+        return a.instructions < b.instructions;
+      });
+    job.function_ids.push_back(f_it->first);
+    job.instructions += f_it->second.body.instructions.size();
+  }
+
+  return jobs;
+}
+
+#ifndef _WIN32
+/// Analyse the functions of \p job and write the status of each of their
+/// assertions, in order, to \p file_name.
+/// \return true on failure
+static bool run_job(
+  const static_verifier_jobt &job,
+  const goto_modelt &goto_model,
+  ai_function_localt &ai,
+  const std::string &file_name)
+{
+  const namespacet ns(goto_model.symbol_table);
+
+  ai(job.function_ids, goto_model.goto_functions, ns);
+
+  std::ofstream out(file_name);
+  for(const irep_idt &function_id : job.function_ids)
+  {
+    const goto_programt &body =
+      goto_model.goto_functions.function_map.at(function_id).body;
+    forall_goto_program_instructions(i_it, body)
+    {
+      if(!i_it->is_assert())
+        continue;
+
+      const static_verifier_resultt result(ai, i_it, function_id, ns);
+      out << static_cast<int>(result.status) << '\n';
+    }
+  }
+
+  return !out.good();
+}
+#endif
+
+bool parallel_static_verifier(
+  const goto_modelt &goto_model,
+  ai_function_localt &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  messaget m(message_handler);
+
+#ifdef _WIN32
+  m.warning() << "parallel verification is not supported on Windows,"
+              << " using a single process" << messaget::eom;
+
+  ai(goto_model);
+  return static_verifier(goto_model, ai, options, message_handler, out);
+#else
+  const std::vector<static_verifier_jobt> jobs = make_jobs(
+    goto_model.goto_functions, options.get_unsigned_int_option("jobs"));
+
+  m.status() << "Checking assertions with " << jobs.size() << " processes"
+             << messaget::eom;
+
+  std::vector<temporary_filet> files;
+  for(const static_verifier_jobt &job : jobs)
+  {
+    m.progress() << "Starting a process for " << job.function_ids.size()
+                 << " functions with " << job.instructions << " instructions"
+                 << messaget::eom;
+    files.emplace_back("goto_analyzer_results_", ".txt");
+  }
+
+  const std::vector<bool> failed = run_in_processes(
+    files, [&](std::size_t job, const std::string &file_name) {
+      return run_job(jobs[job], goto_model, ai, file_name);
+    });
+
+  bool error = false;
+  for(std::size_t i = 0; i < jobs.size(); ++i)
+  {
+    if(failed[i])
+    {
+      m.error() << "verification process " << i + 1 << " of " << jobs.size()
+                << " failed" << messaget::eom;
+      error = true;
+    }
+  }
+
+  if(error)
+    return true;
+
+  // Collect the results of the workers in the order static_verifier reports
+  // them, that is, by function
+  const namespacet ns(goto_model.symbol_table);
+  std::map<irep_idt, std::vector<static_verifier_resultt>> results_by_function;
+
+  for(std::size_t i = 0; i < jobs.size(); ++i)
+  {
+    std::ifstream in(files[i]());
+
+    for(const irep_idt &function_id : jobs[i].function_ids)
+    {
+      std::vector<static_verifier_resultt> &function_results =
+        results_by_function[function_id];
+      const goto_programt &body =
+        goto_model.goto_functions.function_map.at(function_id).body;
+      forall_goto_program_instructions(i_it, body)
+      {
+        if(!i_it->is_assert())
+          continue;
+
+        int status;
+        if(!(in >> status))
+        {
+          m.error() << "failed to read the results of verification process "
+                    << i + 1 << " of " << jobs.size() << messaget::eom;
+          return true;
+        }
+
+        function_results.emplace_back(
+          static_cast<ai_verifier_statust>(status),
+          i_it->source_location(),
+          function_id);
+      }
+    }
+  }
+
+  std::vector<static_verifier_resultt> results;
+  for(auto &entry : results_by_function)
+  {
+    std::move(
+      entry.second.begin(), entry.second.end(), std::back_inserter(results));
+  }
+
+  static_verifier_report(results, ns, options, message_handler, out);
+
+  return false;
+#endif
+}
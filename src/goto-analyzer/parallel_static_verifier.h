@@ -0,0 +1,42 @@
+/*******************************************************************\
+
+Module: goto-analyzer
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Checking assertions with several processes
+
+#ifndef CPROVER_GOTO_ANALYZER_PARALLEL_STATIC_VERIFIER_H
+#define CPROVER_GOTO_ANALYZER_PARALLEL_STATIC_VERIFIER_H
+
+#include <iosfwd>
+
+class ai_function_localt;
+class goto_modelt;
+class message_handlert;
+class optionst;
+
+/// Check the assertions of \p goto_model as \ref static_verifier does, using
+/// the number of worker processes given by the `jobs` option. The functions
+/// that contain assertions are distributed over the workers by their number
+/// of instructions, each of which runs \p ai on its functions and reports the
+/// status of their assertions. As \p ai analyses each function on its own,
+/// the result is the same as that of a single process. The histories in which
+/// an assertion fails are not reported.
+/// \param goto_model: the program to verify
+/// \param ai: the abstract interpreter, which must not have been run yet
+/// \param options: the parsed user options
+/// \param message_handler: the system message handler
+/// \param out: output stream for the results
+/// \return true if a worker failed
+bool parallel_static_verifier(
+  const goto_modelt &goto_model,
+  ai_function_localt &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out);
+
+#endif // CPROVER_GOTO_ANALYZER_PARALLEL_STATIC_VERIFIER_H
@@ -393,6 +393,60 @@ static void static_verifier_console(
     m.result() << '\n';
 }
 
+void static_verifier_report(
+  const std::vector<static_verifier_resultt> &results,
+  const namespacet &ns,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  std::size_t pass = 0, fail = 0, unknown = 0;
+
+  messaget m(message_handler);
+
+  for(const auto &result : results)
+  {
+    switch(result.status)
+    {
+    case ai_verifier_statust::NOT_REACHABLE:
+      ++pass;
+      break;
+    case ai_verifier_statust::TRUE:
+      ++pass;
+      break;
+    case ai_verifier_statust::FALSE_IF_REACHABLE:
+      ++fail;
+      break;
+    case ai_verifier_statust::UNKNOWN:
+      ++unknown;
+      break;
+    default:
+      UNREACHABLE;
+    }
+  }
+
+  if(options.get_bool_option("json"))
+  {
+    static_verifier_json(results, m, out);
+  }
+  else if(options.get_bool_option("xml"))
+  {
+    static_verifier_xml(results, m, out);
+  }
+  else if(options.get_bool_option("text"))
+  {
+    static_verifier_text(results, ns, out);
+  }
+  else
+  {
+    static_verifier_console(results, ns, m);
+  }
+
+  m.status() << m.bold << "Summary: " << pass << " pass, " << fail
+             << " fail if reachable, " << unknown << " unknown" << m.reset
+             << messaget::eom;
+}
+
 /// Runs the analyzer and then prints out the domain
 /// \param goto_model: the program analyzed
 /// \param ai: the abstract interpreter after it has been run to fix point
@@ -407,8 +461,6 @@ bool static_verifier(
   message_handlert &message_handler,
   std::ostream &out)
 {
-  std::size_t pass = 0, fail = 0, unknown = 0;
-
   namespacet ns(goto_model.symbol_table);
 
   messaget m(message_handler);
@@ -431,47 +483,10 @@ bool static_verifier(
         continue;
 
       results.push_back(static_verifier_resultt(ai, i_it, f.first, ns));
-
-      switch(results.back().status)
-      {
-      case ai_verifier_statust::NOT_REACHABLE:
-        ++pass;
-        break;
-      case ai_verifier_statust::TRUE:
-        ++pass;
-        break;
-      case ai_verifier_statust::FALSE_IF_REACHABLE:
-        ++fail;
-        break;
-      case ai_verifier_statust::UNKNOWN:
-        ++unknown;
-        break;
-      default:
-        UNREACHABLE;
-      }
     }
   }
 
-  if(options.get_bool_option("json"))
-  {
-    static_verifier_json(results, m, out);
-  }
-  else if(options.get_bool_option("xml"))
-  {
-    static_verifier_xml(results, m, out);
-  }
-  else if(options.get_bool_option("text"))
-  {
-    static_verifier_text(results, ns, out);
-  }
-  else
-  {
-    static_verifier_console(results, ns, m);
-  }
-
-  m.status() << m.bold << "Summary: " << pass << " pass, " << fail
-             << " fail if reachable, " << unknown << " unknown" << m.reset
-             << messaget::eom;
+  static_verifier_report(results, ns, options, message_handler, out);
 
   return false;
 }
@@ -12,6 +12,7 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #include <goto-checker/properties.h>
 
 #include <iosfwd>
+#include <vector>
 
 #include <analyses/ai_history.h>
 
@@ -78,8 +79,29 @@ class static_verifier_resultt
     irep_idt func_id,
     const namespacet &ns);
 
+  /// A result that has been computed elsewhere, for example in another
+  /// process, without the histories that it was computed from
+  static_verifier_resultt(
+    ai_verifier_statust status,
+    source_locationt source_location,
+    irep_idt function_id)
+    : status(status),
+      source_location(std::move(source_location)),
+      function_id(std::move(function_id))
+  {
+  }
+
   jsont output_json(void) const;
   xmlt output_xml(void) const;
 };
 
+/// Output \p results in the format selected by \p options, followed by a
+/// summary of the number of assertions with each status
+void static_verifier_report(
+  const std::vector<static_verifier_resultt> &results,
+  const namespacet &ns,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out);
+
 #endif // CPROVER_GOTO_ANALYZER_STATIC_VERIFIER_H
@@ -12,6 +12,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include "bmc_util.h"
 
 #include <iostream>
+#include <unordered_set>
 
 #include <goto-programs/graphml_witness.h>
 #include <goto-programs/json_goto_trace.h>
@@ -30,6 +31,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <util/make_unique.h>
 #include <util/ui_message.h>
 
+#include "cover_goals_subsumption.h"
 #include "goto_symex_property_decider.h"
 #include "symex_bmc.h"
 
@@ -320,6 +322,45 @@ void output_coverage_report(
   }
 }
 
+void output_symex_profile(
+  const std::string &profile_out,
+  const goto_symext &symex,
+  ui_message_handlert &ui_message_handler)
+{
+  if(!profile_out.empty() && symex.output_profile(profile_out))
+  {
+    messaget log(ui_message_handler);
+    log.error() << "Failed to write symex profile to '" << profile_out << "'"
+                << messaget::eom;
+  }
+}
+
+/// Number of distinct subexpressions of the guards of all steps in
+/// \p equation, which measures the size of the guards independently of
+/// sharing between them.
+static std::size_t guards_size(const symex_target_equationt &equation)
+{
+  std::unordered_set<exprt, irep_hash> seen;
+  std::vector<const exprt *> stack;
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    stack.push_back(&step.guard);
+    while(!stack.empty())
+    {
+      const exprt &expr = *stack.back();
+      stack.pop_back();
+      if(seen.insert(expr).second)
+      {
+        for(const auto &op : expr.operands())
+          stack.push_back(&op);
+      }
+    }
+  }
+
+  return seen.size();
+}
+
 void postprocess_equation(
   symex_bmct &symex,
   symex_target_equationt &equation,
@@ -328,6 +369,15 @@ void postprocess_equation(
   ui_message_handlert &ui_message_handler)
 {
   const auto postprocess_equation_start = std::chrono::steady_clock::now();
+
+  // these need the expressions of all steps
+  if(
+    equation.has_threads() || options.get_bool_option("slice-formula") ||
+    options.get_bool_option("validate-ssa-equation"))
+  {
+    equation.restore_spilled_steps();
+  }
+
   // add a partial ordering, if required
   if(equation.has_threads())
   {
@@ -339,6 +389,13 @@ void postprocess_equation(
   messaget log(ui_message_handler);
   log.statistics() << "size of program expression: "
                    << equation.SSA_steps.size() << " steps" << messaget::eom;
+  if(
+    ui_message_handler.get_verbosity() >= messaget::M_STATISTICS &&
+    !equation.has_spilled_steps())
+  {
+    log.statistics() << "size of guards: " << guards_size(equation)
+                     << " distinct subexpressions" << messaget::eom;
+  }
 
   slice(symex, equation, ns, options, ui_message_handler);
 
@@ -423,3 +480,76 @@ void run_property_decider(
     result.progress = incremental_goto_checkert::resultt::progresst::FOUND_FAIL;
   }
 }
+
+void run_property_decider_with_subsumption(
+  incremental_goto_checkert::resultt &result,
+  propertiest &properties,
+  goto_symex_property_decidert &property_decider,
+  const cover_goals_subsumptiont &subsumption,
+  ui_message_handlert &ui_message_handler,
+  std::chrono::duration<double> solver_runtime)
+{
+  auto solver_start = std::chrono::steady_clock::now();
+
+  messaget log(ui_message_handler);
+  log.status()
+    << "Running "
+    << property_decider.get_decision_procedure().decision_procedure_text()
+    << messaget::eom;
+
+  decision_proceduret::resultt dec_result =
+    decision_proceduret::resultt::D_UNSATISFIABLE;
+
+  while(has_properties_to_check(properties))
+  {
+    const std::unordered_set<irep_idt> targets =
+      subsumption.get_targets(properties);
+
+    log.statistics() << "Targeting " << targets.size() << " goals"
+                     << messaget::eom;
+
+    auto const sat_solver_start = std::chrono::steady_clock::now();
+
+    dec_result = property_decider.solve_selected(
+      [&targets](const irep_idt &property_id) {
+        return targets.count(property_id) != 0;
+      });
+
+    auto const sat_solver_stop = std::chrono::steady_clock::now();
+    std::chrono::duration<double> sat_solver_runtime =
+      std::chrono::duration<double>(sat_solver_stop - sat_solver_start);
+    log.status() << "Runtime Solver: " << sat_solver_runtime.count() << "s"
+                 << messaget::eom;
+
+    if(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE)
+      break;
+
+    // none of the targets can be covered, but the goals they subsume may
+    for(const auto &property_id : targets)
+    {
+      properties.at(property_id).status |= property_statust::PASS;
+      result.updated_properties.insert(property_id);
+    }
+  }
+
+  const std::size_t failed_before =
+    count_properties(properties, property_statust::FAIL);
+
+  property_decider.update_properties_status_from_goals(
+    properties, result.updated_properties, dec_result, false);
+
+  auto solver_stop = std::chrono::steady_clock::now();
+  solver_runtime += std::chrono::duration<double>(solver_stop - solver_start);
+  log.status() << "Runtime decision procedure: " << solver_runtime.count()
+               << "s" << messaget::eom;
+
+  if(dec_result == decision_proceduret::resultt::D_SATISFIABLE)
+  {
+    log.status() << "Covered "
+                 << count_properties(properties, property_statust::FAIL) -
+                      failed_before
+                 << " goals with one model" << messaget::eom;
+
+    result.progress = incremental_goto_checkert::resultt::progresst::FOUND_FAIL;
+  }
+}
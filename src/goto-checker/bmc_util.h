@@ -21,8 +21,10 @@ Author: Daniel Kroening, Peter Schrammel
 #include <chrono> // IWYU pragma: keep
 #include <memory>
 
+class cover_goals_subsumptiont;
 class decision_proceduret;
 class goto_symex_property_decidert;
+class goto_symext;
 class goto_tracet;
 class memory_model_baset;
 class message_handlert;
@@ -105,6 +107,16 @@ void output_coverage_report(
   const symex_bmct &symex,
   ui_message_handlert &ui_message_handler);
 
+/// Output the report of \ref symex_profilert if \p profile_out is non-empty.
+/// \param profile_out: file to write the report to; no report is generated
+///   if this is empty
+/// \param symex: symbolic execution run to report on
+/// \param ui_message_handler: status/warning message handler
+void output_symex_profile(
+  const std::string &profile_out,
+  const goto_symext &symex,
+  ui_message_handlert &ui_message_handler);
+
 /// Sets property status to PASS for properties whose
 /// conditions are constant true in the \p equation.
 /// \param [in,out] properties: The status is updated in this data structure
@@ -169,6 +181,27 @@ void run_property_decider(
   std::chrono::duration<double> solver_runtime,
   bool set_pass = true);
 
+/// Runs the property decider to find a model that violates one of the
+/// properties that \p subsumption selects as targets. If there is none, the
+/// targets are set to PASS and the decider is run on the next targets, until
+/// a model is found or no properties are left to check. All properties
+/// violated by the model are set to FAIL.
+/// \param [in,out] result: For recording the progress and the updated
+///   properties
+/// \param [in,out] properties: The status will be updated
+/// \param [in,out] property_decider: The property decider that will solve the
+///   equation, which must support solving selected properties
+/// \param subsumption: Selects the properties to target
+/// \param [in,out] ui_message_handler: For logging
+/// \param solver_runtime: The solver runtime will be added and output
+void run_property_decider_with_subsumption(
+  incremental_goto_checkert::resultt &result,
+  propertiest &properties,
+  goto_symex_property_decidert &property_decider,
+  const cover_goals_subsumptiont &subsumption,
+  ui_message_handlert &ui_message_handler,
+  std::chrono::duration<double> solver_runtime);
+
 // clang-format off
 #define OPT_BMC \
   "(program-only)" \
@@ -186,6 +219,7 @@ void run_property_decider(
   "(depth):" \
   "(max-field-sensitivity-array-size):" \
   "(no-array-field-sensitivity)" \
+  "(sparse-array-field-sensitivity)" \
   "(graphml-witness):" \
   "(symex-complexity-limit):" \
   "(symex-complexity-failed-child-loops-limit):" \
@@ -194,6 +228,10 @@ void run_property_decider(
   "(unwind-max):" \
   "(ignore-properties-before-unwind-min)" \
   "(symex-cache-dereferences)" \
+  "(symex-points-to-oracle)" \
+  "(symex-guards):" \
+  "(symex-spill-steps):" \
+  "(symex-profile):" \
   OPT_UNWINDSET \
 
 #define HELP_BMC \
@@ -215,6 +253,9 @@ void run_property_decider(
   "this is\n" \
   "                              equivalent to setting the maximum field \n" \
   "                              sensitivity size for arrays to 0\n" \
+  " --sparse-array-field-sensitivity\n" \
+  "                              apply field sensitivity to cells of larger\n" \
+  "                              arrays that are accessed at constant indices\n" \
   HELP_UNWINDSET \
   " --incremental-loop L         check properties after each unwinding\n" \
   "                              of loop L\n" \
@@ -244,7 +285,17 @@ void run_property_decider(
   "                              iteration are allowed to fail due to\n" \
   "                              complexity violations before the loop\n" \
   "                              gets blacklisted\n" \
+  " --symex-guards bdd|expr      represent path conditions as binary decision\n" \
+  "                              diagrams or as conjunctions of expressions\n" \
+  " --symex-spill-steps N        keep the expressions of at most N SSA steps in\n" \
+  "                              memory and write older ones to a temporary\n" \
+  "                              file until they are converted\n" \
+  " --symex-profile f            write the time and work of symbolic execution\n" \
+  "                              per function, loop and call stack to f as JSON\n" \
   " --graphml-witness filename   write the witness in GraphML format to filename\n" /* NOLINT(*) */ \
+  " --symex-points-to-oracle     track the values of local pointers only and\n" \
+  "                              use a flow-insensitive analysis of the\n" \
+  "                              program for other pointers\n" \
   " --symex-cache-dereferences   enable caching of repeated dereferences" \
 // clang-format on
 
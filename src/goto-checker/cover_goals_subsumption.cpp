@@ -0,0 +1,216 @@
+/*******************************************************************\
+
+Module: Subsumption between Coverage Goals
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Subsumption between Coverage Goals
+
+#include "cover_goals_subsumption.h"
+
+#include <util/std_expr.h>
+
+#include <analyses/cfg_dominators.h>
+
+#include <algorithm>
+
+/// Returns the program point whose execution covers the goal of
+/// \p assertion: the assertion itself if it is a reachability goal, or the
+/// successor of a conditional jump that immediately follows the assertion if
+/// the assertion is violated exactly when that successor is taken
+static optionalt<goto_programt::const_targett> covering_point(
+  const goto_programt &goto_program,
+  const cfg_dominatorst &dominators,
+  const goto_programt::const_targett assertion)
+{
+  if(assertion->condition().is_false())
+    return assertion;
+
+  // branch coverage places its assertions right before the jump
+  auto jump = std::next(assertion);
+  while(jump != goto_program.instructions.end() &&
+        (jump->is_assert() || jump->is_skip()))
+  {
+    ++jump;
+  }
+
+  if(
+    jump == goto_program.instructions.end() || !jump->is_goto() ||
+    jump->condition().is_true() ||
+    jump->get_target() == std::next(jump))
+  {
+    return {};
+  }
+
+  goto_programt::const_targett successor;
+  if(assertion->condition() == not_exprt(jump->condition()))
+    successor = jump->get_target();
+  else if(assertion->condition() == jump->condition())
+    successor = std::next(jump);
+  else
+    return {};
+
+  // the successor must not be reachable other than via the jump
+  if(successor == goto_program.instructions.begin())
+    return {};
+
+  const auto &predecessors = dominators.get_node(successor).in;
+  if(
+    predecessors.size() != 1 ||
+    predecessors.begin()->first != dominators.get_node_index(jump))
+  {
+    return {};
+  }
+
+  return successor;
+}
+
+cover_goals_subsumptiont::cover_goals_subsumptiont(
+  const goto_functionst &goto_functions,
+  const propertiest &properties)
+  : subsumable_goals(0)
+{
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    const goto_programt &goto_program = gf_entry.second.body;
+
+    std::vector<goto_programt::const_targett> assertions;
+    for(auto it = goto_program.instructions.begin();
+        it != goto_program.instructions.end();
+        ++it)
+    {
+      if(
+        it->is_assert() &&
+        properties.find(it->source_location().get_property_id()) !=
+          properties.end())
+      {
+        assertions.push_back(it);
+      }
+    }
+
+    if(assertions.empty())
+      continue;
+
+    cfg_dominatorst dominators;
+    dominators(goto_program);
+
+    std::vector<goalt> goals;
+    goals.reserve(assertions.size());
+    for(const auto &assertion : assertions)
+    {
+      const auto &node = dominators.get_node(assertion);
+      if(!dominators.program_point_reachable(node))
+        continue;
+
+      goalt goal;
+      goal.property_id = assertion->source_location().get_property_id();
+      goal.position = node.dfs_begin;
+      goal.has_covering_point = false;
+      goal.dominated_begin = 0;
+      goal.dominated_end = 0;
+
+      const auto point = covering_point(goto_program, dominators, assertion);
+      if(point.has_value())
+      {
+        const auto &point_node = dominators.get_node(*point);
+        if(dominators.program_point_reachable(point_node))
+        {
+          goal.has_covering_point = true;
+          goal.dominated_begin = point_node.dfs_begin;
+          goal.dominated_end = point_node.dfs_end;
+        }
+      }
+
+      goals.push_back(goal);
+    }
+
+    if(!goals.empty())
+      functions.push_back(std::move(goals));
+  }
+
+  std::unordered_set<irep_idt> subsumed;
+  std::vector<const goalt *> all_goals;
+  for(const auto &goals : functions)
+  {
+    all_goals.clear();
+    for(const auto &goal : goals)
+      all_goals.push_back(&goal);
+    subsumed_goals(all_goals, subsumed);
+  }
+  subsumable_goals = subsumed.size();
+}
+
+std::unordered_set<irep_idt>
+cover_goals_subsumptiont::get_targets(const propertiest &properties) const
+{
+  std::unordered_set<irep_idt> targets;
+  for(const auto &property_pair : properties)
+  {
+    if(is_property_to_check(property_pair.second.status))
+      targets.insert(property_pair.first);
+  }
+
+  std::unordered_set<irep_idt> subsumed;
+  std::vector<const goalt *> active_goals;
+  for(const auto &goals : functions)
+  {
+    active_goals.clear();
+    for(const auto &goal : goals)
+    {
+      if(targets.count(goal.property_id) != 0)
+        active_goals.push_back(&goal);
+    }
+    subsumed_goals(active_goals, subsumed);
+  }
+
+  // goals that subsume each other must not all be dropped
+  if(subsumed.size() < targets.size())
+  {
+    for(const auto &property_id : subsumed)
+      targets.erase(property_id);
+  }
+
+  return targets;
+}
+
+std::size_t cover_goals_subsumptiont::number_of_subsumable_goals() const
+{
+  return subsumable_goals;
+}
+
+void cover_goals_subsumptiont::subsumed_goals(
+  const std::vector<const goalt *> &goals,
+  std::unordered_set<irep_idt> &subsumed)
+{
+  std::vector<std::size_t> positions;
+  positions.reserve(goals.size());
+  for(const auto goal : goals)
+    positions.push_back(goal->position);
+  std::sort(positions.begin(), positions.end());
+
+  for(const auto goal : goals)
+  {
+    if(!goal->has_covering_point)
+      continue;
+
+    const auto begin = std::lower_bound(
+      positions.begin(), positions.end(), goal->dominated_begin);
+    const auto end =
+      std::lower_bound(begin, positions.end(), goal->dominated_end);
+    std::size_t dominated = static_cast<std::size_t>(end - begin);
+
+    // the goal's own assertion does not count
+    if(
+      goal->dominated_begin <= goal->position &&
+      goal->position < goal->dominated_end)
+    {
+      --dominated;
+    }
+
+    if(dominated > 0)
+      subsumed.insert(goal->property_id);
+  }
+}
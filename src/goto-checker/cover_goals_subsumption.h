@@ -0,0 +1,77 @@
+/*******************************************************************\
+
+Module: Subsumption between Coverage Goals
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Subsumption between Coverage Goals
+
+#ifndef CPROVER_GOTO_CHECKER_COVER_GOALS_SUBSUMPTION_H
+#define CPROVER_GOTO_CHECKER_COVER_GOALS_SUBSUMPTION_H
+
+#include "properties.h"
+
+#include <unordered_set>
+#include <vector>
+
+class goto_functionst;
+
+/// Relates the coverage goals of a program such that the solver only needs to
+/// target goals that are not implied by other goals. A goal is covered once
+/// an execution reaches its covering point: the goal's assertion if its
+/// condition is false (e.g. location coverage), or the successor of the
+/// conditional jump that follows the assertion if that jump is the only
+/// predecessor of the successor (branch coverage). A goal is subsumed by
+/// another goal of the same function if its covering point dominates the
+/// assertion of the other goal, as then every execution that covers the other
+/// goal also covers this one.
+class cover_goals_subsumptiont
+{
+public:
+  /// Computes the dominators of the functions in \p goto_functions that
+  /// contain assertions of \p properties
+  cover_goals_subsumptiont(
+    const goto_functionst &goto_functions,
+    const propertiest &properties);
+
+  /// Returns the IDs of the properties to check in \p properties that are not
+  /// subsumed by another property to check. If each of them is subsumed,
+  /// which happens when goals subsume each other, all of them are returned.
+  std::unordered_set<irep_idt> get_targets(const propertiest &properties) const;
+
+  /// Returns the number of goals whose covering point dominates the
+  /// assertion of some other goal
+  std::size_t number_of_subsumable_goals() const;
+
+protected:
+  struct goalt
+  {
+    irep_idt property_id;
+    /// Pre-order number of the assertion in the dominator tree
+    std::size_t position;
+    /// Whether the goal has a reachable covering point
+    bool has_covering_point;
+    /// The pre-order numbers of the program points that the covering point
+    /// dominates, which is `[dominated_begin, dominated_end)`
+    std::size_t dominated_begin;
+    std::size_t dominated_end;
+  };
+
+  /// The goals of each function with a reachable assertion
+  std::vector<std::vector<goalt>> functions;
+
+  /// The number of goals whose covering point dominates the assertion of
+  /// another goal when all goals are still to be checked
+  std::size_t subsumable_goals;
+
+  /// Adds the IDs of those \p goals that are subsumed by one of the other
+  /// \p goals to \p subsumed
+  static void subsumed_goals(
+    const std::vector<const goalt *> &goals,
+    std::unordered_set<irep_idt> &subsumed);
+};
+
+#endif // CPROVER_GOTO_CHECKER_COVER_GOALS_SUBSUMPTION_H
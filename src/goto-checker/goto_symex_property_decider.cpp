@@ -103,6 +103,47 @@ decision_proceduret::resultt goto_symex_property_decidert::solve()
   return solver->decision_procedure()();
 }
 
+decision_proceduret::resultt goto_symex_property_decidert::solve_selected(
+  std::function<bool(const irep_idt &)> select_property)
+{
+  exprt::operandst disjuncts;
+
+  for(const auto &goal_pair : goal_map)
+  {
+    if(
+      select_property(goal_pair.first) &&
+      !goal_pair.second.condition.is_false())
+    {
+      disjuncts.push_back(goal_pair.second.condition);
+    }
+  }
+
+  stack_decision_proceduret &stack_decision_procedure =
+    solver->stack_decision_procedure();
+  const exprt goal = stack_decision_procedure.handle(disjunction(disjuncts));
+
+  // the handle may be a constant, which cannot be assumed
+  if(goal.is_false())
+    return decision_proceduret::resultt::D_UNSATISFIABLE;
+  if(goal.is_true())
+    return stack_decision_procedure();
+
+  stack_decision_procedure.push({goal});
+  const decision_proceduret::resultt dec_result = stack_decision_procedure();
+  stack_decision_procedure.pop();
+
+  return dec_result;
+}
+
+bool goto_symex_property_decidert::can_solve_selected() const
+{
+  const auto stack_decision_procedure =
+    dynamic_cast<const stack_decision_proceduret *>(
+      &solver->decision_procedure());
+  return stack_decision_procedure != nullptr &&
+         stack_decision_procedure->can_push_assumptions();
+}
+
 decision_proceduret &
 goto_symex_property_decidert::get_decision_procedure() const
 {
@@ -44,6 +44,16 @@ class goto_symex_property_decidert
   /// Calls solve() on the solver instance
   decision_proceduret::resultt solve();
 
+  /// Calls solve() on the solver instance under the assumption that one of
+  /// the selected properties is violated. Unlike add_constraint_from_goals,
+  /// this leaves the formula unchanged for subsequent calls.
+  /// Requires a stack decision procedure.
+  decision_proceduret::resultt solve_selected(
+    std::function<bool(const irep_idt &property_id)> select_property);
+
+  /// Returns true if solve_selected is supported by the solver instance
+  bool can_solve_selected() const;
+
   /// Returns the solver instance
   decision_proceduret &get_decision_procedure() const;
 
@@ -11,6 +11,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "multi_path_symex_checker.h"
 
+#include <util/make_unique.h>
 #include <util/ui_message.h>
 
 #include <goto-symex/solver_hardness.h>
@@ -52,6 +53,9 @@ operator()(propertiest &properties)
       symex,
       ui_message_handler);
 
+    output_symex_profile(
+      options.get_option("symex-profile"), symex, ui_message_handler);
+
     update_properties(properties, result.updated_properties);
 
     // Have we got anything to check? Otherwise we return DONE.
@@ -60,11 +64,34 @@ operator()(propertiest &properties)
 
     solver_runtime += prepare_property_decider(properties);
 
+    if(options.get_bool_option("cover-subsumption"))
+    {
+      messaget log(ui_message_handler);
+      if(property_decider.can_solve_selected())
+      {
+        cover_goals_subsumption = util_make_unique<cover_goals_subsumptiont>(
+          goto_model.get_goto_functions(), properties);
+        log.statistics()
+          << cover_goals_subsumption->number_of_subsumable_goals()
+          << " goals are subsumed by other goals" << messaget::eom;
+      }
+      else
+      {
+        log.warning() << "cover-subsumption requires a solver that supports "
+                      << "solving under assumptions, ignoring it"
+                      << messaget::eom;
+      }
+    }
+
     equation_generated = true;
   }
 
   run_property_decider(result, properties, solver_runtime);
 
+  // traces are built from the expressions of the steps
+  if(count_properties(properties, property_statust::FAIL) > 0)
+    equation.restore_spilled_steps();
+
   return result;
 }
 
@@ -82,8 +109,21 @@ void multi_path_symex_checkert::run_property_decider(
   propertiest &properties,
   std::chrono::duration<double> solver_runtime)
 {
-  ::run_property_decider(
-    result, properties, property_decider, ui_message_handler, solver_runtime);
+  if(cover_goals_subsumption)
+  {
+    ::run_property_decider_with_subsumption(
+      result,
+      properties,
+      property_decider,
+      *cover_goals_subsumption,
+      ui_message_handler,
+      solver_runtime);
+  }
+  else
+  {
+    ::run_property_decider(
+      result, properties, property_decider, ui_message_handler, solver_runtime);
+  }
 }
 
 goto_tracet multi_path_symex_checkert::build_full_trace() const
@@ -137,6 +177,7 @@ const namespacet &multi_path_symex_checkert::get_namespace() const
 
 void multi_path_symex_checkert::output_proof()
 {
+  equation.restore_spilled_steps();
   output_graphml(equation, ns, options);
 }
 
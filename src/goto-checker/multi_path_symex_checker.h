@@ -12,6 +12,7 @@ Author: Daniel Kroening, Peter Schrammel
 #ifndef CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_CHECKER_H
 #define CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_CHECKER_H
 
+#include "cover_goals_subsumption.h"
 #include "fault_localization_provider.h"
 #include "goto_symex_property_decider.h"
 #include "goto_trace_provider.h"
@@ -19,6 +20,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include "witness_provider.h"
 
 #include <chrono> // IWYU pragma: keep
+#include <memory>
 
 /// Performs a multi-path symbolic execution using goto-symex
 /// and calls a SAT/SMT solver to check the status of the properties.
@@ -60,6 +62,10 @@ class multi_path_symex_checkert : public multi_path_symex_only_checkert,
   bool equation_generated;
   goto_symex_property_decidert property_decider;
 
+  /// Selects the goals to target when checking coverage goals with
+  /// `cover-subsumption`, null otherwise
+  std::unique_ptr<cover_goals_subsumptiont> cover_goals_subsumption;
+
   /// Prepare the property decider for solving. This sets up the data structures
   /// for tracking goal literals, sets the status of \p properties to be checked
   /// to UNKNOWN and pushes the equation into the solver.
@@ -26,6 +26,7 @@ multi_path_symex_only_checkert::multi_path_symex_only_checkert(
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
     equation(ui_message_handler),
+    guard_manager(options),
     unwindset(goto_model),
     symex(
       ui_message_handler,
@@ -37,6 +38,12 @@ multi_path_symex_only_checkert::multi_path_symex_only_checkert(
       unwindset)
 {
   setup_symex(symex, ns, options, ui_message_handler);
+
+  if(options.is_set("symex-spill-steps"))
+  {
+    equation.enable_spilling(
+      options.get_unsigned_int_option("symex-spill-steps"));
+  }
 }
 
 incremental_goto_checkert::resultt multi_path_symex_only_checkert::
@@ -50,6 +57,17 @@ operator()(propertiest &properties)
     symex,
     ui_message_handler);
 
+  output_symex_profile(
+    options.get_option("symex-profile"), symex, ui_message_handler);
+
+  if(
+    options.get_bool_option("show-vcc") ||
+    options.get_bool_option("program-only") ||
+    options.get_bool_option("show-byte-ops"))
+  {
+    equation.restore_spilled_steps();
+  }
+
   if(options.get_bool_option("show-vcc"))
   {
     show_vcc(options, ui_message_handler, equation);
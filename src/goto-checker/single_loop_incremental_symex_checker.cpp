@@ -28,6 +28,7 @@ single_loop_incremental_symex_checkert::single_loop_incremental_symex_checkert(
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
     equation(ui_message_handler),
+    guard_manager(options),
     unwindset(goto_model),
     symex(
       ui_message_handler,
@@ -16,10 +16,17 @@ Author: Matt Lewis
 #include <goto-programs/goto_functions.h>
 
 #include <util/arith_tools.h>
+#include <util/exception_utils.h>
 #include <util/find_symbols.h>
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/run_in_processes.h>
 #include <util/std_code.h>
 #include <util/std_expr.h>
+#include <util/tempfile.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <list>
 
@@ -83,13 +90,6 @@ bool acceleratet::contains_nested_loops(goto_programt::targett &loop_header)
 
 int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
 {
-  pathst loop_paths, exit_paths;
-  goto_programt::targett back_jump=find_back_jump(loop_header);
-  int num_accelerated=0;
-  std::list<path_acceleratort> accelerators;
-  natural_loops_mutablet::natural_loopt &loop =
-    natural_loops.loop_map.at(loop_header);
-
   if(contains_nested_loops(loop_header))
   {
     // For now, only accelerate innermost loops.
@@ -99,10 +99,26 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
     return 0;
   }
 
+  goto_programt::targett back_jump = find_back_jump(loop_header);
   goto_programt::targett overflow_loc;
-  make_overflow_loc(loop_header, back_jump, overflow_loc);
+  const symbol_exprt overflow_var =
+    make_overflow_loc(loop_header, back_jump, overflow_loc);
   program.update();
 
+  loop_acceleratorst loop{
+    loop_header, back_jump, overflow_loc, overflow_var, "", {}};
+  find_accelerators(loop_header, loop.accelerators);
+
+  return insert_accelerators(loop);
+}
+
+bool acceleratet::find_accelerators(
+  goto_programt::targett loop_header,
+  std::list<path_acceleratort> &accelerators)
+{
+  natural_loops_mutablet::natural_loopt &loop =
+    natural_loops.loop_map.at(loop_header);
+
 #if 1
   enumerating_loop_accelerationt acceleration(
     message_handler,
@@ -118,7 +134,14 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
     acceleration(symbol_table, goto_functions, program, loop, loop_header);
 #endif
 
+  if(loop_time_limit.count() > 0)
+  {
+    acceleration.set_deadline(
+      std::chrono::steady_clock::now() + loop_time_limit);
+  }
+
   path_acceleratort accelerator;
+  int num_accelerated = 0;
 
   while(acceleration.accelerate(accelerator) &&
         (accelerate_limit < 0 ||
@@ -149,6 +172,25 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
 #endif
   }
 
+  if(acceleration.deadline_passed())
+  {
+    messaget log(message_handler);
+    log.warning() << "Time limit reached for the loop at "
+                  << loop_header->source_location() << ", using "
+                  << accelerators.size() << " accelerator(s)" << messaget::eom;
+    return false;
+  }
+
+  return true;
+}
+
+int acceleratet::insert_accelerators(loop_acceleratorst &loop_accelerators)
+{
+  goto_programt::targett &loop_header = loop_accelerators.loop_header;
+  natural_loops_mutablet::natural_loopt &loop =
+    natural_loops.loop_map.at(loop_header);
+  int num_accelerated = 0;
+
   goto_programt::instructiont skip(SKIP);
   program.insert_before_swap(loop_header, skip);
 
@@ -157,16 +199,17 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
 
   loop.insert_instruction(new_inst);
 
-  std::cout << "Overflow loc is " << overflow_loc->location_number << '\n';
-  std::cout << "Back jump is " << back_jump->location_number << '\n';
+  std::cout << "Overflow loc is "
+            << loop_accelerators.overflow_loc->location_number << '\n';
+  std::cout << "Back jump is " << loop_accelerators.back_jump->location_number
+            << '\n';
 
-  for(std::list<path_acceleratort>::iterator it=accelerators.begin();
-      it!=accelerators.end();
-      ++it)
+  for(auto &accelerator : loop_accelerators.accelerators)
   {
-    subsumed_patht inserted(it->path);
+    subsumed_patht inserted(accelerator.path);
 
-    insert_accelerator(loop_header, back_jump, *it, inserted);
+    insert_accelerator(
+      loop_header, loop_accelerators.back_jump, accelerator, inserted);
     subsumed.push_back(inserted);
     num_accelerated++;
   }
@@ -231,13 +274,13 @@ void acceleratet::insert_looping_path(
   inserted_path.push_back(path_nodet(back_jump));
 }
 
-void acceleratet::make_overflow_loc(
+symbol_exprt acceleratet::make_overflow_loc(
   goto_programt::targett loop_header,
   goto_programt::targett &loop_end,
   goto_programt::targett &overflow_loc)
 {
   symbolt overflow_sym=utils.fresh_symbol("accelerate::overflow", bool_typet());
-  const exprt &overflow_var=overflow_sym.symbol_expr();
+  const symbol_exprt overflow_var = overflow_sym.symbol_expr();
   natural_loops_mutablet::natural_loopt &loop =
     natural_loops.loop_map.at(loop_header);
   overflow_instrumentert instrumenter(program, overflow_var, symbol_table);
@@ -272,6 +315,8 @@ void acceleratet::make_overflow_loc(
   goto_programt::targett tmp=overflow_loc;
   overflow_loc=loop_end;
   loop_end=tmp;
+
+  return overflow_var;
 }
 
 void acceleratet::restrict_traces()
@@ -603,21 +648,250 @@ void acceleratet::build_state_machine(
   }
 }
 
+acceleratet::acceleratet(
+  goto_programt &_program,
+  goto_modelt &_goto_model,
+  message_handlert &message_handler,
+  const acceleration_optionst &options,
+  guard_managert &guard_manager)
+  : acceleratet(
+      _program,
+      _goto_model,
+      message_handler,
+      options.use_z3,
+      guard_manager)
+{
+  jobs = options.jobs;
+  loop_time_limit = options.loop_time_limit;
+  if(!options.cache_directory.empty())
+  {
+    cache = util_make_unique<acceleration_cachet>(
+      options.cache_directory, options.use_z3, message_handler);
+  }
+}
+
+void acceleratet::find_accelerators_in_processes(
+  std::vector<loop_acceleratorst> &loops,
+  const std::vector<std::size_t> &pending,
+  std::vector<bool> &complete)
+{
+  messaget log(message_handler);
+
+#ifdef _WIN32
+  log.warning() << "parallel acceleration is not supported on Windows,"
+                << " using a single process" << messaget::eom;
+
+  for(const std::size_t i : pending)
+  {
+    complete[i] =
+      find_accelerators(loops[i].loop_header, loops[i].accelerators);
+  }
+#else
+  auto loop_size = [this, &loops](std::size_t i) {
+    return natural_loops.loop_map.at(loops[i].loop_header).size();
+  };
+
+  // Give the largest remaining loop to the process with the fewest
+  // instructions so far
+  std::vector<std::size_t> by_size = pending;
+  std::stable_sort(
+    by_size.begin(), by_size.end(), [&loop_size](std::size_t a, std::size_t b) {
+      return loop_size(a) > loop_size(b);
+    });
+
+  const std::size_t number_of_processes = std::min(jobs, pending.size());
+  std::vector<std::vector<std::size_t>> process_loops(number_of_processes);
+  std::vector<std::size_t> process_sizes(number_of_processes, 0);
+  for(const std::size_t i : by_size)
+  {
+    const std::size_t p =
+      std::min_element(process_sizes.begin(), process_sizes.end()) -
+      process_sizes.begin();
+    process_loops[p].push_back(i);
+    process_sizes[p] += loop_size(i);
+  }
+
+  log.status() << "Computing accelerators of " << pending.size()
+               << " loops with " << number_of_processes << " processes"
+               << messaget::eom;
+
+  std::vector<temporary_filet> files;
+  for(std::size_t p = 0; p < number_of_processes; ++p)
+    files.emplace_back("goto_instrument_accelerators_", ".acc");
+
+  const std::vector<bool> process_failed = run_in_processes(
+    files, [&](std::size_t p, const std::string &file_name) {
+      std::ofstream out(file_name, std::ios::binary);
+      bool failed = !out;
+
+      for(auto it = process_loops[p].begin();
+          !failed && it != process_loops[p].end();
+          ++it)
+      {
+        loop_acceleratorst &loop = loops[*it];
+        std::list<path_acceleratort> accelerators;
+        write_gb_word(out, find_accelerators(loop.loop_header, accelerators));
+        failed = write_accelerators(
+          out,
+          loop.cache_key.loop,
+          accelerators,
+          natural_loops.loop_map.at(loop.loop_header),
+          loop.overflow_var,
+          ns);
+      }
+
+      out.flush();
+      return failed || !out.good();
+    });
+
+  for(std::size_t p = 0; p < number_of_processes; ++p)
+  {
+    const std::vector<std::size_t> &job = process_loops[p];
+    auto it = job.begin();
+
+    if(!process_failed[p])
+    {
+      std::ifstream in(files[p](), std::ios::binary);
+
+      try
+      {
+        for(; it != job.end(); ++it)
+        {
+          loop_acceleratorst &loop = loops[*it];
+          const bool loop_complete = irep_serializationt::read_gb_word(in) != 0;
+          if(read_accelerators(
+               in,
+               loop.cache_key.loop,
+               natural_loops.loop_map.at(loop.loop_header),
+               loop.overflow_var,
+               utils,
+               loop.accelerators))
+          {
+            break;
+          }
+          complete[*it] = loop_complete;
+        }
+      }
+      catch(const deserialization_exceptiont &)
+      {
+      }
+    }
+
+    if(it != job.end())
+    {
+      log.warning() << "acceleration process " << p + 1 << " of "
+                    << number_of_processes
+                    << " failed, computing its accelerators in this process"
+                    << messaget::eom;
+    }
+
+    for(; it != job.end(); ++it)
+    {
+      loop_acceleratorst &loop = loops[*it];
+      complete[*it] = find_accelerators(loop.loop_header, loop.accelerators);
+    }
+  }
+#endif
+}
+
 int acceleratet::accelerate_loops()
 {
-  int num_accelerated=0;
+  messaget log(message_handler);
 
-  for(natural_loops_mutablet::loop_mapt::iterator it =
-      natural_loops.loop_map.begin();
-      it!=natural_loops.loop_map.end();
-      ++it)
+  // Instrument all innermost loops before computing any accelerators, such
+  // that the accelerators of each loop can be computed independently of the
+  // others, possibly in other processes
+  program.update();
+
+  std::vector<loop_acceleratorst> loops;
+
+  for(const auto &loop_entry : natural_loops.loop_map)
   {
-    goto_programt::targett t=it->first;
-    num_accelerated += accelerate_loop(t);
+    goto_programt::targett loop_header = loop_entry.first;
+
+    if(contains_nested_loops(loop_header))
+    {
+      // For now, only accelerate innermost loops.
+#ifdef DEBUG
+      std::cout << "Not accelerating an outer loop\n";
+#endif
+      continue;
+    }
+
+    // the key describes the loop before it is instrumented
+    const acceleration_cachet::keyt cache_key =
+      cache ? cache->key(loop_entry.second, ns) : acceleration_cachet::keyt();
+
+    goto_programt::targett back_jump = find_back_jump(loop_header);
+    goto_programt::targett overflow_loc;
+    const symbol_exprt overflow_var =
+      make_overflow_loc(loop_header, back_jump, overflow_loc);
+
+    loops.push_back(
+      {loop_header, back_jump, overflow_loc, overflow_var, cache_key, {}});
   }
 
   program.update();
 
+  std::vector<std::size_t> pending;
+  for(std::size_t i = 0; i < loops.size(); ++i)
+  {
+    loop_acceleratorst &loop = loops[i];
+
+    if(
+      cache && !cache->read(
+                 loop.cache_key,
+                 natural_loops.loop_map.at(loop.loop_header),
+                 loop.overflow_var,
+                 utils,
+                 loop.accelerators))
+    {
+      log.status() << "Using cached accelerators for the loop at "
+                   << loop.loop_header->source_location() << messaget::eom;
+    }
+    else
+      pending.push_back(i);
+  }
+
+  std::vector<bool> complete(loops.size(), true);
+
+  if(jobs > 1 && pending.size() > 1)
+    find_accelerators_in_processes(loops, pending, complete);
+  else
+  {
+    for(const std::size_t i : pending)
+    {
+      complete[i] =
+        find_accelerators(loops[i].loop_header, loops[i].accelerators);
+    }
+  }
+
+  // Accelerators that were cut short by the time limit are not stored, such
+  // that later runs try again
+  if(cache)
+  {
+    for(const std::size_t i : pending)
+    {
+      if(!complete[i])
+        continue;
+
+      const loop_acceleratorst &loop = loops[i];
+      cache->write(
+        loop.cache_key,
+        loop.accelerators,
+        natural_loops.loop_map.at(loop.loop_header),
+        loop.overflow_var,
+        ns);
+    }
+  }
+
+  int num_accelerated=0;
+
+  for(auto &loop : loops)
+    num_accelerated += insert_accelerators(loop);
+
+  program.update();
+
   if(num_accelerated > 0)
   {
     std::cout << "Engaging crush mode...\n";
@@ -637,12 +911,27 @@ void accelerate_functions(
   message_handlert &message_handler,
   bool use_z3,
   guard_managert &guard_manager)
+{
+  acceleration_optionst options;
+  options.use_z3 = use_z3;
+  accelerate_functions(goto_model, message_handler, options, guard_manager);
+}
+
+void accelerate_functions(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  const acceleration_optionst &options,
+  guard_managert &guard_manager)
 {
   for(auto &gf_entry : goto_model.goto_functions.function_map)
   {
     std::cout << "Accelerating function " << gf_entry.first << '\n';
     acceleratet accelerate(
-      gf_entry.second.body, goto_model, message_handler, use_z3, guard_manager);
+      gf_entry.second.body,
+      goto_model,
+      message_handler,
+      options,
+      guard_manager);
 
     int num_accelerated=accelerate.accelerate_loops();
 
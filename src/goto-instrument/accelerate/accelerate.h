@@ -19,9 +19,29 @@ Author: Matt Lewis
 #include "path.h"
 #include "trace_automaton.h"
 #include "subsumed.h"
+#include "acceleration_cache.h"
 #include "acceleration_utils.h"
+#include "accelerator.h"
 
-class path_acceleratort;
+#include <chrono>
+#include <memory>
+
+struct acceleration_optionst
+{
+  bool use_z3 = false;
+
+  /// Number of processes that compute the accelerators of the loops of a
+  /// function
+  std::size_t jobs = 1;
+
+  /// Time after which no further paths of a loop are accelerated, or zero
+  /// for no limit. Paths are not interrupted while they are accelerated.
+  std::chrono::seconds loop_time_limit{0};
+
+  /// Directory in which the accelerators of each loop are stored, to be
+  /// reused by later runs, or empty for no caching
+  std::string cache_directory;
+};
 
 class acceleratet
 {
@@ -44,7 +64,17 @@ class acceleratet
     natural_loops(program);
   }
 
+  acceleratet(
+    goto_programt &_program,
+    goto_modelt &_goto_model,
+    message_handlert &message_handler,
+    const acceleration_optionst &options,
+    guard_managert &guard_manager);
+
   int accelerate_loop(goto_programt::targett &loop_header);
+
+  /// Accelerate all innermost loops. Their accelerators are computed in
+  /// several processes if requested by \ref acceleration_optionst::jobs.
   int accelerate_loops();
 
   bool accelerate_path(patht &path, path_acceleratort &accelerator);
@@ -56,6 +86,31 @@ class acceleratet
 protected:
   message_handlert &message_handler;
 
+  /// An innermost loop whose accelerators are computed
+  struct loop_acceleratorst
+  {
+    goto_programt::targett loop_header;
+    goto_programt::targett back_jump;
+    goto_programt::targett overflow_loc;
+    symbol_exprt overflow_var;
+    acceleration_cachet::keyt cache_key;
+    std::list<path_acceleratort> accelerators;
+  };
+
+  /// Compute the accelerators of the loop at \p loop_header, which has been
+  /// instrumented by \ref make_overflow_loc
+  /// \return false if the time limit was hit before all paths were tried
+  bool find_accelerators(
+    goto_programt::targett loop_header,
+    std::list<path_acceleratort> &accelerators);
+
+  void find_accelerators_in_processes(
+    std::vector<loop_acceleratorst> &loops,
+    const std::vector<std::size_t> &pending,
+    std::vector<bool> &complete);
+
+  int insert_accelerators(loop_acceleratorst &loop);
+
   void find_paths(
     goto_programt::targett &loop_header,
     pathst &loop_paths,
@@ -88,7 +143,8 @@ class acceleratet
   void add_dirty_checks();
   bool is_underapproximate(path_acceleratort &accelerator);
 
-  void make_overflow_loc(
+  /// \return the flag that is set by overflows in the loop
+  symbol_exprt make_overflow_loc(
     goto_programt::targett loop_header,
     goto_programt::targett &loop_end,
     goto_programt::targett &overflow_loc);
@@ -124,6 +180,9 @@ class acceleratet
   expr_mapt dirty_vars_map;
 
   bool use_z3;
+  std::size_t jobs = 1;
+  std::chrono::seconds loop_time_limit{0};
+  std::unique_ptr<acceleration_cachet> cache;
 };
 
 void accelerate_functions(
@@ -132,4 +191,10 @@ void accelerate_functions(
   bool use_z3,
   guard_managert &guard_manager);
 
+void accelerate_functions(
+  goto_modelt &,
+  message_handlert &message_handler,
+  const acceleration_optionst &options,
+  guard_managert &guard_manager);
+
 #endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATE_H
@@ -0,0 +1,500 @@
+/*******************************************************************\
+
+Module: Loop Acceleration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storing the accelerators of a loop in a file, to reuse them in other
+/// processes and across runs
+
+#include "acceleration_cache.h"
+
+#include <util/exception_utils.h>
+#include <util/file_util.h>
+#include <util/find_symbols.h>
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/replace_expr.h>
+#include <util/std_expr.h>
+#include <util/string_hash.h>
+#include <util/version.h>
+
+#include "acceleration_utils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+
+/// Must be changed whenever the format of the files or the way the keys are
+/// computed changes
+static const std::size_t accelerators_file_version = 2;
+
+/// The instructions of \p loop in program order
+static std::vector<goto_programt::targett>
+sorted_instructions(const natural_loops_mutablet::natural_loopt &loop)
+{
+  std::vector<goto_programt::targett> instructions(loop.begin(), loop.end());
+  std::sort(
+    instructions.begin(),
+    instructions.end(),
+    [](goto_programt::targett a, goto_programt::targett b) {
+      return a->location_number < b->location_number;
+    });
+  return instructions;
+}
+
+/// \return true on failure
+static bool write_program(
+  std::ostream &out,
+  const goto_programt &program,
+  irep_serializationt &serialization)
+{
+  std::map<goto_programt::const_targett, std::size_t> indices;
+  for(auto it = program.instructions.begin(); it != program.instructions.end();
+      ++it)
+  {
+    indices.emplace(it, indices.size());
+  }
+
+  write_gb_word(out, program.instructions.size());
+
+  for(const auto &instruction : program.instructions)
+  {
+    serialization.reference_convert(instruction.code(), out);
+    serialization.reference_convert(instruction.source_location(), out);
+    write_gb_word(out, static_cast<std::size_t>(instruction.type()));
+
+    const exprt condition =
+      instruction.has_condition() ? instruction.condition() : true_exprt();
+    serialization.reference_convert(condition, out);
+
+    write_gb_word(out, instruction.targets.size());
+    for(const auto &target : instruction.targets)
+    {
+      const auto index = indices.find(target);
+      if(index == indices.end())
+        return true;
+      write_gb_word(out, index->second);
+    }
+  }
+
+  return false;
+}
+
+static void read_program(
+  std::istream &in,
+  goto_programt &program,
+  irep_serializationt &serialization)
+{
+  std::vector<goto_programt::targett> instructions;
+  std::vector<std::vector<std::size_t>> targets;
+
+  for(std::size_t n = irep_serializationt::read_gb_word(in); n != 0; --n)
+  {
+    // take copies as references into the serialization are not stable
+    const goto_instruction_codet code =
+      static_cast<const goto_instruction_codet &>(
+        serialization.reference_convert(in));
+    const source_locationt source_location =
+      static_cast<const source_locationt &>(
+        serialization.reference_convert(in));
+    const auto type = static_cast<goto_program_instruction_typet>(
+      irep_serializationt::read_gb_word(in));
+    const exprt condition =
+      static_cast<const exprt &>(serialization.reference_convert(in));
+
+    instructions.push_back(
+      program.add({code, source_location, type, condition, {}}));
+
+    targets.emplace_back();
+    for(std::size_t t = irep_serializationt::read_gb_word(in); t != 0; --t)
+      targets.back().push_back(irep_serializationt::read_gb_word(in));
+  }
+
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    for(const std::size_t target : targets[i])
+    {
+      if(target >= instructions.size())
+        throw deserialization_exceptiont("invalid target");
+      instructions[i]->targets.push_back(instructions[target]);
+    }
+  }
+}
+
+static void write_exprs(
+  std::ostream &out,
+  const std::set<exprt> &exprs,
+  irep_serializationt &serialization)
+{
+  write_gb_word(out, exprs.size());
+  for(const exprt &expr : exprs)
+    serialization.reference_convert(expr, out);
+}
+
+static void read_exprs(
+  std::istream &in,
+  std::set<exprt> &exprs,
+  irep_serializationt &serialization)
+{
+  for(std::size_t n = irep_serializationt::read_gb_word(in); n != 0; --n)
+  {
+    exprs.insert(
+      static_cast<const exprt &>(serialization.reference_convert(in)));
+  }
+}
+
+/// Add the symbols in \p expr that acceleration introduced to \p dest
+static void find_scratch_symbols(
+  const exprt &expr,
+  const namespacet &ns,
+  std::map<irep_idt, symbol_exprt> &dest)
+{
+  find_symbols_sett identifiers;
+  find_type_and_expr_symbols(expr, identifiers);
+
+  for(const irep_idt &identifier : identifiers)
+  {
+    const symbolt *symbol;
+    if(!ns.lookup(identifier, symbol) && symbol->module == "scratch")
+      dest.emplace(identifier, symbol->symbol_expr());
+  }
+}
+
+bool write_accelerators(
+  std::ostream &out,
+  const irept &loop_description,
+  const std::list<path_acceleratort> &accelerators,
+  const natural_loops_mutablet::natural_loopt &loop,
+  const symbol_exprt &overflow_var,
+  const namespacet &ns)
+{
+  const std::vector<goto_programt::targett> loop_instructions =
+    sorted_instructions(loop);
+  std::map<goto_programt::targett, std::size_t> loop_indices;
+  for(const auto &t : loop_instructions)
+    loop_indices.emplace(t, loop_indices.size());
+
+  std::map<irep_idt, symbol_exprt> symbols;
+  for(const path_acceleratort &accelerator : accelerators)
+  {
+    for(const path_nodet &node : accelerator.path)
+      find_scratch_symbols(node.guard, ns, symbols);
+    for(const goto_programt *program :
+        {&accelerator.pure_accelerator, &accelerator.overflow_path})
+    {
+      for(const auto &instruction : program->instructions)
+      {
+        find_scratch_symbols(instruction.code(), ns, symbols);
+        if(instruction.has_condition())
+          find_scratch_symbols(instruction.condition(), ns, symbols);
+      }
+    }
+    for(const std::set<exprt> *exprs :
+        {&accelerator.changed_vars, &accelerator.dirty_vars})
+    {
+      for(const exprt &expr : *exprs)
+        find_scratch_symbols(expr, ns, symbols);
+    }
+  }
+  symbols.erase(overflow_var.get_identifier());
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization{ireps_container};
+
+  out << char(0x7f) << "ACC";
+  write_gb_word(out, accelerators_file_version);
+  serialization.reference_convert(loop_description, out);
+
+  serialization.reference_convert(overflow_var, out);
+  write_gb_word(out, symbols.size());
+  for(const auto &symbol : symbols)
+    serialization.reference_convert(symbol.second, out);
+
+  write_gb_word(out, accelerators.size());
+  for(const path_acceleratort &accelerator : accelerators)
+  {
+    write_gb_word(out, accelerator.path.size());
+    for(const path_nodet &node : accelerator.path)
+    {
+      const auto index = loop_indices.find(node.loc);
+      if(index == loop_indices.end())
+        return true;
+      write_gb_word(out, index->second);
+      serialization.reference_convert(node.guard, out);
+    }
+
+    if(
+      write_program(out, accelerator.pure_accelerator, serialization) ||
+      write_program(out, accelerator.overflow_path, serialization))
+    {
+      return true;
+    }
+
+    write_exprs(out, accelerator.changed_vars, serialization);
+    write_exprs(out, accelerator.dirty_vars, serialization);
+  }
+
+  return !out.good();
+}
+
+bool read_accelerators(
+  std::istream &in,
+  const irept &loop_description,
+  natural_loops_mutablet::natural_loopt &loop,
+  const symbol_exprt &overflow_var,
+  acceleration_utilst &utils,
+  std::list<path_acceleratort> &accelerators)
+{
+  char header[4];
+  in.read(header, sizeof(header));
+  if(
+    !in || header[0] != char(0x7f) || header[1] != 'A' || header[2] != 'C' ||
+    header[3] != 'C')
+  {
+    return true;
+  }
+
+  try
+  {
+    if(irep_serializationt::read_gb_word(in) != accelerators_file_version)
+      return true;
+
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt serialization{ireps_container};
+
+    // the hash of the description names the file, which does not rule out
+    // that the file was written for another loop
+    if(serialization.reference_convert(in) != loop_description)
+      return true;
+
+    const std::vector<goto_programt::targett> loop_instructions =
+      sorted_instructions(loop);
+
+    replace_mapt replace_map;
+    replace_map.emplace(
+      static_cast<const exprt &>(serialization.reference_convert(in)),
+      overflow_var);
+
+    for(std::size_t n = irep_serializationt::read_gb_word(in); n != 0; --n)
+    {
+      const symbol_exprt symbol =
+        static_cast<const symbol_exprt &>(serialization.reference_convert(in));
+
+      // the symbols of acceleration are named base_number, see
+      // acceleration_utilst::fresh_symbol
+      const std::string &name = id2string(symbol.get_identifier());
+      const std::string base = name.substr(0, name.rfind('_'));
+      replace_map.emplace(
+        symbol, utils.fresh_symbol(base, symbol.type()).symbol_expr());
+    }
+
+    std::list<path_acceleratort> result;
+    for(std::size_t n = irep_serializationt::read_gb_word(in); n != 0; --n)
+    {
+      result.emplace_back();
+      path_acceleratort &accelerator = result.back();
+
+      for(std::size_t p = irep_serializationt::read_gb_word(in); p != 0; --p)
+      {
+        const std::size_t index = irep_serializationt::read_gb_word(in);
+        exprt guard =
+          static_cast<const exprt &>(serialization.reference_convert(in));
+        if(index >= loop_instructions.size())
+          return true;
+        replace_expr(replace_map, guard);
+        accelerator.path.emplace_back(loop_instructions[index], guard);
+      }
+
+      read_program(in, accelerator.pure_accelerator, serialization);
+      read_program(in, accelerator.overflow_path, serialization);
+      for(goto_programt *program :
+          {&accelerator.pure_accelerator, &accelerator.overflow_path})
+      {
+        for(auto &instruction : program->instructions)
+        {
+          replace_expr(replace_map, instruction.code_nonconst());
+          if(instruction.has_condition())
+            replace_expr(replace_map, instruction.condition_nonconst());
+        }
+      }
+
+      for(std::set<exprt> *exprs :
+          {&accelerator.changed_vars, &accelerator.dirty_vars})
+      {
+        std::set<exprt> read;
+        read_exprs(in, read, serialization);
+        for(exprt expr : read)
+        {
+          replace_expr(replace_map, expr);
+          exprs->insert(std::move(expr));
+        }
+      }
+    }
+
+    accelerators.splice(accelerators.end(), result);
+    return false;
+  }
+  catch(const deserialization_exceptiont &)
+  {
+    return true;
+  }
+}
+
+acceleration_cachet::keyt acceleration_cachet::key(
+  const natural_loops_mutablet::natural_loopt &loop,
+  const namespacet &ns)
+{
+  const std::vector<goto_programt::targett> instructions =
+    sorted_instructions(loop);
+  PRECONDITION(!instructions.empty());
+  const long long first_location = instructions.front()->location_number;
+
+  keyt result;
+  result.loop.set("version", CBMC_VERSION);
+  result.loop.set("use_z3", use_z3);
+
+  find_symbols_sett identifiers;
+  irept::subt &loop_instructions = result.loop.add("instructions").get_sub();
+
+  for(const auto &instruction : instructions)
+  {
+    irept description;
+    description.set(ID_type, static_cast<long long>(instruction->type()));
+    description.add(ID_code, instruction->code());
+    find_type_and_expr_symbols(instruction->code(), identifiers);
+    if(instruction->has_condition())
+    {
+      description.add("condition", instruction->condition());
+      find_type_and_expr_symbols(instruction->condition(), identifiers);
+    }
+
+    // targets relative to the start of the loop
+    irept::subt &targets = description.add("targets").get_sub();
+    for(const auto &target : instruction->targets)
+    {
+      targets.emplace_back();
+      targets.back().set(ID_value, target->location_number - first_location);
+    }
+
+    loop_instructions.push_back(std::move(description));
+  }
+
+  // The types of the symbols used in the loop, including the definitions of
+  // the tags that they refer to. Sort the identifiers, as the order in which
+  // they are found does not carry over to other runs.
+  std::set<std::string> pending;
+  for(const irep_idt &identifier : identifiers)
+    pending.insert(id2string(identifier));
+  std::set<std::string> done;
+  irept::subt &symbols = result.loop.add("symbols").get_sub();
+
+  while(!pending.empty())
+  {
+    const std::string identifier = *pending.begin();
+    pending.erase(pending.begin());
+    if(!done.insert(identifier).second)
+      continue;
+
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol))
+      continue;
+
+    symbols.emplace_back(identifier);
+    symbols.back().add(ID_type, symbol->type);
+
+    find_symbols_sett tags;
+    find_type_symbols(symbol->type, tags);
+    for(const irep_idt &tag : tags)
+    {
+      if(done.find(id2string(tag)) == done.end())
+        pending.insert(id2string(tag));
+    }
+  }
+
+  std::ostringstream hash;
+  hash << std::hex << hasher(result.loop);
+  result.hash = hash.str();
+  return result;
+}
+
+std::string acceleration_cachet::file_name(const std::string &key) const
+{
+  return concat_dir_file(directory, key + ".acc");
+}
+
+bool acceleration_cachet::read(
+  const keyt &key,
+  natural_loops_mutablet::natural_loopt &loop,
+  const symbol_exprt &overflow_var,
+  acceleration_utilst &utils,
+  std::list<path_acceleratort> &accelerators)
+{
+  std::ifstream in(file_name(key.hash), std::ios::binary);
+  if(!in)
+    return true;
+
+  if(read_accelerators(
+       in, key.loop, loop, overflow_var, utils, accelerators))
+  {
+    messaget log(message_handler);
+    log.warning() << "Ignoring cached accelerators in "
+                  << file_name(key.hash)
+                  << ": unrecognised format, or written for another loop or"
+                  << " by another version" << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+void acceleration_cachet::write(
+  const keyt &key,
+  const std::list<path_acceleratort> &accelerators,
+  const natural_loops_mutablet::natural_loopt &loop,
+  const symbol_exprt &overflow_var,
+  const namespacet &ns)
+{
+  messaget log(message_handler);
+
+  if(!is_directory(directory))
+    create_directory(directory);
+
+  // Several processes may share the cache, so write to a file of our own and
+  // move it into place once it is complete
+  const std::string final_name = file_name(key.hash);
+  const std::string temporary_name =
+    final_name + "." + std::to_string(std::random_device{}());
+
+  bool failed;
+  {
+    std::ofstream out(temporary_name, std::ios::binary);
+    failed = !out || write_accelerators(
+                       out, key.loop, accelerators, loop, overflow_var, ns);
+  }
+
+  if(!failed)
+  {
+    try
+    {
+      file_rename(temporary_name, final_name);
+    }
+    catch(const system_exceptiont &)
+    {
+      failed = true;
+    }
+  }
+
+  if(failed)
+  {
+    file_remove(temporary_name);
+    log.warning() << "failed to cache accelerators in " << final_name
+                  << messaget::eom;
+  }
+}
@@ -0,0 +1,119 @@
+/*******************************************************************\
+
+Module: Loop Acceleration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storing the accelerators of a loop in a file, to reuse them in other
+/// processes and across runs
+
+#ifndef CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATION_CACHE_H
+#define CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATION_CACHE_H
+
+#include <util/stable_irep_hash.h>
+
+#include <analyses/natural_loops.h>
+
+#include "accelerator.h"
+
+#include <iosfwd>
+#include <list>
+#include <string>
+
+class acceleration_utilst;
+class message_handlert;
+class namespacet;
+class symbol_exprt;
+
+/// Write \p accelerators, which were computed for \p loop, to \p out.
+/// \p loop_description, as computed by \ref acceleration_cachet::key, is
+/// stored such that reading can check that the accelerators are for the same
+/// loop. Instructions of the loop are stored by their position in the loop,
+/// and the symbols that the acceleration introduced are stored with their
+/// types, except for \p overflow_var, the overflow flag of the loop.
+/// \return true on failure
+bool write_accelerators(
+  std::ostream &out,
+  const irept &loop_description,
+  const std::list<path_acceleratort> &accelerators,
+  const natural_loops_mutablet::natural_loopt &loop,
+  const symbol_exprt &overflow_var,
+  const namespacet &ns);
+
+/// Read accelerators written by \ref write_accelerators for a loop with the
+/// same instructions as \p loop and append them to \p accelerators. Symbols
+/// that the acceleration introduced are replaced by fresh symbols of
+/// \p utils, and the overflow flag by \p overflow_var.
+/// \return true on failure, including when the stored loop description
+///   differs from \p loop_description
+bool read_accelerators(
+  std::istream &in,
+  const irept &loop_description,
+  natural_loops_mutablet::natural_loopt &loop,
+  const symbol_exprt &overflow_var,
+  acceleration_utilst &utils,
+  std::list<path_acceleratort> &accelerators);
+
+/// A directory of files, each holding the accelerators of one loop. The file
+/// of a loop is named after a hash of the description of the loop, which
+/// consists of the instructions of the loop, before overflow checks are added,
+/// the types of the symbols they use and the version of the tool. The file
+/// also holds the description, so that a hash collision does not make
+/// another loop's accelerators be used.
+class acceleration_cachet
+{
+public:
+  struct keyt
+  {
+    /// The hash of \ref loop, which names the file
+    std::string hash;
+    /// The description of the loop
+    irept loop;
+  };
+
+  acceleration_cachet(
+    std::string _directory,
+    bool _use_z3,
+    message_handlert &_message_handler)
+    : directory(std::move(_directory)),
+      use_z3(_use_z3),
+      message_handler(_message_handler)
+  {
+  }
+
+  /// The key of \p loop, which must not have been instrumented yet
+  keyt key(
+    const natural_loops_mutablet::natural_loopt &loop,
+    const namespacet &ns);
+
+  /// Read the accelerators stored for \p key, see \ref read_accelerators
+  /// \return true if there are none or they cannot be read
+  bool read(
+    const keyt &key,
+    natural_loops_mutablet::natural_loopt &loop,
+    const symbol_exprt &overflow_var,
+    acceleration_utilst &utils,
+    std::list<path_acceleratort> &accelerators);
+
+  /// Store \p accelerators for \p key, see \ref write_accelerators. Failure
+  /// is reported as a warning.
+  void write(
+    const keyt &key,
+    const std::list<path_acceleratort> &accelerators,
+    const natural_loops_mutablet::natural_loopt &loop,
+    const symbol_exprt &overflow_var,
+    const namespacet &ns);
+
+protected:
+  std::string directory;
+  bool use_z3;
+  message_handlert &message_handler;
+  stable_irep_hashert hasher;
+
+  std::string file_name(const std::string &key) const;
+};
+
+#endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATION_CACHE_H
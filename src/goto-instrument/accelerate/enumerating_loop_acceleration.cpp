@@ -22,7 +22,8 @@ bool enumerating_loop_accelerationt::accelerate(
   // Note: we use enumerated!=path_limit rather than
   // enumerated < path_limit so that passing in path_limit=-1 causes
   // us to enumerate all the paths (or at least 2^31 of them...)
-  while(path_enumerator->next(path) && enumerated++!=path_limit)
+  while(!deadline_passed() && path_enumerator->next(path) &&
+        enumerated++ != path_limit)
   {
 #ifdef DEBUG
     std::cout << "Found a path...\n";
@@ -50,7 +51,7 @@ bool enumerating_loop_accelerationt::accelerate(
     path.clear();
   }
 
-  // No more paths, or we hit the enumeration limit.
+  // No more paths, or we hit the enumeration or the time limit.
 #ifdef DEBUG
   std::cout << "No more paths to accelerate!\n";
 #endif
@@ -12,9 +12,11 @@ Author: Matt Lewis
 #ifndef CPROVER_GOTO_INSTRUMENT_ACCELERATE_ENUMERATING_LOOP_ACCELERATION_H
 #define CPROVER_GOTO_INSTRUMENT_ACCELERATE_ENUMERATING_LOOP_ACCELERATION_H
 
+#include <chrono>
 #include <memory>
 
 #include <util/make_unique.h>
+#include <util/optional.h>
 
 #include <goto-programs/goto_program.h>
 
@@ -62,6 +64,18 @@ class enumerating_loop_accelerationt
 
   bool accelerate(path_acceleratort &accelerator);
 
+  /// Stop enumerating paths once \p _deadline has passed
+  void set_deadline(std::chrono::steady_clock::time_point _deadline)
+  {
+    deadline = _deadline;
+  }
+
+  bool deadline_passed() const
+  {
+    return deadline.has_value() &&
+           std::chrono::steady_clock::now() >= *deadline;
+  }
+
 protected:
   symbol_tablet &symbol_table;
   goto_functionst &goto_functions;
@@ -73,6 +87,7 @@ class enumerating_loop_accelerationt
   int path_limit;
 
   std::unique_ptr<path_enumeratort> path_enumerator;
+  optionalt<std::chrono::steady_clock::time_point> deadline;
 };
 
 #endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_ENUMERATING_LOOP_ACCELERATION_H
@@ -1436,7 +1436,7 @@ void code_contractst::apply_loop_contracts(
   // unwind all transformed loops twice.
   unwindsett unwindset{goto_model};
   unwindset.parse_unwindset(loop_names, log.get_message_handler());
-  goto_unwindt goto_unwind;
+  goto_unwindt goto_unwind(false);
   goto_unwind(goto_model, unwindset, goto_unwindt::unwind_strategyt::ASSUME);
 
   remove_skip(goto_model);
@@ -446,7 +446,7 @@ void dfcc_libraryt::specialize(const std::size_t contract_assigns_size)
     loop_names.push_back(str);
   }
   unwindset.parse_unwindset(loop_names, message_handler);
-  goto_unwindt goto_unwind;
+  goto_unwindt goto_unwind(false);
   goto_unwind(
     goto_model, unwindset, goto_unwindt::unwind_strategyt::ASSERT_ASSUME);
 }
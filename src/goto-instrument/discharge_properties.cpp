@@ -0,0 +1,97 @@
+/*******************************************************************\
+
+Module: Discharge Properties Using Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Discharge properties that abstract interpretation proves before symex
+
+#include "discharge_properties.h"
+
+#include <util/invariant.h>
+#include <util/message.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/ai.h>
+#include <analyses/is_threaded.h>
+
+#include "widening_analysis.h"
+
+std::size_t discharge_properties(
+  goto_modelt &goto_model,
+  const ai_baset &ai,
+  message_handlert &message_handler)
+{
+  messaget log{message_handler};
+  const namespacet ns{goto_model.symbol_table};
+  std::size_t properties = 0;
+  std::size_t discharged = 0;
+
+  for(auto &gf_entry : goto_model.goto_functions.function_map)
+  {
+    for(auto it = gf_entry.second.body.instructions.begin();
+        it != gf_entry.second.body.instructions.end();
+        ++it)
+    {
+      if(!it->is_assert() || it->condition().is_true())
+        continue;
+
+      ++properties;
+
+      const auto state = ai.abstract_state_before(it);
+      exprt condition = it->condition();
+      if(!state->is_bottom() && state->ai_simplify(condition, ns))
+        continue;
+
+      if(state->is_bottom() || condition.is_true())
+      {
+        it->condition_nonconst() = true_exprt{};
+        ++discharged;
+      }
+    }
+  }
+
+  log.statistics() << "Discharged " << discharged << " of " << properties
+                   << " properties using abstract interpretation"
+                   << messaget::eom;
+
+  return discharged;
+}
+
+bool is_discharge_properties_domain(const std::string &domain)
+{
+  return is_widening_analysis_domain(domain);
+}
+
+std::size_t discharge_properties(
+  goto_modelt &goto_model,
+  const std::string &domain,
+  message_handlert &message_handler)
+{
+  PRECONDITION(is_discharge_properties_domain(domain));
+
+  messaget log{message_handler};
+
+  // the analysis is sequential and does not consider interleavings
+  if(has_start_thread(goto_model.goto_functions))
+  {
+    log.warning() << "not discharging properties using abstract "
+                  << "interpretation as the program is multi-threaded"
+                  << messaget::eom;
+    return 0;
+  }
+
+  const std::unique_ptr<ai_baset> ai =
+    make_widening_analysis(goto_model, domain, message_handler);
+
+  log.status() << "Running " << domain << " analysis to discharge properties"
+               << messaget::eom;
+
+  (*ai)(goto_model);
+
+  return discharge_properties(goto_model, *ai, message_handler);
+}
@@ -0,0 +1,55 @@
+/*******************************************************************\
+
+Module: Discharge Properties Using Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Discharge properties that abstract interpretation proves before symex
+
+#ifndef CPROVER_GOTO_INSTRUMENT_DISCHARGE_PROPERTIES_H
+#define CPROVER_GOTO_INSTRUMENT_DISCHARGE_PROPERTIES_H
+
+#include <cstddef>
+#include <string>
+
+class ai_baset;
+class goto_modelt;
+class message_handlert;
+
+/// Replace the condition of each assertion that \p ai proves to hold, or to
+/// be unreachable, by true. Symex generates no verification condition for
+/// such an assertion, hence it is reported as passing without calling the
+/// solver. The property identifiers and descriptions are kept.
+/// \param goto_model: goto model to transform
+/// \param ai: abstract interpreter that has been run on \p goto_model
+/// \param message_handler: message handler for statistics
+/// \return number of assertions that were discharged
+std::size_t discharge_properties(
+  goto_modelt &goto_model,
+  const ai_baset &ai,
+  message_handlert &message_handler);
+
+/// Whether \p domain can be passed to
+/// \ref discharge_properties(goto_modelt &, const std::string &, message_handlert &)
+bool is_discharge_properties_domain(const std::string &domain);
+
+/// Run an analysis with the abstract domain \p domain, which is one of
+/// `constants` and `intervals` (both using the variable-sensitivity domain)
+/// and `octagons`, on \p goto_model and use its results to discharge
+/// assertions as described in
+/// \ref discharge_properties(goto_modelt &, const ai_baset &, message_handlert &).
+/// The analysis does not consider thread interleavings, hence nothing is
+/// discharged if \p goto_model starts threads.
+/// \param goto_model: goto model to transform
+/// \param domain: name of the abstract domain
+/// \param message_handler: message handler for progress and statistics
+/// \return number of assertions that were discharged
+std::size_t discharge_properties(
+  goto_modelt &goto_model,
+  const std::string &domain,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_DISCHARGE_PROPERTIES_H
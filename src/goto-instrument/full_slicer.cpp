@@ -17,6 +17,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/adjust_float_expressions.h>
 #include <goto-programs/remove_skip.h>
 
+#include <fstream>
+
 void full_slicert::add_dependencies(
   const cfgt::nodet &node,
   queuet &queue,
@@ -33,6 +35,34 @@ void full_slicert::add_dependencies(
     add_to_queue(queue, dep_node_to_cfg[it->first], node.PC);
 }
 
+void full_slicert::add_dependencies(
+  const cfgt::nodet &node,
+  queuet &queue,
+  const system_dependence_grapht &sdg,
+  std::vector<bool> &expanded)
+{
+  std::vector<system_dependence_grapht::node_indext> stack{
+    sdg.instruction_node(node.PC)};
+
+  while(!stack.empty())
+  {
+    const sdg_nodet &sdg_node = sdg[stack.back()];
+    stack.pop_back();
+
+    for(const auto &edge : sdg_node.in)
+    {
+      const sdg_nodet &dependency = sdg[edge.first];
+      if(dependency.kind == sdg_nodet::kindt::INSTRUCTION)
+        add_to_queue(queue, cfg.get_node_index(dependency.PC), node.PC);
+      else if(!expanded[edge.first])
+      {
+        expanded[edge.first] = true;
+        stack.push_back(edge.first);
+      }
+    }
+  }
+}
+
 void full_slicert::add_function_calls(
   const cfgt::nodet &node,
   queuet &queue,
@@ -154,27 +184,22 @@ void full_slicert::add_jumps(
       // check whether the nearest post-dominator is different from
       // lex_succ
       goto_programt::const_targett nearest=lex_succ;
-      std::size_t post_dom_size=0;
-      for(cfg_dominatorst::target_sett::const_iterator d_it =
-            j_PC_node.dominators.begin();
-          d_it != j_PC_node.dominators.end();
-          ++d_it)
+      for(const cfg_post_dominatorst::cfgt::nodet *d = &j_PC_node;;
+          d = &pd.cfg[*d->immediate_dominator])
       {
-        const auto &node = cfg.get_node(*d_it);
+        const auto &node = cfg.get_node(d->PC);
         if(node.node_required)
         {
           const irep_idt &id2 = node.function_id;
           INVARIANT(id==id2,
                     "goto/jump expected to be within a single function");
 
-          const auto &postdom_node = pd.get_node(*d_it);
-
-          if(postdom_node.dominators.size() > post_dom_size)
-          {
-            nearest=*d_it;
-            post_dom_size = postdom_node.dominators.size();
-          }
+          nearest = d->PC;
+          break;
         }
+
+        if(!d->immediate_dominator.has_value())
+          break;
       }
       if(nearest!=lex_succ)
       {
@@ -192,14 +217,9 @@ void full_slicert::fixedpoint(
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
-  const dependence_grapht &dep_graph)
+  const add_dependenciest &add_node_dependencies,
+  const dependence_grapht::post_dominators_mapt &post_dominators)
 {
-  std::vector<cfgt::entryt> dep_node_to_cfg;
-  dep_node_to_cfg.reserve(dep_graph.size());
-
-  for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
-    dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
-
   // process queue until empty
   while(!queue.empty())
   {
@@ -217,7 +237,7 @@ void full_slicert::fixedpoint(
       node.node_required=true;
 
       // add data and control dependencies of node
-      add_dependencies(node, queue, dep_graph, dep_node_to_cfg);
+      add_node_dependencies(node, queue);
 
       // retain all calls of the containing function
       add_function_calls(node, queue, goto_functions);
@@ -227,7 +247,7 @@ void full_slicert::fixedpoint(
     }
 
     // add any required jumps
-    add_jumps(queue, jumps, dep_graph.cfg_post_dominators());
+    add_jumps(queue, jumps, post_dominators);
   }
 }
 
@@ -295,12 +315,55 @@ void full_slicert::operator()(
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns);
-  dep_graph(goto_functions, ns);
+  if(use_system_dependence_graph)
+  {
+    system_dependence_grapht sdg;
+    if(system_dependence_graph_cache.empty())
+      sdg(goto_functions);
+    else
+    {
+      std::ifstream in(system_dependence_graph_cache, std::ios::binary);
+      if(!in || sdg.read(in, goto_functions))
+      {
+        sdg(goto_functions);
+        std::ofstream out(system_dependence_graph_cache, std::ios::binary);
+        sdg.write(out, goto_functions);
+      }
+    }
 
-  // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+    std::vector<bool> expanded(sdg.size(), false);
+    fixedpoint(
+      goto_functions,
+      queue,
+      jumps,
+      decl_dead,
+      [this, &sdg, &expanded](const cfgt::nodet &node, queuet &to_queue) {
+        add_dependencies(node, to_queue, sdg, expanded);
+      },
+      sdg.cfg_post_dominators());
+  }
+  else
+  {
+    // compute program dependence graph (and post-dominators)
+    dependence_grapht dep_graph(ns);
+    dep_graph(goto_functions, ns);
+
+    std::vector<cfgt::entryt> dep_node_to_cfg;
+    dep_node_to_cfg.reserve(dep_graph.size());
+    for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
+      dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
+
+    fixedpoint(
+      goto_functions,
+      queue,
+      jumps,
+      decl_dead,
+      [this, &dep_graph, &dep_node_to_cfg](
+        const cfgt::nodet &node, queuet &to_queue) {
+        add_dependencies(node, to_queue, dep_graph, dep_node_to_cfg);
+      },
+      dep_graph.cfg_post_dominators());
+  }
 
   // now replace those instructions that are not needed
   // by skips
@@ -361,10 +424,19 @@ void full_slicer(
 }
 
 void full_slicer(goto_modelt &goto_model)
+{
+  full_slicer(goto_model, false, "");
+}
+
+void full_slicer(
+  goto_modelt &goto_model,
+  bool use_system_dependence_graph,
+  const std::string &system_dependence_graph_cache)
 {
   assert_criteriont a;
   const namespacet ns(goto_model.symbol_table);
-  full_slicert()(goto_model.goto_functions, ns, a);
+  full_slicert{use_system_dependence_graph, system_dependence_graph_cache}(
+    goto_model.goto_functions, ns, a);
 }
 
 void property_slicer(
@@ -380,8 +452,19 @@ void property_slicer(
   goto_modelt &goto_model,
   const std::list<std::string> &properties)
 {
+  property_slicer(goto_model, properties, false, "");
+}
+
+void property_slicer(
+  goto_modelt &goto_model,
+  const std::list<std::string> &properties,
+  bool use_system_dependence_graph,
+  const std::string &system_dependence_graph_cache)
+{
+  properties_criteriont p(properties);
   const namespacet ns(goto_model.symbol_table);
-  property_slicer(goto_model.goto_functions, ns, properties);
+  full_slicert{use_system_dependence_graph, system_dependence_graph_cache}(
+    goto_model.goto_functions, ns, p);
 }
 
 slicing_criteriont::~slicing_criteriont()
@@ -23,6 +23,18 @@ void full_slicer(
 
 void full_slicer(goto_modelt &);
 
+/// Slice away instructions that do not affect any assertion
+/// \param use_system_dependence_graph: Compute dependencies with a
+///   \ref system_dependence_grapht, which is less precise but scales to much
+///   larger programs than \ref dependence_grapht
+/// \param system_dependence_graph_cache: If not empty, a file to read the
+///   system dependence graph from if it was written for the same program, and
+///   to write it to otherwise
+void full_slicer(
+  goto_modelt &,
+  bool use_system_dependence_graph,
+  const std::string &system_dependence_graph_cache);
+
 void property_slicer(
   goto_functionst &,
   const namespacet &,
@@ -32,6 +44,15 @@ void property_slicer(
   goto_modelt &,
   const std::list<std::string> &properties);
 
+/// Slice away instructions that do not affect any of \p properties, see
+/// \ref full_slicer for \p use_system_dependence_graph and
+/// \p system_dependence_graph_cache
+void property_slicer(
+  goto_modelt &,
+  const std::list<std::string> &properties,
+  bool use_system_dependence_graph,
+  const std::string &system_dependence_graph_cache);
+
 class slicing_criteriont
 {
 public:
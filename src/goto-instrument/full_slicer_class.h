@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 #define CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 
+#include <functional>
 #include <stack>
 #include <vector>
 #include <list>
@@ -20,6 +21,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/cfg.h>
 
 #include <analyses/dependence_graph.h>
+#include <analyses/system_dependence_graph.h>
 
 #include "full_slicer.h"
 
@@ -38,12 +40,29 @@ echo 'digraph g {' > c.dot ; cat c.goto | \
 class full_slicert
 {
 public:
+  full_slicert() = default;
+
+  /// \param _use_system_dependence_graph: Compute dependencies with a
+  ///   \ref system_dependence_grapht instead of a \ref dependence_grapht
+  /// \param _system_dependence_graph_cache: File to reuse the system
+  ///   dependence graph from, see \ref full_slicer
+  full_slicert(
+    bool _use_system_dependence_graph,
+    std::string _system_dependence_graph_cache)
+    : use_system_dependence_graph(_use_system_dependence_graph),
+      system_dependence_graph_cache(std::move(_system_dependence_graph_cache))
+  {
+  }
+
   void operator()(
     goto_functionst &goto_functions,
     const namespacet &ns,
     const slicing_criteriont &criterion);
 
 protected:
+  bool use_system_dependence_graph = false;
+  std::string system_dependence_graph_cache;
+
   struct cfg_nodet
   {
     cfg_nodet():node_required(false)
@@ -65,12 +84,16 @@ class full_slicert
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet> decl_deadt;
 
+  typedef std::function<void(const cfgt::nodet &, queuet &)>
+    add_dependenciest;
+
   void fixedpoint(
     goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
-    const dependence_grapht &dep_graph);
+    const add_dependenciest &add_dependencies,
+    const dependence_grapht::post_dominators_mapt &post_dominators);
 
   void add_dependencies(
     const cfgt::nodet &node,
@@ -78,6 +101,14 @@ class full_slicert
     const dependence_grapht &dep_graph,
     const dep_node_to_cfgt &dep_node_to_cfg);
 
+  /// Add the instructions \p node depends on according to \p sdg, looking
+  /// through the join and object nodes not marked in \p expanded yet
+  void add_dependencies(
+    const cfgt::nodet &node,
+    queuet &queue,
+    const system_dependence_grapht &sdg,
+    std::vector<bool> &expanded);
+
   void add_function_calls(
     const cfgt::nodet &node,
     queuet &queue,
@@ -94,6 +94,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "nondet_static.h"
 #include "nondet_volatile.h"
 #include "points_to.h"
+#include "points_to_fp_removal.h"
 #include "race_check.h"
 #include "reachability_slicer.h"
 #include "remove_function.h"
@@ -223,7 +224,7 @@ int goto_instrument_parse_optionst::doit()
           unwind_strategy=goto_unwindt::unwind_strategyt::CONTINUE;
         }
 
-        goto_unwindt goto_unwind;
+        goto_unwindt goto_unwind(cmdline.isset("log"));
         goto_unwind(goto_model, unwindset, unwind_strategy);
 
         if(cmdline.isset("log"))
@@ -862,10 +863,45 @@ int goto_instrument_parse_optionst::doit()
       remove_calls_no_bodyt remove_calls_no_body;
       remove_calls_no_body(goto_model.goto_functions, ui_message_handler);
 
+      acceleration_optionst acceleration_options;
+      acceleration_options.use_z3 = cmdline.isset("z3");
+
+      if(cmdline.isset("accelerate-jobs"))
+      {
+        const auto jobs =
+          string2optional_unsigned(cmdline.get_value("accelerate-jobs"));
+        if(!jobs.has_value() || *jobs == 0)
+        {
+          throw invalid_command_line_argument_exceptiont(
+            "the number of jobs must be a positive number",
+            "--accelerate-jobs");
+        }
+        acceleration_options.jobs = *jobs;
+      }
+
+      if(cmdline.isset("accelerate-time-limit"))
+      {
+        const auto seconds =
+          string2optional_unsigned(cmdline.get_value("accelerate-time-limit"));
+        if(!seconds.has_value())
+        {
+          throw invalid_command_line_argument_exceptiont(
+            "the time limit must be a number of seconds",
+            "--accelerate-time-limit");
+        }
+        acceleration_options.loop_time_limit = std::chrono::seconds(*seconds);
+      }
+
+      if(cmdline.isset("accelerate-cache"))
+      {
+        acceleration_options.cache_directory =
+          cmdline.get_value("accelerate-cache");
+      }
+
       log.status() << "Accelerating" << messaget::eom;
       guard_managert guard_manager;
       accelerate_functions(
-        goto_model, ui_message_handler, cmdline.isset("z3"), guard_manager);
+        goto_model, ui_message_handler, acceleration_options, guard_manager);
       remove_skip(goto_model);
     }
 
@@ -1246,6 +1282,12 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_indirect_call_and_rtti_removal();
   }
 
+  if(cmdline.isset("points-to-fp-removal"))
+  {
+    points_to_fp_removal(goto_model, ui_message_handler);
+    do_indirect_call_and_rtti_removal();
+  }
+
   // replace function pointers, if explicitly requested
   if(cmdline.isset("remove-function-pointers"))
   {
@@ -1323,6 +1365,24 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     goto_model.goto_functions.compute_loop_numbers();
   }
 
+  if(cmdline.isset("cost-inline"))
+  {
+    do_indirect_call_and_rtti_removal();
+
+    goto_inline_cost_modelt cost_model;
+    if(cmdline.isset("inline-growth-limit"))
+    {
+      cost_model.growth_limit =
+        safe_string2size_t(cmdline.get_value("inline-growth-limit"));
+    }
+
+    log.status() << "Cost-based inlining" << messaget::eom;
+    goto_cost_inline(goto_model, ui_message_handler, cost_model, true);
+
+    goto_model.goto_functions.update();
+    goto_model.goto_functions.compute_loop_numbers();
+  }
+
   if(cmdline.isset("remove-calls-no-body"))
   {
     log.status() << "Removing calls to functions without a body"
@@ -1530,6 +1590,18 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       const unsigned max_po_trans=
         cmdline.isset("max-po-trans")?
         unsafe_string2unsigned(cmdline.get_value("max-po-trans")):0;
+      const std::size_t max_cycles =
+        cmdline.isset("max-cycles")
+          ? safe_string2size_t(cmdline.get_value("max-cycles"))
+          : 0;
+      const std::size_t cycles_time_limit =
+        cmdline.isset("cycles-time-limit")
+          ? safe_string2size_t(cmdline.get_value("cycles-time-limit"))
+          : 0;
+      const std::size_t scc_jobs =
+        cmdline.isset("scc-jobs")
+          ? safe_string2size_t(cmdline.get_value("scc-jobs"))
+          : 1;
 
       if(mm=="tso")
       {
@@ -1587,7 +1659,10 @@ void goto_instrument_parse_optionst::instrument_goto_program()
           cmdline.isset("cav11"),
           cmdline.isset("hide-internals"),
           ui_message_handler,
-          cmdline.isset("ignore-arrays"));
+          cmdline.isset("ignore-arrays"),
+          max_cycles,
+          cycles_time_limit,
+          scc_jobs);
     }
 
     // Interrupt handler
@@ -1723,13 +1798,24 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_remove_returns();
 
     log.status() << "Performing a full slice" << messaget::eom;
+    // full_slicer requires that the model has unique location numbers:
+    goto_model.goto_functions.update();
+    const bool use_system_dependence_graph =
+      cmdline.isset("full-slice-sdg") || cmdline.isset("full-slice-sdg-cache");
     if(cmdline.isset("property"))
-      property_slicer(goto_model, cmdline.get_values("property"));
+    {
+      property_slicer(
+        goto_model,
+        cmdline.get_values("property"),
+        use_system_dependence_graph,
+        cmdline.get_value("full-slice-sdg-cache"));
+    }
     else
     {
-      // full_slicer requires that the model has unique location numbers:
-      goto_model.goto_functions.update();
-      full_slicer(goto_model);
+      full_slicer(
+        goto_model,
+        use_system_dependence_graph,
+        cmdline.get_value("full-slice-sdg-cache"));
     }
   }
 
@@ -1918,6 +2004,11 @@ void goto_instrument_parse_optionst::help()
     " --constant-propagator        propagate constants and simplify expressions\n" // NOLINT(*)
     " --inline                     perform full inlining\n"
     " --partial-inline             perform partial inlining\n"
+    " --cost-inline                inline calls chosen by a cost model of\n"
+    "                              callee size, call sites and constant\n"
+    "                              arguments\n"
+    " --inline-growth-limit <p>    grow the program by at most p percent\n"
+    "                              with --cost-inline (default: 50)\n"
     " --function-inline <function> transitively inline all calls <function> makes\n" // NOLINT(*)
     " --no-caching                 disable caching of intermediate results during transitive function inlining\n" // NOLINT(*)
     " --log <file>                 log in json format which code segments were inlined, use with --function-inline\n" // NOLINT(*)
@@ -1926,6 +2017,10 @@ void goto_instrument_parse_optionst::help()
     " --value-set-fi-fp-removal    build flow-insensitive value set and replace function pointers by a case statement\n" // NOLINT(*)
     "                              over the possible assignments. If the set of possible assignments is empty the function pointer\n" // NOLINT(*)
     "                              is removed using the standard remove-function-pointers pass. \n" // NOLINT(*)
+    " --points-to-fp-removal       build inclusion-based points-to sets and replace function pointers by a case\n" // NOLINT(*)
+    "                              statement over the functions they may point to. Function pointers that may\n" // NOLINT(*)
+    "                              point to unknown objects are removed using the standard\n" // NOLINT(*)
+    "                              remove-function-pointers pass.\n" // NOLINT(*)
     "\n"
     "Loop information and transformations:\n"
     HELP_UNWINDSET
@@ -1939,6 +2034,10 @@ void goto_instrument_parse_optionst::help()
     " --havoc-loops                over-approximate all loops\n"
     " --accelerate                 add loop accelerators\n"
     " --z3                         use Z3 when computing loop accelerators\n"
+    " --accelerate-jobs <n>        compute loop accelerators with n processes\n"
+    " --accelerate-time-limit <s>  stop accelerating further paths of a loop\n"
+    "                              after s seconds\n"
+    " --accelerate-cache <dir>     reuse loop accelerators stored in dir\n"
     " --skip-loops <loop-ids>      add gotos to skip selected loops during execution\n" // NOLINT(*)
     " --show-lexical-loops         show single-entry-single-back-edge loops\n"
     " --show-natural-loops         show natural loop heads\n"
@@ -1949,6 +2048,13 @@ void goto_instrument_parse_optionst::help()
     "Slicing:\n"
     HELP_REACHABILITY_SLICER
     " --full-slice                 slice away instructions that don't affect assertions\n" // NOLINT(*)
+    " --full-slice-sdg             compute the dependencies for --full-slice\n"
+    "                              with a system dependence graph, which is\n"
+    "                              less precise but scales to large programs\n"
+    " --full-slice-sdg-cache file  as --full-slice-sdg, reusing the system\n"
+    "                              dependence graph stored in file if it was\n"
+    "                              computed for the same program, and storing\n"
+    "                              it there otherwise\n"
     " --property id                slice with respect to specific property only\n" // NOLINT(*)
     " --slice-global-inits         slice away initializations of unused global variables\n" // NOLINT(*)
     " --aggressive-slice           remove bodies of any functions not on the shortest path between\n" // NOLINT(*)
@@ -76,10 +76,13 @@ Author: Daniel Kroening, kroening@kroening.com
   "(custom-bitvector-analysis)" \
   "(show-struct-alignment)(interval-analysis)(show-intervals)" \
   "(show-uninitialized)(show-locations)" \
-  "(full-slice)(reachability-slice)(slice-global-inits)" \
+  "(full-slice)(full-slice-sdg)(full-slice-sdg-cache):" \
+  "(reachability-slice)(slice-global-inits)" \
   "(fp-reachability-slice):" \
   "(inline)(partial-inline)(function-inline):(log):(no-caching)" \
+  "(cost-inline)(inline-growth-limit):" \
   "(value-set-fi-fp-removal)" \
+  "(points-to-fp-removal)" \
   OPT_REMOVE_CONST_FUNCTION_POINTERS \
   "(print-internal-representation)" \
   "(remove-function-pointers)" \
@@ -89,6 +92,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(show-natural-loops)(show-lexical-loops)(accelerate)(havoc-loops)" \
   "(verbosity):(version)(xml-ui)(json-ui)" \
   "(accelerate)(constant-propagator)" \
+  "(accelerate-jobs):(accelerate-time-limit):(accelerate-cache):" \
   "(k-induction):(step-case)(base-case)" \
   "(show-call-sequences)(check-call-sequence)" \
   "(interpreter)(show-reaching-definitions)" \
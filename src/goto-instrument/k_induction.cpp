@@ -76,7 +76,7 @@ void k_inductiont::process_loop(
   if(base_case)
   {
     // now unwind k times
-    goto_unwindt goto_unwind;
+    goto_unwindt goto_unwind(false);
     goto_unwind.unwind(
       function_id,
       goto_function.body,
@@ -107,7 +107,7 @@ void k_inductiont::process_loop(
     // unwind to get k+1 copies
     std::vector<goto_programt::targett> iteration_points;
 
-    goto_unwindt goto_unwind;
+    goto_unwindt goto_unwind(false);
     goto_unwind.unwind(
       function_id,
       goto_function.body,
@@ -0,0 +1,108 @@
+/*******************************************************************\
+
+Module: Function Pointer Removal Using Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Function pointer removal using an inclusion-based points-to analysis
+
+#include "points_to_fp_removal.h"
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/remove_function_pointers.h>
+
+#include <pointer-analysis/andersen_points_to.h>
+
+void points_to_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget log{message_handler};
+  log.status() << "Computing inclusion-based points-to sets" << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+  andersen_points_tot points_to(ns);
+  points_to(goto_model.goto_functions);
+
+  const auto &statistics = points_to.statistics();
+  log.statistics() << "Points-to analysis: " << statistics.nodes << " nodes, "
+                   << statistics.objects << " objects, " << statistics.edges
+                   << " edges, " << statistics.collapsed_nodes
+                   << " nodes collapsed on cycles, " << statistics.iterations
+                   << " iterations" << messaget::eom;
+
+  std::size_t call_sites = 0;
+  std::size_t resolved = 0;
+  std::size_t targets = 0;
+
+  for(auto &f : goto_model.goto_functions.function_map)
+  {
+    for(auto target = f.second.body.instructions.begin();
+        target != f.second.body.instructions.end();
+        target++)
+    {
+      if(
+        !target->is_function_call() ||
+        as_const(*target).call_function().id() != ID_dereference)
+      {
+        continue;
+      }
+
+      ++call_sites;
+
+      const auto called_functions = points_to.called_functions(target);
+      if(!called_functions.has_value())
+        continue;
+
+      const code_typet &call_type =
+        to_code_type(as_const(*target).call_function().type());
+      const bool return_value_used = as_const(*target).call_lhs().is_not_nil();
+
+      std::unordered_set<symbol_exprt, irep_hash> functions;
+      for(const auto &identifier : *called_functions)
+      {
+        const symbolt *symbol;
+        if(
+          !ns.lookup(identifier, symbol) &&
+          function_is_type_compatible(
+            return_value_used, call_type, to_code_type(symbol->type), ns))
+        {
+          functions.insert(symbol->symbol_expr());
+        }
+      }
+
+      if(functions.empty())
+        continue;
+
+      ++resolved;
+      targets += functions.size();
+
+      remove_function_pointer(
+        message_handler,
+        goto_model.symbol_table,
+        f.second.body,
+        f.first,
+        target,
+        functions);
+    }
+  }
+
+  goto_model.goto_functions.update();
+
+  log.statistics() << "Resolved " << resolved << " of " << call_sites
+                   << " calls through function pointers";
+  if(resolved != 0)
+  {
+    log.statistics() << " with on average "
+                     << static_cast<double>(targets) / resolved
+                     << " targets per call";
+  }
+  log.statistics() << messaget::eom;
+}
@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: Function Pointer Removal Using Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Function pointer removal using an inclusion-based points-to analysis
+
+#ifndef CPROVER_GOTO_INSTRUMENT_POINTS_TO_FP_REMOVAL_H
+#define CPROVER_GOTO_INSTRUMENT_POINTS_TO_FP_REMOVAL_H
+
+class goto_modelt;
+class message_handlert;
+
+/// Runs a whole-program inclusion-based points-to analysis and replaces each
+/// call through a function pointer by a case split over the type-compatible
+/// functions the pointer may point to. Calls through pointers that may point
+/// to unknown objects or to no function are left in place, such that
+/// remove_function_pointers should be run after this to guarantee removal of
+/// all function pointers.
+/// \param goto_model: goto model to be modified
+/// \param message_handler: message handler for status output and statistics
+void points_to_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_POINTS_TO_FP_REMOVAL_H
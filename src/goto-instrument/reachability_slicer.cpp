@@ -43,14 +43,24 @@ void reachability_slicert::operator()(
   cfg(goto_functions);
   for(const auto &gf_entry : goto_functions.function_map)
   {
-    forall_goto_program_instructions(i_it, gf_entry.second.body)
+    const goto_programt &body = gf_entry.second.body;
+    forall_goto_program_instructions(i_it, body)
       cfg[cfg.entry_map[i_it]].function_id = gf_entry.first;
+
+    if(!body.instructions.empty())
+    {
+      function_ends.emplace(
+        gf_entry.first,
+        cfg.get_node_index(std::prev(body.instructions.end())));
+    }
   }
 
   is_threadedt is_threaded(goto_functions);
-  fixedpoint_to_assertions(is_threaded, criterion);
+  const std::vector<cfgt::node_indext> sources =
+    get_sources(is_threaded, criterion);
+  fixedpoint_to_assertions(sources);
   if(include_forward_reachability)
-    fixedpoint_from_assertions(is_threaded, criterion);
+    fixedpoint_from_assertions(sources);
   slice(goto_functions);
 }
 
@@ -199,14 +209,10 @@ void reachability_slicert::backward_inwards_walk_from(
 /// goto program, starting from the nodes corresponding to the criterion and
 /// the instructions that might be executed concurrently. Set reaches_assertion
 /// to true for every instruction visited.
-/// \param is_threaded: Instructions that might be executed concurrently
-/// \param criterion: the criterion we are trying to hit
+/// \param sources: The nodes to start from, see \ref get_sources
 void reachability_slicert::fixedpoint_to_assertions(
-  const is_threadedt &is_threaded,
-  const slicing_criteriont &criterion)
+  const std::vector<cfgt::node_indext> &sources)
 {
-  std::vector<cfgt::node_indext> sources = get_sources(is_threaded, criterion);
-
   // First walk outwards towards __CPROVER_start, visiting all possible callers
   // and stepping over but recording callees as we go:
   std::vector<cfgt::node_indext> return_sites =
@@ -236,17 +242,18 @@ void reachability_slicert::forward_walk_call_instruction(
 
   auto callsite_successor_pc = std::next(call_node.PC);
 
-  auto successor_pc = cfg[successor_index].PC;
-  if(!is_same_target(successor_pc, callsite_successor_pc))
+  const auto &successor_node = cfg[successor_index];
+  if(!is_same_target(successor_node.PC, callsite_successor_pc))
   {
     // Real call -- store the callee head node:
     callee_head_stack.push_back(successor_index);
 
     // Check if it can return, and if so store the callsite's successor:
-    while(!successor_pc->is_end_function())
-      ++successor_pc;
+    const auto end = function_ends.find(successor_node.function_id);
+    INVARIANT(
+      end != function_ends.end(), "called functions should have a body");
 
-    if(!cfg.get_node(successor_pc).out.empty())
+    if(!cfg[end->second].out.empty())
       callsite_successor_stack.push_back(
         cfg.get_node_index(callsite_successor_pc));
   }
@@ -336,16 +343,12 @@ void reachability_slicert::forward_inwards_walk_from(
 
 /// Perform forwards depth-first search of the control-flow graph of the
 /// goto program, starting from the nodes corresponding to the criterion and
-/// the instructions that might be executed concurrently. Set reaches_assertion
-/// to true for every instruction visited.
-/// \param is_threaded: Instructions that might be executed concurrently
-/// \param criterion: the criterion we are trying to hit
+/// the instructions that might be executed concurrently. Set
+/// reachable_from_assertion to true for every instruction visited.
+/// \param sources: The nodes to start from, see \ref get_sources
 void reachability_slicert::fixedpoint_from_assertions(
-  const is_threadedt &is_threaded,
-  const slicing_criteriont &criterion)
+  const std::vector<cfgt::node_indext> &sources)
 {
-  std::vector<cfgt::node_indext> sources = get_sources(is_threaded, criterion);
-
   // First walk outwards towards __CPROVER_start, visiting all possible callers
   // and stepping over but recording callees as we go:
   std::vector<cfgt::node_indext> return_sites =
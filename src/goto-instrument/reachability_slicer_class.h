@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_program.h>
 
+#include <unordered_map>
+
 class goto_functionst;
 class message_handlert;
 class slicing_criteriont;
@@ -46,6 +48,11 @@ class reachability_slicert
   typedef cfg_baset<slicer_entryt> cfgt;
   cfgt cfg;
 
+  /// The END_FUNCTION node of each function with a non-empty body. This
+  /// summarises whether calls to the function can return without walking its
+  /// body at each call site.
+  std::unordered_map<irep_idt, cfgt::node_indext> function_ends;
+
   typedef std::stack<cfgt::entryt> queuet;
 
   /// A search stack entry, used in tracking nodes to mark reachable when
@@ -71,13 +78,10 @@ class reachability_slicert
     }
   };
 
-  void fixedpoint_to_assertions(
-    const is_threadedt &is_threaded,
-    const slicing_criteriont &criterion);
+  void fixedpoint_to_assertions(const std::vector<cfgt::node_indext> &sources);
 
-  void fixedpoint_from_assertions(
-    const is_threadedt &is_threaded,
-    const slicing_criteriont &criterion);
+  void
+  fixedpoint_from_assertions(const std::vector<cfgt::node_indext> &sources);
 
   void slice(goto_functionst &goto_functions);
 
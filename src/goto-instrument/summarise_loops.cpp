@@ -0,0 +1,274 @@
+/*******************************************************************\
+
+Module: Summarise Loops Using Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Summarise loops using invariants computed by abstract interpretation
+
+#include "summarise_loops.h"
+
+#include <util/exception_utils.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/format_expr.h>
+#include <util/message.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/ai.h>
+#include <analyses/local_may_alias.h>
+#include <analyses/natural_loops.h>
+
+#include "havoc_utils.h"
+#include "loop_utils.h"
+#include "widening_analysis.h"
+
+class summarise_loopst
+{
+public:
+  typedef goto_functionst::goto_functiont goto_functiont;
+
+  summarise_loopst(
+    const irep_idt &_function_id,
+    goto_functiont &_goto_function,
+    const ai_baset &_ai,
+    const namespacet &_ns,
+    messaget &_log)
+    : function_id(_function_id),
+      goto_function(_goto_function),
+      ai(_ai),
+      ns(_ns),
+      log(_log),
+      local_may_alias(_goto_function),
+      natural_loops(_goto_function.body)
+  {
+  }
+
+  std::size_t operator()();
+
+protected:
+  const irep_idt &function_id;
+  goto_functiont &goto_function;
+  const ai_baset &ai;
+  const namespacet &ns;
+  messaget &log;
+  local_may_aliast local_may_alias;
+  natural_loops_mutablet natural_loops;
+
+  bool can_summarise(const goto_programt::targett loop_head, const loopt &loop)
+    const;
+
+  exprt get_invariant(const goto_programt::targett loop_head, const loopt &loop)
+    const;
+
+  void summarise_loop(
+    goto_programt::targett loop_head,
+    const loopt &loop,
+    const assignst &assigns,
+    const exprt &invariant);
+};
+
+/// Only innermost loops that consist of instructions with known effects are
+/// summarised: function calls, threads, exceptions and other instructions
+/// could modify objects that are not covered by the havoc.
+bool summarise_loopst::can_summarise(
+  const goto_programt::targett loop_head,
+  const loopt &loop) const
+{
+  for(const auto &instruction : loop)
+  {
+    if(instruction != loop_head && natural_loops.is_loop_header(instruction))
+      return false;
+
+    switch(instruction->type())
+    {
+    case ASSIGN:
+    case GOTO:
+    case ASSERT:
+    case ASSUME:
+    case SKIP:
+    case LOCATION:
+    case DECL:
+    case DEAD:
+      break;
+    case FUNCTION_CALL:
+    case OTHER:
+    case START_THREAD:
+    case END_THREAD:
+    case ATOMIC_BEGIN:
+    case ATOMIC_END:
+    case SET_RETURN_VALUE:
+    case END_FUNCTION:
+    case THROW:
+    case CATCH:
+    case INCOMPLETE_GOTO:
+    case NO_INSTRUCTION_TYPE:
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Add the conjuncts of \p expr, flattening nested conjunctions, to \p dest.
+static void collect_conjuncts(const exprt &expr, exprt::operandst &dest)
+{
+  if(expr.id() == ID_and)
+  {
+    for(const auto &op : expr.operands())
+      collect_conjuncts(op, dest);
+  }
+  else
+    dest.push_back(expr);
+}
+
+/// Compute the loop-head invariant as the conjunction of those facts
+/// established by the abstract interpreter that only mention variables that
+/// are used in the loop and are in scope at the loop head.
+exprt summarise_loopst::get_invariant(
+  const goto_programt::targett loop_head,
+  const loopt &loop) const
+{
+  const auto state = ai.abstract_state_before(loop_head);
+  if(state->is_bottom() || state->is_top())
+    return true_exprt{};
+
+  find_symbols_sett loop_symbols;
+  find_symbols_sett declared_in_loop;
+  for(const auto &instruction : loop)
+  {
+    instruction->apply([&loop_symbols](const exprt &expr) {
+      find_symbols(expr, loop_symbols);
+    });
+    if(instruction->is_decl())
+      declared_in_loop.insert(instruction->decl_symbol().get_identifier());
+  }
+
+  exprt::operandst facts;
+  collect_conjuncts(state->to_predicate(), facts);
+
+  exprt::operandst conjuncts;
+  for(const auto &conjunct : facts)
+  {
+    bool in_scope = true;
+    for(const auto &identifier : find_symbol_identifiers(conjunct))
+    {
+      if(
+        loop_symbols.count(identifier) == 0 ||
+        declared_in_loop.count(identifier) != 0)
+      {
+        in_scope = false;
+        break;
+      }
+    }
+
+    if(in_scope && !conjunct.is_true())
+      conjuncts.push_back(conjunct);
+  }
+
+  return conjunction(conjuncts);
+}
+
+void summarise_loopst::summarise_loop(
+  goto_programt::targett loop_head,
+  const loopt &loop,
+  const assignst &assigns,
+  const exprt &invariant)
+{
+  const source_locationt loop_location = loop_head->source_location();
+
+  // Cut off any path that would take a back edge: the remaining paths
+  // through the loop are exactly those that leave it after one iteration.
+  for(const auto &instruction : loop)
+  {
+    if(instruction->is_goto() && instruction->get_target() == loop_head)
+    {
+      *instruction = goto_programt::make_assumption(
+        boolean_negate(instruction->condition()),
+        instruction->source_location());
+    }
+  }
+
+  goto_programt summary;
+  havoc_utilst havoc_gen(assigns, ns);
+  havoc_gen.append_full_havoc_code(loop_location, summary);
+  summary.add(goto_programt::make_assumption(invariant, loop_location));
+
+  // Use insert_before_swap to preserve jumps to the loop head.
+  goto_function.body.insert_before_swap(loop_head, summary);
+}
+
+std::size_t summarise_loopst::operator()()
+{
+  std::size_t summarised = 0;
+
+  for(const auto &loop_entry : natural_loops.loop_map)
+  {
+    const goto_programt::targett loop_head = loop_entry.first;
+    const loopt &loop = loop_entry.second;
+
+    if(loop.empty() || !can_summarise(loop_head, loop))
+      continue;
+
+    assignst assigns;
+    try
+    {
+      get_assigns(local_may_alias, loop, assigns);
+    }
+    catch(const analysis_exceptiont &)
+    {
+      // we cannot tell what the loop modifies
+      continue;
+    }
+
+    const exprt invariant = get_invariant(loop_head, loop);
+    if(invariant.is_true())
+      continue;
+
+    log.debug() << "Summarising loop at " << loop_head->source_location()
+                << " in " << function_id << " using invariant "
+                << format(invariant) << messaget::eom;
+
+    summarise_loop(loop_head, loop, assigns, invariant);
+    ++summarised;
+  }
+
+  return summarised;
+}
+
+std::size_t summarise_loops(
+  goto_modelt &goto_model,
+  const ai_baset &ai,
+  message_handlert &message_handler)
+{
+  messaget log{message_handler};
+  const namespacet ns{goto_model.symbol_table};
+  std::size_t summarised = 0;
+
+  for(auto &gf_entry : goto_model.goto_functions.function_map)
+  {
+    summarised +=
+      summarise_loopst{gf_entry.first, gf_entry.second, ai, ns, log}();
+  }
+
+  goto_model.goto_functions.update();
+
+  log.statistics() << "Summarised " << summarised << " loops" << messaget::eom;
+
+  return summarised;
+}
+
+std::size_t
+summarise_loops(goto_modelt &goto_model, message_handlert &message_handler)
+{
+  const std::unique_ptr<ai_baset> ai =
+    make_widening_analysis(goto_model, "intervals", message_handler);
+
+  (*ai)(goto_model);
+
+  return summarise_loops(goto_model, *ai, message_handler);
+}
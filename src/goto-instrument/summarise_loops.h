@@ -0,0 +1,52 @@
+/*******************************************************************\
+
+Module: Summarise Loops Using Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Summarise loops using invariants computed by abstract interpretation
+
+#ifndef CPROVER_GOTO_INSTRUMENT_SUMMARISE_LOOPS_H
+#define CPROVER_GOTO_INSTRUMENT_SUMMARISE_LOOPS_H
+
+#include <cstddef>
+
+class ai_baset;
+class goto_modelt;
+class message_handlert;
+
+/// Replace each innermost loop that neither calls functions nor contains
+/// instructions with unknown side effects by
+///   1. a havoc of all objects the loop may modify,
+///   2. an assumption of the loop-head invariant computed by \p ai,
+///   3. a single iteration of the loop body, after which any path that
+///      would take a back edge is cut off.
+/// All assertions in the loop body are thus checked for any state satisfying
+/// the invariant, and the state after the loop satisfies the invariant and
+/// the negated loop condition. Loops for which \p ai does not provide a
+/// non-trivial invariant over the variables used in the loop are left
+/// unchanged. The result is sound as long as \p ai is, but may yield spurious
+/// counterexamples when the invariant is too weak.
+/// \param goto_model: goto model to transform
+/// \param ai: abstract interpreter that has been run on \p goto_model
+/// \param message_handler: message handler for progress and statistics
+/// \return number of loops that were summarised
+std::size_t summarise_loops(
+  goto_modelt &goto_model,
+  const ai_baset &ai,
+  message_handlert &message_handler);
+
+/// Run an interval analysis (variable-sensitivity domain, widening after
+/// a few iterations of each loop) on \p goto_model and use its results to
+/// summarise loops as described in
+/// \ref summarise_loops(goto_modelt &, const ai_baset &, message_handlert &).
+/// \param goto_model: goto model to transform
+/// \param message_handler: message handler for progress and statistics
+/// \return number of loops that were summarised
+std::size_t
+summarise_loops(goto_modelt &goto_model, message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_SUMMARISE_LOOPS_H
@@ -23,60 +23,80 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "unwindset.h"
 
+#include <unordered_map>
+
+goto_unwindt::segmentt::segmentt(
+  const goto_programt::const_targett start,
+  const goto_programt::const_targett end)
+{
+  PRECONDITION(start->location_number < end->location_number);
+
+  for(goto_programt::const_targett t = start; t != end; t++)
+    instructions.push_back(t);
+
+  // Instructions of earlier copies share location numbers, thus identify
+  // instructions by their address
+  std::unordered_map<const goto_programt::instructiont *, std::size_t>
+    positions;
+  positions.reserve(instructions.size());
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+    positions.emplace(&*instructions[i], i);
+
+  target_positions.reserve(instructions.size());
+  for(const auto &t : instructions)
+  {
+    std::size_t target_position = instructions.size();
+
+    if(t->is_goto())
+    {
+      const auto p_it = positions.find(&*t->get_target());
+      if(p_it != positions.end())
+        target_position = p_it->second;
+    }
+
+    target_positions.push_back(target_position);
+  }
+}
+
 void goto_unwindt::copy_segment(
   const goto_programt::const_targett start,
   const goto_programt::const_targett end, // exclusive
   goto_programt &goto_program) // result
 {
-  PRECONDITION(start->location_number < end->location_number);
   PRECONDITION(goto_program.empty());
 
-  // build map for branch targets inside the loop
-  typedef std::map<goto_programt::const_targett, unsigned> target_mapt;
-  target_mapt target_map;
-
-  unsigned i=0;
+  std::vector<goto_programt::targett> copied;
+  copy_segment(segmentt(start, end), goto_program, copied);
+}
 
-  for(goto_programt::const_targett t=start; t!=end; t++, i++)
-    target_map[t]=i;
+goto_programt::targett goto_unwindt::copy_segment(
+  const segmentt &segment,
+  goto_programt &goto_program,
+  std::vector<goto_programt::targett> &copied)
+{
+  PRECONDITION(!segment.instructions.empty());
 
-  // make a copy
-  std::vector<goto_programt::targett> target_vector;
-  target_vector.reserve(target_map.size());
-  CHECK_RETURN(target_vector.empty());
+  copied.clear();
+  copied.reserve(segment.instructions.size());
 
-  for(goto_programt::const_targett t=start; t!=end; t++)
+  for(const auto &t : segment.instructions)
   {
     // copy the instruction
     goto_programt::targett t_new =
       goto_program.add(goto_programt::instructiont(*t));
     unwind_log.insert(t_new, t->location_number);
-    target_vector.push_back(t_new); // store copied instruction
+    copied.push_back(t_new);
   }
 
-  CHECK_RETURN(goto_program.instructions.size() == target_vector.size());
-
   // adjust intra-segment gotos
-  for(std::size_t target_index = 0; target_index < target_vector.size();
-      target_index++)
+  for(std::size_t i = 0; i < copied.size(); ++i)
   {
-    goto_programt::targett t = target_vector[target_index];
-
-    if(!t->is_goto())
-      continue;
-
-    goto_programt::const_targett tgt=t->get_target();
-
-    target_mapt::const_iterator m_it=target_map.find(tgt);
-
-    if(m_it!=target_map.end())
-    {
-      unsigned j=m_it->second;
-
-      DATA_INVARIANT(j < target_vector.size(), "in bounds");
-      t->set_target(target_vector[j]);
-    }
+    const std::size_t j = segment.target_positions[i];
+    if(j < copied.size())
+      copied[i]->set_target(copied[j]);
   }
+
+  return copied.back();
 }
 
 void goto_unwindt::unwind(
@@ -230,15 +250,13 @@ void goto_unwindt::unwind(
     }
 
     // k-1 additional copies
-    for(unsigned i=1; i<k; i++)
+    if(k > 1)
     {
-      goto_programt tmp_program;
-      copy_segment(loop_head, loop_exit, tmp_program);
-      CHECK_RETURN(!tmp_program.instructions.empty());
-
-      iteration_points[i]=--tmp_program.instructions.end();
+      const segmentt segment(loop_head, loop_exit);
+      std::vector<goto_programt::targett> copied;
 
-      copies.destructive_append(tmp_program);
+      for(unsigned i = 1; i < k; i++)
+        iteration_points[i] = copy_segment(segment, copies, copied);
     }
   }
   else
@@ -21,6 +21,13 @@ class unwindsett;
 class goto_unwindt
 {
 public:
+  /// \param keep_log: whether to record \ref unwind_log, which is only
+  ///   needed for \ref output_log_json
+  explicit goto_unwindt(bool keep_log = true)
+  {
+    unwind_log.enabled = keep_log;
+  }
+
   enum class unwind_strategyt
   {
     CONTINUE,
@@ -100,12 +107,17 @@ class goto_unwindt
       const goto_programt::const_targett target,
       const unsigned location_number)
     {
+      if(!enabled)
+        return;
+
       auto r=location_map.insert(std::make_pair(target, location_number));
       INVARIANT(r.second, "target already exists");
     }
 
     typedef std::map<goto_programt::const_targett, unsigned> location_mapt;
     location_mapt location_map;
+
+    bool enabled = true;
   };
 
   unwind_logt unwind_log;
@@ -121,6 +133,31 @@ class goto_unwindt
     const goto_programt::const_targett start,
     const goto_programt::const_targett end, // exclusive
     goto_programt &goto_program); // result
+
+  /// The instructions of a loop, with the targets of gotos within the loop
+  /// given by their positions, such that the loop can be copied repeatedly
+  /// without looking up any targets.
+  class segmentt
+  {
+  public:
+    segmentt(
+      const goto_programt::const_targett start,
+      const goto_programt::const_targett end); // exclusive
+
+    std::vector<goto_programt::const_targett> instructions;
+
+    /// For each instruction, the position of the target of a goto within the
+    /// segment, or `instructions.size()` if there is none
+    std::vector<std::size_t> target_positions;
+  };
+
+  /// Append a copy of \p segment to \p goto_program, using \p copied as
+  /// scratch space.
+  /// \return the last instruction of the copy
+  goto_programt::targett copy_segment(
+    const segmentt &segment,
+    goto_programt &goto_program,
+    std::vector<goto_programt::targett> &copied);
 };
 
 #endif // CPROVER_GOTO_INSTRUMENT_UNWIND_H
@@ -0,0 +1,64 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation for Program Transformations
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// The abstract interpreter that transformations using invariants run
+
+#include "widening_analysis.h"
+
+#include <util/invariant.h>
+#include <util/make_unique.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/ai.h>
+#include <analyses/local_control_flow_history.h>
+#include <analyses/octagon_domain.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_domain.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_object_factory.h>
+
+/// Number of iterations of each loop the analysis performs before it starts
+/// widening.
+#define WIDENING_ANALYSIS_DELAY 3
+
+bool is_widening_analysis_domain(const std::string &domain)
+{
+  return domain == "constants" || domain == "intervals" ||
+         domain == "octagons";
+}
+
+std::unique_ptr<ai_baset> make_widening_analysis(
+  const goto_modelt &goto_model,
+  const std::string &domain,
+  message_handlert &message_handler)
+{
+  PRECONDITION(is_widening_analysis_domain(domain));
+
+  std::unique_ptr<ai_domain_factory_baset> domain_factory;
+  if(domain == "octagons")
+  {
+    domain_factory = util_make_unique<octagon_domain_factoryt>(
+      goto_model.goto_functions, namespacet{goto_model.symbol_table});
+  }
+  else
+  {
+    const vsd_configt vsd_config = domain == "constants"
+                                     ? vsd_configt::constant_domain()
+                                     : vsd_configt::intervals();
+    domain_factory = util_make_unique<variable_sensitivity_domain_factoryt>(
+      variable_sensitivity_object_factoryt::configured_with(vsd_config),
+      vsd_config);
+  }
+
+  return util_make_unique<ai_recursive_interproceduralt>(
+    util_make_unique<local_control_flow_history_factoryt>(
+      false, true, WIDENING_ANALYSIS_DELAY),
+    std::move(domain_factory),
+    util_make_unique<location_sensitive_storaget>(),
+    message_handler);
+}
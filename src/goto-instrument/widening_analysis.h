@@ -0,0 +1,37 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation for Program Transformations
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// The abstract interpreter that transformations using invariants run
+
+#ifndef CPROVER_GOTO_INSTRUMENT_WIDENING_ANALYSIS_H
+#define CPROVER_GOTO_INSTRUMENT_WIDENING_ANALYSIS_H
+
+#include <memory>
+#include <string>
+
+class ai_baset;
+class goto_modelt;
+class message_handlert;
+
+/// Whether \p domain can be passed to \ref make_widening_analysis
+bool is_widening_analysis_domain(const std::string &domain);
+
+/// An interprocedural, location-sensitive abstract interpreter for
+/// \p goto_model that performs a few iterations of each loop before it
+/// starts widening. It has not been run yet.
+/// \param goto_model: goto model to be analysed
+/// \param domain: name of the abstract domain, one of `constants` and
+///   `intervals` (both using the variable-sensitivity domain) and `octagons`
+/// \param message_handler: message handler for the analysis
+std::unique_ptr<ai_baset> make_widening_analysis(
+  const goto_modelt &goto_model,
+  const std::string &domain,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_WIDENING_ANALYSIS_H
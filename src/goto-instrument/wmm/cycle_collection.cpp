@@ -47,7 +47,65 @@ void event_grapht::graph_explorert::filter_thin_air(
 #endif
 }
 
-/// Tarjan 1972 adapted and modified for events
+/// marks the events from which \p source can be reached, not going through
+/// com edges into events before \p source, as these are removed by
+/// backtrack when exploring from \p source
+void event_grapht::graph_explorert::compute_reaches_source(event_idt source)
+{
+  reaches_source.assign(egraph.size(), false);
+  reaches_source[source]=true;
+
+  std::vector<event_idt> worklist(1, source);
+  while(!worklist.empty())
+  {
+    const event_idt current=worklist.back();
+    worklist.pop_back();
+
+    for(const auto &edge : egraph.po_in(current))
+    {
+      if(!reaches_source[edge.first] && !filtering(edge.first))
+      {
+        reaches_source[edge.first]=true;
+        worklist.push_back(edge.first);
+      }
+    }
+
+    if(current<source)
+      continue;
+
+    for(const auto &edge : egraph.com_in(current))
+    {
+      if(!reaches_source[edge.first] && !filtering(edge.first))
+      {
+        reaches_source[edge.first]=true;
+        worklist.push_back(edge.first);
+      }
+    }
+  }
+}
+
+/// checks the budget set by event_grapht::set_budget_collection, and records
+/// in the graph that the collection is incomplete once it is exhausted
+bool event_grapht::graph_explorert::budget_exhausted(
+  const std::set<critical_cyclet> &set_of_cycles)
+{
+  if(budget_met)
+    return true;
+
+  if(
+    (egraph.max_cycles!=0 && set_of_cycles.size()>=egraph.max_cycles) ||
+    (egraph.cycles_time_limit!=0 &&
+     std::chrono::steady_clock::now()>=deadline))
+  {
+    budget_met=true;
+    egraph.collection_incomplete=true;
+  }
+
+  return budget_met;
+}
+
+/// Tarjan 1972 adapted and modified for events, with the pruning of
+/// Johnson 1975
 void event_grapht::graph_explorert::collect_cycles(
   std::set<critical_cyclet> &set_of_cycles,
   memory_modelt model)
@@ -82,13 +140,24 @@ void event_grapht::graph_explorert::collect_cycles(
   if(order->empty())
     return;
 
+  deadline=
+    std::chrono::steady_clock::now()+
+    std::chrono::seconds(egraph.cycles_time_limit);
+
   for(std::list<event_idt>::const_iterator
       st_it=order->begin();
       st_it!=order->end();
       ++st_it)
   {
+    if(budget_exhausted(set_of_cycles))
+      break;
+
     event_idt source=*st_it;
+    if(filtering(source))
+      continue;
+
     egraph.message.debug() << "explore " << egraph[source].id << messaget::eom;
+    compute_reaches_source(source);
     backtrack(
       set_of_cycles,
       source,
@@ -204,6 +273,10 @@ bool event_grapht::graph_explorert::backtrack(
   if(filtering(vertex))
     return false;
 
+  /* no cycle back to source from here, or out of budget */
+  if(!reaches_source[vertex] || budget_exhausted(set_of_cycles))
+    return false;
+
   egraph.message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
     <<egraph[source].id<<"#"<<source<<" lw:"<<lwfence_met<<" unsafe:"
     <<unsafe_met << messaget::eom;
@@ -14,10 +14,12 @@ Date: 2012
 #ifndef CPROVER_GOTO_INSTRUMENT_WMM_EVENT_GRAPH_H
 #define CPROVER_GOTO_INSTRUMENT_WMM_EVENT_GRAPH_H
 
+#include <chrono>
 #include <list>
 #include <set>
 #include <map>
 #include <iosfwd>
+#include <vector>
 
 #include <util/graph.h>
 #include <util/invariant.h>
@@ -245,6 +247,10 @@ class event_grapht
   unsigned max_po_trans;
   bool ignore_arrays;
 
+  /* budget of each collection of cycles, 0 for no limit */
+  std::size_t max_cycles;
+  std::size_t cycles_time_limit; /* in seconds */
+
   /* graph explorer (for each cycles collection) */
   class graph_explorert
   {
@@ -289,6 +295,17 @@ class event_grapht
        indirect thin-air */
     void filter_thin_air(std::set<critical_cyclet> &set_of_cycles);
 
+    /* events from which the current source can be reached by po and com
+       edges: as in Johnson 1975, the exploration from a source does not
+       enter any other event, as no cycle through the source contains it */
+    std::vector<bool> reaches_source;
+    void compute_reaches_source(event_idt source);
+
+    /* budget of the collection, see event_grapht::set_budget_collection */
+    std::chrono::steady_clock::time_point deadline;
+    bool budget_met;
+    bool budget_exhausted(const std::set<critical_cyclet> &set_of_cycles);
+
   public:
     graph_explorert(
       event_grapht &_egraph,
@@ -297,7 +314,8 @@ class event_grapht
       egraph(_egraph),
       max_var(_max_var),
       max_po_trans(_max_po_trans),
-      cycle_nb(0)
+      cycle_nb(0),
+      budget_met(false)
     {
     }
 
@@ -383,6 +401,8 @@ class event_grapht
     max_var(0),
     max_po_trans(0),
     ignore_arrays(false),
+    max_cycles(0),
+    cycles_time_limit(0),
     filter_thin_air(true),
     filter_uniproc(true),
     message(_message)
@@ -393,6 +413,10 @@ class event_grapht
   bool filter_uniproc;
   messaget &message;
 
+  /* set if a collection of cycles stopped because its budget ran out, in
+     which case not all critical cycles were collected */
+  bool collection_incomplete = false;
+
   /* data dependencies per thread */
   std::map<unsigned, data_dpt> map_data_dp;
 
@@ -573,6 +597,16 @@ class event_grapht
     ignore_arrays = _ignore_arrays;
   }
 
+  /* limits the number of cycles and the time in seconds of each call of
+     collect_cycles, 0 for no limit */
+  void set_budget_collection(
+    std::size_t _max_cycles = 0,
+    std::size_t _cycles_time_limit = 0)
+  {
+    max_cycles = _max_cycles;
+    cycles_time_limit = _cycles_time_limit;
+  }
+
   /* collects all the pairs of events with respectively at least one cmp,
      regardless of the architecture (Pensieve'05 strategy) */
   void collect_pairs()
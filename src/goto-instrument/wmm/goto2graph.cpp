@@ -13,12 +13,15 @@ Date: 2012
 
 #include "goto2graph.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <fstream>
 
 #include <util/options.h>
 #include <util/prefix.h>
+#include <util/run_in_processes.h>
+#include <util/tempfile.h>
 
 #include <linking/static_lifetime_init.h>
 
@@ -1604,85 +1607,188 @@ void instrumentert::print_outputs(memory_modelt model, bool hide_internals)
   table.close();
 }
 
-/// Note: can be distributed (\#define DISTRIBUTED)
-#if 1
-// #ifdef _WIN32
-void instrumentert::collect_cycles_by_SCCs(memory_modelt model)
-{
-  unsigned scc=0;
-  set_of_cycles_per_SCC.resize(num_sccs,
-    std::set<event_grapht::critical_cyclet>());
-  for(std::vector<std::set<event_idt> >::const_iterator it=egraph_SCCs.begin();
-    it!=egraph_SCCs.end(); it++)
-    if(it->size()>=4)
-      egraph.collect_cycles(set_of_cycles_per_SCC[scc++], model, *it);
-}
-#else
-class pthread_argumentt
+#ifndef _WIN32
+/// collects the cycles of the SCCs at \p positions of \p sccs, and writes,
+/// for each of them, a line with its number of cycles and whether their
+/// collection was complete, followed by a line per cycle with its id, whether
+/// it has a user-defined fence, its size and its events
+/// \return true on failure
+static bool write_cycles_of_SCCs(
+  instrumentert &instrumenter,
+  memory_modelt model,
+  const std::vector<std::size_t> &sccs,
+  const std::vector<std::size_t> &positions,
+  const std::string &file_name)
 {
-public:
-  instrumentert &instr;
-  memory_modelt mem;
-  const std::set<event_idt> &filter;
-  std::set<event_grapht::critical_cyclet> &cycles;
-
-  pthread_argumentt(instrumentert &_instr,
-    memory_modelt _mem,
-    const std::set<event_idt> &_filter,
-    std::set<event_grapht::critical_cyclet> &_cycles)
-    :instr(_instr), mem(_mem), filter(_filter), cycles(_cycles)
+  std::ofstream out(file_name);
+
+  for(const std::size_t position : positions)
   {
-  }
-};
+    std::set<event_grapht::critical_cyclet> cycles;
+    instrumenter.egraph.collection_incomplete=false;
+    instrumenter.egraph.collect_cycles(
+      cycles, model, instrumenter.egraph_SCCs[sccs[position]]);
 
-/* wraper */
-void *collect_cycles_in_thread(void *arg)
-{
-  /* arguments */
-  pthread_argumentt *p_arg=reinterpret_cast<pthread_argumentt*>(arg);
-  instrumentert &this_instrumenter=p_arg->instr;
-  memory_modelt model=p_arg->mem;
-  const std::set<event_idt> &filter=p_arg->filter;
-  std::set<event_grapht::critical_cyclet> &cycles=p_arg->cycles;
+    out << cycles.size() << ' ' << instrumenter.egraph.collection_incomplete
+        << '\n';
 
-  this_instrumenter.egraph.collect_cycles(cycles, model, filter);
+    for(const auto &cycle : cycles)
+    {
+      out << cycle.id << ' ' << cycle.has_user_defined_fence << ' '
+          << cycle.size();
+      for(const event_idt event : cycle)
+        out << ' ' << event;
+      out << '\n';
+    }
+  }
 
-  return NULL;
+  return !out.good();
 }
 
-void instrumentert::collect_cycles_by_SCCs(memory_modelt model)
+/// reads the cycles written by write_cycles_of_SCCs into the sets of cycles
+/// at \p positions
+/// \return true on failure
+static bool read_cycles_of_SCCs(
+  instrumentert &instrumenter,
+  memory_modelt model,
+  const std::vector<std::size_t> &positions,
+  const std::string &file_name)
 {
-  const unsigned number_of_sccs=num_sccs;
-  std::set<unsigned> interesting_SCCs;
+  std::ifstream in(file_name);
 
-  unsigned scc=0;
-  pthread_t *threads=new pthread_t[num_sccs+1];
+  for(const std::size_t position : positions)
+  {
+    std::size_t number_of_cycles;
+    bool incomplete;
+    if(!(in >> number_of_cycles >> incomplete))
+      return true;
 
-  set_of_cycles_per_SCC.resize(num_sccs,
-    std::set<event_grapht::critical_cyclet>());
+    instrumenter.egraph.collection_incomplete|=incomplete;
 
-  for(std::vector<std::set<unsigned> >::const_iterator it=egraph_SCCs.begin();
-      it!=egraph_SCCs.end(); it++)
-    if(it->size()>=4)
+    for(std::size_t i=0; i<number_of_cycles; ++i)
     {
-      interesting_SCCs.insert(scc);
-      pthread_argumentt arg(*this, model, *it, set_of_cycles_per_SCC[scc]);
+      unsigned id;
+      bool has_user_defined_fence;
+      std::size_t size;
+      if(!(in >> id >> has_user_defined_fence >> size))
+        return true;
 
-      int rc=pthread_create(&threads[scc++], NULL,
-        collect_cycles_in_thread, &arg);
+      event_grapht::critical_cyclet cycle(instrumenter.egraph, id);
+      cycle.has_user_defined_fence=has_user_defined_fence;
 
-      message.status()<<(rc!=0?"Failure ":"Success ")
-        <<"in creating thread for SCC #"<<scc-1<<messaget::eom;
-    }
+      for(std::size_t j=0; j<size; ++j)
+      {
+        event_idt event;
+        if(!(in >> event) || event>=instrumenter.egraph.size())
+          return true;
+        cycle.push_back(event);
+      }
 
-  for(unsigned i=0; i<number_of_sccs; i++)
-    if(interesting_SCCs.find(i)!=interesting_SCCs.end())
-    {
-      int rc=pthread_join(threads[i], NULL);
-      message.status()<<(rc!=0?"Failure ":"Success ")
-        <<"in joining thread for SCC #"<<i<<messaget::eom;
+      /* the unsafe pairs are not stored */
+      cycle.compute_unsafe_pairs(model);
+
+      instrumenter.set_of_cycles_per_SCC[position].insert(cycle);
     }
+  }
+
+  return false;
+}
+
+/// collects the cycles of \p sccs in up to \p jobs processes, giving the
+/// largest remaining SCC to the process with the fewest events so far
+/// \return true on failure
+static bool collect_cycles_in_processes(
+  instrumentert &instrumenter,
+  memory_modelt model,
+  const std::vector<std::size_t> &sccs,
+  std::size_t jobs)
+{
+  messaget &message=instrumenter.message;
+
+  std::vector<std::size_t> by_size(sccs.size());
+  for(std::size_t position=0; position<sccs.size(); ++position)
+    by_size[position]=position;
+  std::stable_sort(
+    by_size.begin(),
+    by_size.end(),
+    [&](std::size_t a, std::size_t b) {
+      return instrumenter.egraph_SCCs[sccs[a]].size()>
+             instrumenter.egraph_SCCs[sccs[b]].size();
+    });
+
+  std::vector<std::vector<std::size_t>> positions(
+    std::min(jobs, sccs.size()));
+  std::vector<std::size_t> events(positions.size(), 0);
+  for(const std::size_t position : by_size)
+  {
+    const std::size_t job=
+      std::min_element(events.begin(), events.end())-events.begin();
+    positions[job].push_back(position);
+    events[job]+=instrumenter.egraph_SCCs[sccs[position]].size();
+  }
+
+  message.status() << "Collecting cycles of " << sccs.size() << " SCCs in "
+                   << positions.size() << " processes" << messaget::eom;
+
+  std::vector<temporary_filet> files;
+  for(std::size_t job=0; job<positions.size(); ++job)
+    files.emplace_back("goto_instrument_cycles_", ".txt");
+
+  const std::vector<bool> failed=run_in_processes(
+    files, [&](std::size_t job, const std::string &file_name) {
+      return write_cycles_of_SCCs(
+        instrumenter, model, sccs, positions[job], file_name);
+    });
+
+  bool error=std::find(failed.begin(), failed.end(), true)!=failed.end();
 
-  delete[] threads;
+  for(std::size_t job=0; !error && job<positions.size(); ++job)
+  {
+    error=
+      read_cycles_of_SCCs(instrumenter, model, positions[job], files[job]());
+  }
+
+  if(error)
+    message.warning() << "failed to collect cycles in separate processes"
+                      << messaget::eom;
+
+  return error;
 }
 #endif
+
+/// collects the cycles of each SCC that could host a critical cycle, in up to
+/// \p jobs processes
+void instrumentert::collect_cycles_by_SCCs(
+  memory_modelt model,
+  std::size_t jobs)
+{
+  std::vector<std::size_t> sccs;
+  for(std::size_t i=0; i<egraph_SCCs.size(); ++i)
+    if(egraph_SCCs[i].size()>=4)
+      sccs.push_back(i);
+
+  set_of_cycles_per_SCC.resize(num_sccs,
+    std::set<event_grapht::critical_cyclet>());
+
+#ifdef _WIN32
+  if(jobs>1)
+    message.warning() << "collecting cycles in separate processes is not "
+                      << "supported on Windows" << messaget::eom;
+#else
+  if(jobs>1 && sccs.size()>1)
+  {
+    if(!collect_cycles_in_processes(*this, model, sccs, jobs))
+      return;
+
+    for(auto &cycles : set_of_cycles_per_SCC)
+      cycles.clear();
+    egraph.collection_incomplete=false;
+  }
+#endif
+
+  for(std::size_t position=0; position<sccs.size(); ++position)
+  {
+    egraph.collect_cycles(
+      set_of_cycles_per_SCC[position], model, egraph_SCCs[sccs[position]]);
+  }
+}
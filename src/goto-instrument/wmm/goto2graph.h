@@ -380,8 +380,9 @@ class instrumentert
     num_sccs = 0;
   }
 
-  /* collects the cycles in the graph by SCCs */
-  void collect_cycles_by_SCCs(memory_modelt model);
+  /* collects the cycles in the graph by SCCs, in up to the given number of
+     processes */
+  void collect_cycles_by_SCCs(memory_modelt model, std::size_t jobs = 1);
 
   /* filters cycles spurious by CFG */
   void cfg_cycles_filter();
@@ -395,6 +396,14 @@ class instrumentert
     egraph.set_parameters_collection(_max_var, _max_po_trans, _ignore_arrays);
   }
 
+  /* sets the budget of each collection, if required */
+  void set_budget_collection(
+    std::size_t _max_cycles = 0,
+    std::size_t _cycles_time_limit = 0)
+  {
+    egraph.set_budget_collection(_max_cycles, _cycles_time_limit);
+  }
+
   /* builds the relations between unsafe pairs in the critical cycles and
      instructions to instrument in the code */
 
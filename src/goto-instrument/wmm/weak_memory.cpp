@@ -104,6 +104,19 @@ void introduce_temporaries(
   }
 }
 
+/// the budget of the collection of cycles may have stopped it early, in which
+/// case the instrumentation does not cover all critical cycles
+static void warn_if_collection_incomplete(const instrumentert &instrumenter)
+{
+  if(instrumenter.egraph.collection_incomplete)
+  {
+    instrumenter.message.warning()
+      << "collection of cycles stopped by --max-cycles or "
+      << "--cycles-time-limit: not all critical cycles are instrumented"
+      << messaget::eom;
+  }
+}
+
 void weak_memory(
   memory_modelt model,
   value_setst &value_sets,
@@ -121,7 +134,10 @@ void weak_memory(
   bool cav11_option,
   bool hide_internals,
   message_handlert &message_handler,
-  bool ignore_arrays)
+  bool ignore_arrays,
+  std::size_t max_cycles,
+  std::size_t cycles_time_limit,
+  std::size_t scc_jobs)
 {
   messaget message(message_handler);
 
@@ -167,22 +183,26 @@ void weak_memory(
   else
     instrumenter.set_parameters_collection(max_thds, 0, ignore_arrays);
 
+  instrumenter.set_budget_collection(max_cycles, cycles_time_limit);
+
   if(SCC)
   {
-    instrumenter.collect_cycles_by_SCCs(model);
+    instrumenter.collect_cycles_by_SCCs(model, scc_jobs);
     message.status()<<"cycles collected: "<<messaget::eom;
     unsigned interesting_scc = 0;
     unsigned total_cycles = 0;
     for(unsigned i=0; i<instrumenter.num_sccs; i++)
       if(instrumenter.egraph_SCCs[i].size()>=4)
       {
-        message.status()<<"SCC #"<<i<<": "
-          <<instrumenter.set_of_cycles_per_SCC[interesting_scc++].size()
+        const std::size_t cycles=
+          instrumenter.set_of_cycles_per_SCC[interesting_scc++].size();
+        message.status()<<"SCC #"<<i<<": "<<cycles
           <<" cycles found"<<messaget::eom;
-        total_cycles += instrumenter
-          .set_of_cycles_per_SCC[interesting_scc++].size();
+        total_cycles += cycles;
       }
 
+    warn_if_collection_incomplete(instrumenter);
+
     /* if no cycle, no need to instrument */
     if(total_cycles == 0)
     {
@@ -196,6 +216,8 @@ void weak_memory(
     message.status()<<"cycles collected: "<<instrumenter.set_of_cycles.size()
       <<" cycles found"<<messaget::eom;
 
+    warn_if_collection_incomplete(instrumenter);
+
     /* if no cycle, no need to instrument */
     if(instrumenter.set_of_cycles.empty())
     {
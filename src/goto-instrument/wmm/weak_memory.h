@@ -18,6 +18,8 @@ Date: September 2011
 
 #include <util/irep.h>
 
+#include <cstddef>
+
 class symbol_tablet;
 class value_setst;
 class goto_modelt;
@@ -42,7 +44,10 @@ void weak_memory(
   bool cav11_option,
   bool hide_internals,
   message_handlert &,
-  bool ignore_arrays);
+  bool ignore_arrays,
+  std::size_t max_cycles,
+  std::size_t cycles_time_limit,
+  std::size_t scc_jobs);
 
 void introduce_temporaries(
   value_setst &,
@@ -67,6 +72,8 @@ void introduce_temporaries(
 #define OPT_WMM_LIMITS                                                         \
   "(max-var):"                                                                 \
   "(max-po-trans):"                                                            \
+  "(max-cycles):"                                                              \
+  "(cycles-time-limit):"                                                       \
 
 #define OPT_WMM_LOOPS                                                          \
   "(force-loop-duplication)"                                                   \
@@ -74,6 +81,7 @@ void introduce_temporaries(
 
 #define OPT_WMM_MISC                                                           \
   "(scc)"                                                                      \
+  "(scc-jobs):"                                                                \
   "(cfg-kill)"                                                                 \
   "(no-dependencies)"                                                          \
   "(no-po-rendering)"                                                          \
@@ -93,7 +101,9 @@ void introduce_temporaries(
 
 #define HELP_WMM_FULL                                                          \
   " --mm <tso,pso,rmo,power>     instruments a weak memory model\n"            \
-  " --scc                        detects critical cycles per SCC (one thread per SCC)\n" /* NOLINT(whitespace/line_length) */ \
+  " --scc                        detects critical cycles per SCC\n"            \
+  " --scc-jobs N                 detects the critical cycles of the SCCs in\n" \
+  "                              N processes\n"                                \
   " --one-event-per-cycle        only instruments one event per cycle\n"       \
   " --minimum-interference       instruments an optimal number of events\n"    \
   " --my-events                  only instruments events whose ids appear in inst.evt\n" /* NOLINT(whitespace/line_length) */ \
@@ -101,6 +111,10 @@ void introduce_temporaries(
   "                              write occurs as first event, respectively\n"  \
   " --max-var N                  limit cycles to N variables read/written\n"   \
   " --max-po-trans N             limit cycles to N program-order edges\n"      \
+  " --max-cycles N               stop collecting cycles after N cycles (per\n" \
+  "                              SCC with --scc)\n"                            \
+  " --cycles-time-limit T        stop collecting cycles after T seconds\n"     \
+  "                              (per SCC with --scc)\n"                       \
   " --ignore-arrays              instrument arrays as a single object\n"       \
   " --cav11                      always instrument shared variables, even\n"   \
   "                              when they are not part of any cycle\n"        \
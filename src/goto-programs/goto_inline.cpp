@@ -16,6 +16,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_inline_class.h"
 #include "goto_model.h"
 
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+#include <vector>
+
 /// Inline every function call into the entry_point() function.
 /// Then delete the bodies of all of the other functions.
 /// This is pretty drastic and can result in a very large program.
@@ -229,6 +234,270 @@ void goto_partial_inline(
   goto_inline.goto_inline(inline_map, false);
 }
 
+namespace
+{
+/// Chooses the calls to inline for \ref goto_cost_inline. Functions are
+/// visited callees first, such that the size of a callee after inlining its
+/// own calls is known when deciding on the calls to it.
+class cost_inline_decisionst
+{
+public:
+  cost_inline_decisionst(
+    goto_functionst &goto_functions,
+    const namespacet &ns,
+    const goto_inline_cost_modelt &cost_model,
+    messaget &log)
+    : goto_functions(goto_functions),
+      ns(ns),
+      cost_model(cost_model),
+      log(log)
+  {
+  }
+
+  /// Gather the calls of all functions and choose the ones to inline
+  goto_inlinet::inline_mapt operator()();
+
+  std::size_t program_size = 0;
+  std::size_t calls = 0;
+  std::size_t inlined_calls = 0;
+
+protected:
+  goto_functionst &goto_functions;
+  const namespacet &ns;
+  const goto_inline_cost_modelt &cost_model;
+  messaget &log;
+
+  /// A call to a function with a body
+  struct callt
+  {
+    goto_programt::targett target;
+    irep_idt callee;
+    std::size_t constant_arguments;
+  };
+
+  std::map<irep_idt, std::vector<callt>> calls_map;
+
+  /// Number of calls to each function
+  std::map<irep_idt, std::size_t> call_sites;
+
+  /// Estimated size of each visited function after inlining
+  std::map<irep_idt, std::size_t> inlined_sizes;
+
+  /// Functions being visited, calls to which are recursive
+  std::unordered_set<irep_idt> visiting;
+
+  std::size_t growth = 0;
+  std::size_t growth_budget = 0;
+
+  void gather_calls();
+
+  void visit(const irep_idt &function, goto_inlinet::inline_mapt &inline_map);
+
+  bool decide(const callt &call, std::size_t callee_size);
+};
+} // namespace
+
+void cost_inline_decisionst::gather_calls()
+{
+  for(auto &gf_entry : goto_functions.function_map)
+  {
+    goto_programt &goto_program = gf_entry.second.body;
+
+    if(!gf_entry.second.body_available())
+      continue;
+
+    program_size += goto_program.instructions.size();
+
+    std::vector<callt> &function_calls = calls_map[gf_entry.first];
+
+    Forall_goto_program_instructions(i_it, goto_program)
+    {
+      if(!i_it->is_function_call())
+        continue;
+
+      const exprt &function_expr = i_it->call_function();
+
+      if(function_expr.id() != ID_symbol)
+        // Can't handle pointers to functions
+        continue;
+
+      const irep_idt id = to_symbol_expr(function_expr).get_identifier();
+
+      const auto called_it = goto_functions.function_map.find(id);
+
+      if(
+        called_it == goto_functions.function_map.end() ||
+        !called_it->second.body_available())
+      {
+        continue;
+      }
+
+      std::size_t constant_arguments = 0;
+      for(const auto &argument : i_it->call_arguments())
+      {
+        if(argument.is_constant() || argument.id() == ID_address_of)
+          ++constant_arguments;
+      }
+
+      function_calls.push_back(callt{i_it, id, constant_arguments});
+      ++call_sites[id];
+    }
+
+    calls += function_calls.size();
+  }
+}
+
+goto_inlinet::inline_mapt cost_inline_decisionst::operator()()
+{
+  gather_calls();
+
+  growth_budget = program_size * cost_model.growth_limit / 100;
+
+  goto_inlinet::inline_mapt inline_map;
+
+  for(const auto &entry : calls_map)
+    visit(entry.first, inline_map);
+
+  return inline_map;
+}
+
+void cost_inline_decisionst::visit(
+  const irep_idt &function,
+  goto_inlinet::inline_mapt &inline_map)
+{
+  if(inlined_sizes.count(function) != 0 || !visiting.insert(function).second)
+    return;
+
+  const std::vector<callt> &function_calls = calls_map.at(function);
+
+  for(const auto &call : function_calls)
+    visit(call.callee, inline_map);
+
+  visiting.erase(function);
+
+  std::size_t size =
+    goto_functions.function_map.at(function).body.instructions.size();
+
+  // Don't inline any function calls made from the _start function, see
+  // goto_partial_inline
+  if(function != goto_functionst::entry_point())
+  {
+    goto_inlinet::call_listt &call_list = inline_map[function];
+
+    for(const auto &call : function_calls)
+    {
+      const auto size_it = inlined_sizes.find(call.callee);
+
+      if(size_it == inlined_sizes.end())
+        // recursive call
+        continue;
+
+      if(!decide(call, size_it->second))
+        continue;
+
+      log.debug() << "Inlining '" << call.callee << "' into '" << function
+                  << "': " << size_it->second << " instructions, "
+                  << call_sites.at(call.callee) << " call sites, "
+                  << call.constant_arguments << " constant arguments"
+                  << messaget::eom;
+
+      call_list.push_back(goto_inlinet::callt(call.target, false));
+      size += size_it->second;
+      ++inlined_calls;
+    }
+  }
+
+  inlined_sizes[function] = size;
+}
+
+bool cost_inline_decisionst::decide(const callt &call, std::size_t callee_size)
+{
+  if(to_code_type(ns.lookup(call.callee).type).get_inlined())
+  {
+    growth += callee_size;
+    return true;
+  }
+
+  std::size_t limit =
+    cost_model.small_function_limit +
+    cost_model.constant_argument_bonus * call.constant_arguments;
+
+  if(call_sites.at(call.callee) == 1)
+    limit = std::max(limit, cost_model.single_call_limit);
+
+  if(callee_size > limit || growth + callee_size > growth_budget)
+    return false;
+
+  growth += callee_size;
+  return true;
+}
+
+/// Inline the calls that a cost model considers worthwhile: calls to small
+/// functions, to functions with a single call site, and calls with constant
+/// arguments, up to a limit on the growth of the program, as well as all calls
+/// to functions marked as "inlined". Functions are processed callees first,
+/// such that each function is inlined into its callers with the calls chosen
+/// in it already inlined. Recursive calls are not inlined.
+/// Unlike the goto_inline functions, this doesn't remove function
+/// bodies after inlining.
+/// Caller is responsible for calling update(), compute_loop_numbers(), etc.
+/// \param goto_model: Source of the symbol table and function map to use.
+/// \param message_handler: Message handler used by goto_inlinet.
+/// \param cost_model: Parameters for choosing the calls to inline.
+/// \param adjust_function: Replace location in inlined function with call site.
+void goto_cost_inline(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  const goto_inline_cost_modelt &cost_model,
+  bool adjust_function)
+{
+  const namespacet ns(goto_model.symbol_table);
+  goto_cost_inline(
+    goto_model.goto_functions,
+    ns,
+    message_handler,
+    cost_model,
+    adjust_function);
+}
+
+/// Inline the calls that a cost model considers worthwhile, see above.
+/// Caller is responsible for calling update(), compute_loop_numbers(), etc.
+/// \param goto_functions: The function map to use to find functions containing
+///   calls and function bodies.
+/// \param ns: Namespace used by goto_inlinet.
+/// \param message_handler: Message handler used by goto_inlinet.
+/// \param cost_model: Parameters for choosing the calls to inline.
+/// \param adjust_function: Replace location in inlined function with call site.
+void goto_cost_inline(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  message_handlert &message_handler,
+  const goto_inline_cost_modelt &cost_model,
+  bool adjust_function)
+{
+  messaget log(message_handler);
+
+  cost_inline_decisionst decisions(goto_functions, ns, cost_model, log);
+  const goto_inlinet::inline_mapt inline_map = decisions();
+
+  goto_inlinet goto_inline(
+    goto_functions,
+    ns,
+    message_handler,
+    adjust_function);
+
+  goto_inline.goto_inline(inline_map, false);
+
+  std::size_t program_size = 0;
+  for(const auto &gf_entry : goto_functions.function_map)
+    program_size += gf_entry.second.body.instructions.size();
+
+  log.statistics() << "Inlined " << decisions.inlined_calls << " of "
+                   << decisions.calls << " calls, program size "
+                   << decisions.program_size << " -> " << program_size
+                   << " instructions" << messaget::eom;
+}
+
 /// Transitively inline all function calls made from a particular function.
 /// Caller is responsible for calling update(), compute_loop_numbers(), etc.
 /// \param goto_model: Source of the symbol table and function map to use.
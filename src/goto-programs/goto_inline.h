@@ -16,6 +16,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/json.h>
 
+#include <cstddef>
+
 class goto_functionst;
 class goto_modelt;
 class message_handlert;
@@ -50,6 +52,40 @@ void goto_partial_inline(
   unsigned smallfunc_limit=0,
   bool adjust_function=false);
 
+/// Parameters of the cost model used by \ref goto_cost_inline. Sizes are
+/// numbers of instructions of a callee after inlining its own calls.
+struct goto_inline_cost_modelt
+{
+  /// Calls to functions of at most this size are inlined
+  std::size_t small_function_limit = 10;
+
+  /// Functions with a single call site are inlined up to this size
+  std::size_t single_call_limit = 1000;
+
+  /// Size by which the limit is raised for each argument of a call that is
+  /// a constant or an address, as these enable constant propagation and
+  /// resolving dereferences in the inlined body
+  std::size_t constant_argument_bonus = 10;
+
+  /// Maximum growth of the whole program, in percent of its size
+  std::size_t growth_limit = 50;
+};
+
+// inline the calls chosen by a cost model, callees before callers
+
+void goto_cost_inline(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  const goto_inline_cost_modelt &cost_model,
+  bool adjust_function = false);
+
+void goto_cost_inline(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  message_handlert &message_handler,
+  const goto_inline_cost_modelt &cost_model,
+  bool adjust_function = false);
+
 // transitively inline all calls the given function makes
 
 void goto_function_inline(
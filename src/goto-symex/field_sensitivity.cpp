@@ -14,11 +14,26 @@ Author: Michael Tautschnig
 #include <util/pointer_offset_size.h>
 #include <util/simplify_expr.h>
 
+#include <goto-programs/goto_program.h>
+
 #include "goto_symex_state.h"
 #include "symex_target.h"
 
 #define ENABLE_ARRAY_FIELD_SENSITIVITY
 
+/// Determine whether \p expr is the expansion of an array for which sparse
+/// field sensitivity applies, i.e., `array WITH [i1:=array[[i1]]] …` as built
+/// by \ref field_sensitivityt::get_fields.
+static bool is_sparse_array_overlay(const exprt &expr)
+{
+  const exprt *array = &expr;
+  while(array->id() == ID_with && array->operands().size() == 3)
+    array = &to_with_expr(*array).old();
+
+  return array != &expr && is_ssa_expr(*array) &&
+         array->get_bool(ID_C_sparse_array_rest);
+}
+
 exprt field_sensitivityt::apply(
   const namespacet &ns,
   goto_symex_statet &state,
@@ -56,7 +71,8 @@ exprt field_sensitivityt::apply(
 #ifdef ENABLE_ARRAY_FIELD_SENSITIVITY
   else if(
     !write && expr.id() == ID_index &&
-    to_index_expr(expr).array().id() == ID_array)
+    (to_index_expr(expr).array().id() == ID_array ||
+     is_sparse_array_overlay(to_index_expr(expr).array())))
   {
     return simplify_opt(std::move(expr), ns);
   }
@@ -156,32 +172,42 @@ exprt field_sensitivityt::apply(
           l2_size = to_array_type(array_from_symbol_table->type).size();
       }
 
-      if(
+      const bool is_small_array =
         l2_size.is_constant() &&
         numeric_cast_v<mp_integer>(to_constant_expr(l2_size)) <=
-          max_field_sensitivity_array_size)
+          max_field_sensitivity_array_size;
+
+      const std::set<mp_integer> *sparse_indices =
+        is_small_array || !l2_index.get().is_constant()
+          ? nullptr
+          : get_sparse_indices(to_ssa_expr(index.array()));
+
+      if(
+        l2_index.get().is_constant() &&
+        (is_small_array ||
+         (sparse_indices != nullptr &&
+          sparse_indices->count(numeric_cast_v<mp_integer>(
+            to_constant_expr(l2_index.get()))) != 0)))
       {
-        if(l2_index.get().is_constant())
-        {
-          // place the entire index expression, not just the array operand,
-          // in an SSA expression
-          ssa_exprt ssa_array = to_ssa_expr(index.array());
-          ssa_array.remove_level_2();
-          index.array() = ssa_array.get_original_expr();
-          index.index() = l2_index.get();
-          tmp.set_expression(index);
-          if(was_l2)
-            return state.rename(std::move(tmp), ns).get();
-          else
-            return std::move(tmp);
-        }
-        else if(!write)
-        {
-          // Expand the array and return `{array[0]; array[1]; ...}[index]`
-          exprt expanded_array =
-            get_fields(ns, state, to_ssa_expr(index.array()), true);
-          return index_exprt{std::move(expanded_array), index.index()};
-        }
+        // place the entire index expression, not just the array operand,
+        // in an SSA expression
+        ssa_exprt ssa_array = to_ssa_expr(index.array());
+        ssa_array.remove_level_2();
+        index.array() = ssa_array.get_original_expr();
+        index.index() = l2_index.get();
+        static_cast<exprt &>(tmp).remove(ID_C_sparse_array_rest);
+        tmp.set_expression(index);
+        if(was_l2)
+          return state.rename(std::move(tmp), ns).get();
+        else
+          return std::move(tmp);
+      }
+      else if(is_small_array && !write)
+      {
+        // Expand the array and return `{array[0]; array[1]; ...}[index]`
+        exprt expanded_array =
+          get_fields(ns, state, to_ssa_expr(index.array()), true);
+        return index_exprt{std::move(expanded_array), index.index()};
       }
     }
   }
@@ -242,8 +268,18 @@ exprt field_sensitivityt::get_fields(
   {
     const mp_integer mp_array_size = numeric_cast_v<mp_integer>(
       to_constant_expr(to_array_type(ssa_expr.type()).size()));
-    if(mp_array_size < 0 || mp_array_size > max_field_sensitivity_array_size)
+    if(mp_array_size < 0)
       return ssa_expr;
+    else if(mp_array_size > max_field_sensitivity_array_size)
+    {
+      if(const auto sparse_indices = get_sparse_indices(ssa_expr))
+      {
+        return get_sparse_fields(
+          ns, state, ssa_expr, *sparse_indices, disjoined_fields_only);
+      }
+      else
+        return ssa_expr;
+    }
 
     const array_typet &type = to_array_type(ssa_expr.type());
     const std::size_t array_size = numeric_cast_v<std::size_t>(mp_array_size);
@@ -420,10 +456,44 @@ void field_sensitivityt::field_assignments_rec(
   {
     const std::size_t array_size =
       numeric_cast_v<std::size_t>(to_constant_expr(type->size()));
-    PRECONDITION(lhs_fs.operands().size() == array_size);
 
     if(array_size > max_field_sensitivity_array_size)
+    {
+      // sparse field sensitivity: only the tracked cells are individual
+      // symbols, each of which records its index
+      for(const exprt &index_lhs : lhs_fs.operands())
+      {
+        const ssa_exprt &index_ssa =
+          is_ssa_expr(index_lhs)
+            ? to_ssa_expr(index_lhs)
+            : to_field_sensitive_ssa_expr(index_lhs).get_object_ssa();
+        const exprt &index =
+          to_index_expr(index_ssa.get_original_expr()).index();
+
+        const exprt index_rhs = apply(
+          ns, state, simplify_opt(index_exprt{ssa_rhs, index}, ns), false);
+
+        if(
+          auto fs_ssa =
+            expr_try_dynamic_cast<field_sensitive_ssa_exprt>(index_lhs))
+        {
+          field_assignments_rec(
+            ns,
+            state,
+            fs_ssa->get_object_ssa(),
+            index_rhs,
+            target,
+            allow_pointer_unsoundness);
+        }
+
+        field_assignments_rec(
+          ns, state, index_lhs, index_rhs, target, allow_pointer_unsoundness);
+      }
+
       return;
+    }
+
+    PRECONDITION(lhs_fs.operands().size() == array_size);
 
     exprt::operandst::const_iterator fs_it = lhs_fs.operands().begin();
     for(std::size_t i = 0; i < array_size; ++i)
@@ -502,6 +572,9 @@ bool field_sensitivityt::is_divisible(
   {
     return true;
   }
+
+  if(!disjoined_fields_only && get_sparse_indices(expr) != nullptr)
+    return true;
 #endif
 
   if(
@@ -521,3 +594,131 @@ exprt field_sensitivityt::simplify_opt(exprt e, const namespacet &ns) const
 
   return simplify_expr(std::move(e), ns);
 }
+
+const std::set<mp_integer> *
+field_sensitivityt::get_sparse_indices(const ssa_exprt &array) const
+{
+  if(!sparse_array_indices || array.type().id() != ID_array)
+    return nullptr;
+
+  const exprt &size = to_array_type(array.type()).size();
+  if(
+    !size.is_constant() || numeric_cast_v<mp_integer>(to_constant_expr(
+                             size)) <= max_field_sensitivity_array_size)
+  {
+    return nullptr;
+  }
+
+  const auto entry = sparse_array_indices->find(array.get_original_name());
+  if(entry == sparse_array_indices->end() || entry->second.empty())
+    return nullptr;
+
+  return &entry->second;
+}
+
+exprt field_sensitivityt::get_sparse_fields(
+  const namespacet &ns,
+  goto_symex_statet &state,
+  const ssa_exprt &ssa_expr,
+  const std::set<mp_integer> &indices,
+  bool disjoined_fields_only) const
+{
+  // the rest array of an expansion that has already been built
+  if(disjoined_fields_only && ssa_expr.get_bool(ID_C_sparse_array_rest))
+    return ssa_expr;
+
+  const array_typet &type = to_array_type(ssa_expr.type());
+  const mp_integer array_size =
+    numeric_cast_v<mp_integer>(to_constant_expr(type.size()));
+  const exprt &array = ssa_expr.get_original_expr();
+
+  // Mark the rest array so that it is not expanded again when this expression
+  // is subject to field sensitivity once more.
+  ssa_exprt rest = ssa_expr;
+  rest.set(ID_C_sparse_array_rest, true);
+  exprt result = std::move(rest);
+
+  exprt::operandst elements;
+  elements.reserve(indices.size());
+
+  for(const mp_integer &i : indices)
+  {
+    if(i < 0 || i >= array_size)
+      continue;
+
+    const exprt index_value = from_integer(i, type.index_type());
+    ssa_exprt tmp = ssa_expr;
+    static_cast<exprt &>(tmp).remove(ID_C_sparse_array_rest);
+    bool was_l2 = !tmp.get_level_2().empty();
+    tmp.remove_level_2();
+    tmp.set_expression(index_exprt{array, index_value});
+    exprt element = get_fields(ns, state, tmp, disjoined_fields_only);
+    if(was_l2)
+      element = state.rename(std::move(element), ns).get();
+
+    if(disjoined_fields_only)
+      result = with_exprt{std::move(result), index_value, std::move(element)};
+    else
+      elements.push_back(std::move(element));
+  }
+
+  if(disjoined_fields_only)
+    return result;
+  else
+    return field_sensitive_ssa_exprt{ssa_expr, std::move(elements)};
+}
+
+/// Determine whether \p expr denotes an object that can be given an SSA
+/// identifier, i.e., a symbol possibly nested in member expressions and index
+/// expressions with constant indices.
+static bool has_constant_access_path(const exprt &expr)
+{
+  if(expr.id() == ID_symbol)
+    return true;
+  else if(expr.id() == ID_member)
+    return has_constant_access_path(to_member_expr(expr).compound());
+  else if(expr.id() == ID_index)
+  {
+    return to_index_expr(expr).index().is_constant() &&
+           has_constant_access_path(to_index_expr(expr).array());
+  }
+  else
+    return false;
+}
+
+void field_sensitivityt::collect_sparse_array_indices(
+  const goto_programt &program,
+  std::size_t max_array_size,
+  sparse_array_indicest &indices)
+{
+  for(const auto &instruction : program.instructions)
+  {
+    instruction.apply([max_array_size, &indices](const exprt &expr) {
+      expr.visit_pre([max_array_size, &indices](const exprt &e) {
+        const auto index_expr = expr_try_dynamic_cast<index_exprt>(e);
+        if(
+          !index_expr || !index_expr->index().is_constant() ||
+          index_expr->array().type().id() != ID_array ||
+          !has_constant_access_path(index_expr->array()))
+        {
+          return;
+        }
+
+        const exprt &size = to_array_type(index_expr->array().type()).size();
+        const auto array_size = numeric_cast<mp_integer>(size);
+        const auto index = numeric_cast<mp_integer>(index_expr->index());
+        if(
+          !array_size.has_value() || *array_size <= max_array_size ||
+          !index.has_value() || *index < 0 || *index >= *array_size)
+        {
+          return;
+        }
+
+        auto &array_indices =
+          indices[ssa_exprt{index_expr->array()}.get_identifier()];
+        if(array_indices.size() < max_array_size)
+          array_indices.insert(*index);
+      });
+    });
+  }
+}
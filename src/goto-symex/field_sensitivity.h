@@ -9,9 +9,15 @@ Author: Michael Tautschnig
 #ifndef CPROVER_GOTO_SYMEX_FIELD_SENSITIVITY_H
 #define CPROVER_GOTO_SYMEX_FIELD_SENSITIVITY_H
 
+#include <util/mp_arith.h>
 #include <util/nodiscard.h>
 #include <util/ssa_expr.h>
 
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+class goto_programt;
 class namespacet;
 class goto_symex_statet;
 class symex_targett;
@@ -102,6 +108,20 @@ inline field_sensitive_ssa_exprt &to_field_sensitive_ssa_expr(exprt &expr)
 /// and arrays whose size exceed the bound \c max_field_sensitivity_array_size.
 /// See \ref field_sensitivityt::apply.
 ///
+/// ### Sparse array access
+/// Arrays that exceed \c max_field_sensitivity_array_size can still be handled
+/// field-sensitively for a fixed set of constant indices, see
+/// \ref field_sensitivityt::set_sparse_array_indices. For such an array
+/// `array` with tracked indices `i1`, `i2`, …, `array[[i1]]`, `array[[i2]]`
+/// etc. become individual symbols, just like for small arrays, while the
+/// symbol `array` itself is kept as a "rest" array that holds the values of
+/// all other cells. In an rvalue, the symbol `array` is replaced by
+/// `array WITH [i1:=array[[i1]]] WITH [i2:=array[[i2]]]…`, which the
+/// simplifier turns into `array[[i1]]` for `array[i1]` and into
+/// `index == i1 ? array[[i1]] : … : array[index]` for a non-constant `index`.
+/// Writes to a tracked index thus never touch the rest array, and only
+/// accesses at non-constant or untracked indices need the array theory.
+///
 /// ### Symbols representing arrays
 /// In an rvalue, a symbol `array` which has array type will be replaced by
 /// `{array[[0]]; array[[1]]; …}[index]`.
@@ -201,9 +221,44 @@ class field_sensitivityt
   NODISCARD
   bool is_divisible(const ssa_exprt &expr, bool disjoined_fields_only) const;
 
+  /// Constant indices to be tracked as individual symbols, keyed by the
+  /// level-free SSA identifier of the array (see
+  /// \ref ssa_exprt::get_original_name).
+  using sparse_array_indicest =
+    std::unordered_map<irep_idt, std::set<mp_integer>>;
+
+  /// Enable sparse field sensitivity for arrays of constant size exceeding
+  /// \c max_field_sensitivity_array_size: the cells at \p indices become
+  /// individual symbols, all other cells remain in the array symbol. The set
+  /// of indices must not change once symbolic execution has started, as
+  /// symbols for untracked cells are never assigned.
+  /// \param indices: indices to track per array, or nullptr to disable sparse
+  ///   field sensitivity
+  void set_sparse_array_indices(
+    std::shared_ptr<const sparse_array_indicest> indices)
+  {
+    sparse_array_indices = std::move(indices);
+  }
+
+  /// Collect the constant indices used to access arrays of constant size
+  /// exceeding \p max_array_size in \p program, at most \p max_array_size
+  /// indices per array.
+  /// \param program: goto program to scan
+  /// \param max_array_size: size bound beyond which arrays are considered for
+  ///   sparse field sensitivity
+  /// \param [in,out] indices: indices collected so far
+  static void collect_sparse_array_indices(
+    const goto_programt &program,
+    std::size_t max_array_size,
+    sparse_array_indicest &indices);
+
 private:
   const std::size_t max_field_sensitivity_array_size;
 
+  /// Indices tracked for arrays exceeding the size bound, shared between all
+  /// copies of the state; nullptr if sparse field sensitivity is disabled
+  std::shared_ptr<const sparse_array_indicest> sparse_array_indices;
+
   const bool should_simplify;
 
   void field_assignments_rec(
@@ -216,6 +271,19 @@ class field_sensitivityt
 
   NODISCARD
   exprt simplify_opt(exprt e, const namespacet &ns) const;
+
+  /// Return the indices tracked for \p array if \p array is an array of
+  /// constant size exceeding \c max_field_sensitivity_array_size for which
+  /// sparse field sensitivity applies, nullptr otherwise.
+  const std::set<mp_integer> *get_sparse_indices(const ssa_exprt &array) const;
+
+  NODISCARD
+  exprt get_sparse_fields(
+    const namespacet &ns,
+    goto_symex_statet &state,
+    const ssa_exprt &ssa_expr,
+    const std::set<mp_integer> &indices,
+    bool disjoined_fields_only) const;
 };
 
 #endif // CPROVER_GOTO_SYMEX_FIELD_SENSITIVITY_H
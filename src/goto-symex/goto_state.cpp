@@ -115,7 +115,8 @@ void goto_statet::apply_condition(
         else if(propagation_entry->get() != rhs)
           propagation.replace(l1_identifier, rhs);
 
-        value_set.assign(l1_lhs, rhs, ns, true, false);
+        if(previous_state.tracks_value_set(l1_lhs, ns))
+          value_set.assign(l1_lhs, rhs, ns, true, false);
       }
     }
   }
@@ -40,6 +40,8 @@ void goto_symext::symex_assign(
   const exprt &o_lhs,
   const exprt &o_rhs)
 {
+  profiler.count_assignment();
+
   exprt lhs = clean_expr(o_lhs, state, true);
   exprt rhs = clean_expr(o_rhs, state, false);
 
@@ -14,8 +14,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/message.h>
 
+#include <pointer-analysis/value_set_oracle.h>
+
 #include "complexity_limiter.h"
 #include "symex_config.h"
+#include "symex_profiler.h"
 #include "symex_target_equation.h"
 
 class address_of_exprt;
@@ -65,7 +68,8 @@ class goto_symext
       path_segment_vccs(0),
       _total_vccs(std::numeric_limits<unsigned>::max()),
       _remaining_vccs(std::numeric_limits<unsigned>::max()),
-      complexity_module(mh, options)
+      complexity_module(mh, options),
+      profiler(options)
   {
   }
 
@@ -810,6 +814,14 @@ class goto_symext
 
   complexity_limitert complexity_module;
 
+  /// Attributes the cost of symbolic execution to functions and loops when
+  /// the `symex-profile` option is set
+  symex_profilert profiler;
+
+  /// Answers points-to queries for pointers that the value set of the state
+  /// does not track when the `symex-points-to-oracle` option is set
+  std::unique_ptr<value_set_oraclet> points_to_oracle;
+
 public:
   unsigned get_total_vccs() const
   {
@@ -829,6 +841,13 @@ class goto_symext
     return _remaining_vccs;
   }
 
+  /// Write the report of \ref symex_profilert to \p path
+  /// \return true if the report could not be written
+  bool output_profile(const std::string &path) const
+  {
+    return profiler.generate_report(path);
+  }
+
   void validate(const validation_modet vm) const
   {
     target.validate(ns, vm);
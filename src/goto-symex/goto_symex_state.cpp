@@ -133,7 +133,8 @@ renamedt<ssa_exprt, L2> goto_symex_statet::assignment(
       DATA_INVARIANT(!check_renaming_l1(l1_rhs), "rhs renaming failed on l1");
     }
 
-    value_set.assign(l1_lhs, l1_rhs, ns, rhs_is_simplified, is_shared);
+    if(tracks_value_set(l1_lhs, ns))
+      value_set.assign(l1_lhs, l1_rhs, ns, rhs_is_simplified, is_shared);
   }
 
 #ifdef DEBUG
@@ -813,6 +814,21 @@ ssa_exprt goto_symex_statet::add_object(
   return ssa;
 }
 
+bool goto_symex_statet::tracks_value_set(
+  const ssa_exprt &l1_lhs,
+  const namespacet &ns) const
+{
+  if(!track_only_local_pointers)
+    return true;
+
+  // Objects with static lifetime and dynamically allocated objects are not
+  // local to any function
+  const symbolt *symbol;
+  if(ns.lookup(l1_lhs.get_object_name(), symbol))
+    return true;
+  return !symbol->is_static_lifetime && !symbol->type.get_bool(ID_C_dynamic);
+}
+
 ssa_exprt goto_symex_statet::declare(ssa_exprt ssa, const namespacet &ns)
 {
   const irep_idt &l1_identifier = ssa.get_identifier();
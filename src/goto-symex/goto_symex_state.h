@@ -212,6 +212,14 @@ class goto_symex_statet final : public goto_statet
 
   const incremental_dirtyt *dirty = nullptr;
 
+  /// When set, \ref value_set only tracks local variables and points-to
+  /// queries for other pointers are answered by a
+  /// \ref goto_symext::points_to_oracle
+  bool track_only_local_pointers = false;
+
+  /// Whether \ref value_set records the values assigned to \p l1_lhs
+  bool tracks_value_set(const ssa_exprt &l1_lhs, const namespacet &ns) const;
+
   goto_programt::const_targett saved_target;
 
   /// \brief This state is saved, with the PC pointing to the target of a GOTO
@@ -9,6 +9,7 @@ Author: Romain Brenguier <romain.brenguier@diffblue.com>
 #ifndef CPROVER_GOTO_SYMEX_SSA_STEP_H
 #define CPROVER_GOTO_SYMEX_SSA_STEP_H
 
+#include <util/optional.h>
 #include <util/ssa_expr.h>
 
 #include <goto-programs/goto_trace.h>
@@ -176,6 +177,11 @@ class SSA_stept
   // for incremental conversion
   bool converted = false;
 
+  /// Position of the expressions of this step in the file they were spilled
+  /// to, see \ref ssa_step_spillt. While this is set, the expressions are
+  /// only in memory while the step is being converted.
+  optionalt<std::size_t> spill_position;
+
   SSA_stept(
     const symex_targett::sourcet &_source,
     goto_trace_stept::typet _type)
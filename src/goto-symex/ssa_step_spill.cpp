@@ -0,0 +1,124 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storage of the expressions of SSA steps in a temporary file
+
+#include "ssa_step_spill.h"
+
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+
+#include "ssa_step.h"
+
+ssa_step_spillt::ssa_step_spillt()
+  : file("symex_ssa_steps_", ".bin"),
+    stream(
+      file(),
+      std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary)
+{
+  if(!stream)
+    throw system_exceptiont("failed to open " + file() + " for spilling");
+}
+
+void ssa_step_spillt::spill(SSA_stept &step)
+{
+  PRECONDITION(!step.spill_position.has_value());
+
+  stream.seekp(0, std::ios::end);
+  step.spill_position = static_cast<std::size_t>(stream.tellp());
+
+  // Serialise each step on its own: sharing with other steps would require
+  // reading back all of them.
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization{ireps_container};
+
+  serialization.reference_convert(step.guard, stream);
+  serialization.reference_convert(step.ssa_lhs, stream);
+  serialization.reference_convert(step.ssa_full_lhs, stream);
+  serialization.reference_convert(step.original_full_lhs, stream);
+  serialization.reference_convert(step.ssa_rhs, stream);
+  serialization.reference_convert(step.cond_expr, stream);
+
+  write_gb_word(stream, step.io_args.size());
+  for(const auto &arg : step.io_args)
+    serialization.reference_convert(arg, stream);
+
+  write_gb_word(stream, step.ssa_function_arguments.size());
+  for(const auto &arg : step.ssa_function_arguments)
+    serialization.reference_convert(arg, stream);
+
+  if(!stream)
+    throw system_exceptiont("failed to write to " + file());
+
+  drop(step);
+}
+
+void ssa_step_spillt::load(SSA_stept &step)
+{
+  PRECONDITION(step.spill_position.has_value());
+  PRECONDITION(loaded_step == nullptr);
+
+  stream.seekg(static_cast<std::streamoff>(*step.spill_position));
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization{ireps_container};
+
+  const auto read_expr = [&]() -> exprt {
+    return static_cast<const exprt &>(serialization.reference_convert(stream));
+  };
+
+  step.guard = read_expr();
+  step.ssa_lhs = static_cast<const ssa_exprt &>(
+    serialization.reference_convert(stream));
+  step.ssa_full_lhs = read_expr();
+  step.original_full_lhs = read_expr();
+  step.ssa_rhs = read_expr();
+  step.cond_expr = read_expr();
+
+  for(std::size_t n = irep_serializationt::read_gb_word(stream); n != 0; --n)
+    step.io_args.push_back(read_expr());
+
+  const std::size_t number_of_arguments =
+    irep_serializationt::read_gb_word(stream);
+  step.ssa_function_arguments.reserve(number_of_arguments);
+  for(std::size_t n = number_of_arguments; n != 0; --n)
+    step.ssa_function_arguments.push_back(read_expr());
+
+  if(!stream)
+    throw system_exceptiont("failed to read from " + file());
+
+  loaded_step = &step;
+}
+
+void ssa_step_spillt::unload(SSA_stept &step)
+{
+  PRECONDITION(loaded_step == &step);
+  drop(step);
+  loaded_step = nullptr;
+}
+
+void ssa_step_spillt::restore(SSA_stept &step)
+{
+  load(step);
+  loaded_step = nullptr;
+  step.spill_position.reset();
+}
+
+void ssa_step_spillt::drop(SSA_stept &step)
+{
+  step.guard = static_cast<const exprt &>(get_nil_irep());
+  step.ssa_lhs = static_cast<const ssa_exprt &>(get_nil_irep());
+  step.ssa_full_lhs = static_cast<const exprt &>(get_nil_irep());
+  step.original_full_lhs = static_cast<const exprt &>(get_nil_irep());
+  step.ssa_rhs = static_cast<const exprt &>(get_nil_irep());
+  step.cond_expr = static_cast<const exprt &>(get_nil_irep());
+  step.io_args.clear();
+  step.ssa_function_arguments.clear();
+  step.ssa_function_arguments.shrink_to_fit();
+}
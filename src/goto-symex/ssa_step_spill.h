@@ -0,0 +1,64 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storage of the expressions of SSA steps in a temporary file
+
+#ifndef CPROVER_GOTO_SYMEX_SSA_STEP_SPILL_H
+#define CPROVER_GOTO_SYMEX_SSA_STEP_SPILL_H
+
+#include <util/tempfile.h>
+
+#include <fstream>
+
+class SSA_stept;
+
+/// Writes the expressions of SSA steps to a temporary file, so that they can
+/// be dropped from memory and read back when they are needed again. Each
+/// step is serialised independently of all others using
+/// \ref irep_serializationt, so that reading back a step does not require
+/// reading back any other step. Only the expressions of a step are stored
+/// in the file: its type, source, flags and the handles obtained during
+/// conversion remain in memory.
+class ssa_step_spillt
+{
+public:
+  ssa_step_spillt();
+
+  ssa_step_spillt(const ssa_step_spillt &) = delete;
+
+  /// Write the expressions of \p step to the file and drop them from memory.
+  /// Records the position in the file in `step.spill_position`.
+  void spill(SSA_stept &step);
+
+  /// Read the expressions of the spilled \p step back from the file.
+  /// At most one step is loaded at any time.
+  void load(SSA_stept &step);
+
+  /// Drop the expressions of the spilled \p step from memory again, after
+  /// they were read by \ref load.
+  void unload(SSA_stept &step);
+
+  bool is_loaded(const SSA_stept &step) const
+  {
+    return loaded_step == &step;
+  }
+
+  /// Read the expressions of the spilled \p step back from the file and keep
+  /// them in memory, which makes \p step an ordinary step again.
+  void restore(SSA_stept &step);
+
+private:
+  temporary_filet file;
+  std::fstream stream;
+  const SSA_stept *loaded_step = nullptr;
+
+  static void drop(SSA_stept &step);
+};
+
+#endif // CPROVER_GOTO_SYMEX_SSA_STEP_SPILL_H
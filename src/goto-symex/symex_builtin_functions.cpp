@@ -165,6 +165,12 @@ void goto_symext::symex_allocate(
   value_symbol.is_file_local = false;
   value_symbol.type.set(ID_C_dynamic, true);
 
+  if(points_to_oracle)
+  {
+    points_to_oracle->add_dynamic_object(
+      value_symbol.symbol_expr(), state.source.pc->location_number);
+  }
+
   // to allow constant propagation
   exprt zero_init = state.rename(to_binary_expr(code).op1(), ns).get();
   simplify(zero_init, ns);
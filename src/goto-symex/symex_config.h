@@ -51,6 +51,11 @@ struct symex_configt final
   /// Maximum sizes for which field sensitivity will be applied to array cells
   std::size_t max_field_sensitivity_array_size;
 
+  /// \brief Whether to apply field sensitivity to the cells of arrays
+  /// exceeding \ref max_field_sensitivity_array_size that are accessed at
+  /// constant indices, keeping all other cells in the array symbol.
+  bool sparse_array_field_sensitivity;
+
   /// \brief Whether this run of symex is under complexity limits. This
   /// enables certain analyses that otherwise aren't run.
   bool complexity_limits_active;
@@ -63,6 +68,12 @@ struct symex_configt final
   ///   Used in goto_symext::dereference_rec
   bool cache_dereferences;
 
+  /// \brief Whether to track the values of pointers in local variables only
+  ///   and to answer points-to queries for other pointers using a
+  ///   flow-insensitive analysis of all reachable functions.
+  ///   Used in goto_symext::dereference_rec
+  bool points_to_oracle;
+
   /// \brief Construct a symex_configt using options specified in an
   /// \ref optionst
   explicit symex_configt(const optionst &options);
@@ -316,7 +316,8 @@ void goto_symext::dereference_rec(
     tmp1 = state.field_sensitivity.apply(ns, state, std::move(tmp1), false);
 
     // we need to set up some elaborate call-backs
-    symex_dereference_statet symex_dereference_state(state, ns);
+    symex_dereference_statet symex_dereference_state(
+      state, ns, points_to_oracle.get());
 
     value_set_dereferencet dereference(
       ns,
@@ -480,6 +481,8 @@ void goto_symext::dereference(exprt &expr, statet &state, bool write)
 {
   PRECONDITION(!state.call_stack().empty());
 
+  profiler.count_dereference();
+
   // Symbols whose address is taken need to be renamed to level 1
   // in order to distinguish addresses of local variables
   // from different frames.
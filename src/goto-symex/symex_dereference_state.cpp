@@ -11,6 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "symex_dereference_state.h"
 
+#include "renaming_level.h"
+
+#include <algorithm>
+
 /// Get or create a failed symbol for the given pointer-typed expression. These
 /// are used as placeholders when dereferencing expressions that are illegal to
 /// dereference, such as null pointers. The \ref add_failed_symbols pass must
@@ -74,9 +78,30 @@ symex_dereference_statet::get_or_create_failed_symbol(const exprt &expr)
   return nullptr;
 }
 
-/// Just forwards a value-set query to `state.value_set`
+/// Forwards a value-set query to `state.value_set`. If that does not know all
+/// values of \p expr, as it does not track all pointers when there is a
+/// points-to oracle, the values the oracle finds for \p expr are used
+/// instead of the unknown ones.
 std::vector<exprt>
 symex_dereference_statet::get_value_set(const exprt &expr) const
 {
-  return state.value_set.get_value_set(expr, ns);
+  std::vector<exprt> result = state.value_set.get_value_set(expr, ns);
+  if(points_to_oracle == nullptr)
+    return result;
+
+  const auto unknown =
+    std::remove_if(result.begin(), result.end(), [](const exprt &value) {
+      return value.id() == ID_unknown;
+    });
+  if(unknown == result.end())
+    return result;
+  result.erase(unknown, result.end());
+
+  for(auto &value : points_to_oracle->get_value_set(get_original_name(expr)))
+  {
+    if(std::find(result.begin(), result.end(), value) == result.end())
+      result.push_back(std::move(value));
+  }
+
+  return result;
 }
@@ -18,21 +18,26 @@ Author: Daniel Kroening, kroening@kroening.com
 
 /// Callback object that \ref goto_symext::dereference_rec provides to
 /// \ref value_set_dereferencet to provide value sets (from goto-symex's
-/// working value set) and retrieve or create failed symbols on demand.
+/// working value set, completed by a points-to oracle if one is given) and
+/// retrieve or create failed symbols on demand.
 /// For details of symex-dereference's operation see
 /// \ref goto_symext::dereference
 class symex_dereference_statet:
   public dereference_callbackt
 {
 public:
-  symex_dereference_statet(goto_symext::statet &_state, const namespacet &ns)
-    : state(_state), ns(ns)
+  symex_dereference_statet(
+    goto_symext::statet &_state,
+    const namespacet &ns,
+    const value_set_oraclet *points_to_oracle = nullptr)
+    : state(_state), ns(ns), points_to_oracle(points_to_oracle)
   {
   }
 
 protected:
   goto_symext::statet &state;
   const namespacet &ns;
+  const value_set_oraclet *points_to_oracle;
 
   std::vector<exprt> get_value_set(const exprt &expr) const override;
 
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_symex.h"
 
 #include <memory>
+#include <unordered_set>
 
 #include <pointer-analysis/value_set_dereference.h>
 
@@ -51,9 +52,12 @@ symex_configt::symex_configt(const optionst &options)
             ? options.get_unsigned_int_option(
                 "max-field-sensitivity-array-size")
             : DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE),
+    sparse_array_field_sensitivity(
+      options.get_bool_option("sparse-array-field-sensitivity")),
     complexity_limits_active(
       options.get_signed_int_option("symex-complexity-limit") > 0),
-    cache_dereferences{options.get_bool_option("symex-cache-dereferences")}
+    cache_dereferences{options.get_bool_option("symex-cache-dereferences")},
+    points_to_oracle{options.get_bool_option("symex-points-to-oracle")}
 {
 }
 
@@ -399,6 +403,83 @@ void goto_symext::resume_symex_from_saved_state(
       new_symbol_table);
 }
 
+/// Collect the functions reachable from \p entry_point_id via direct calls
+/// \param get_goto_function: The delegate to retrieve function bodies
+/// \param entry_point_id: The function to start the search from
+/// \return The identifiers and bodies of the functions found, including the
+///   entry point
+static std::vector<
+  std::pair<irep_idt, const goto_functionst::goto_functiont *>>
+reachable_functions(
+  const goto_symext::get_goto_functiont &get_goto_function,
+  const irep_idt &entry_point_id)
+{
+  std::vector<std::pair<irep_idt, const goto_functionst::goto_functiont *>>
+    result;
+
+  std::unordered_set<irep_idt> seen{entry_point_id};
+  std::vector<irep_idt> worklist{entry_point_id};
+
+  while(!worklist.empty())
+  {
+    const irep_idt function_id = worklist.back();
+    worklist.pop_back();
+
+    const goto_functionst::goto_functiont *function;
+    try
+    {
+      function = &get_goto_function(function_id);
+    }
+    catch(const std::out_of_range &)
+    {
+      continue;
+    }
+
+    result.emplace_back(function_id, function);
+
+    for(const auto &instruction : function->body.instructions)
+    {
+      if(
+        instruction.is_function_call() &&
+        instruction.call_function().id() == ID_symbol)
+      {
+        const irep_idt &callee =
+          to_symbol_expr(instruction.call_function()).get_identifier();
+        if(seen.insert(callee).second)
+          worklist.push_back(callee);
+      }
+    }
+  }
+
+  return result;
+}
+
+/// Collect the constant indices at which large arrays are accessed in any of
+/// the functions reachable from \p entry_point_id via direct calls.
+/// \param get_goto_function: The delegate to retrieve function bodies
+/// \param entry_point_id: The function to start the search from
+/// \param max_array_size: Maximum size of arrays that are fully expanded by
+///   field sensitivity
+/// \return Indices to track per array, see
+///   \ref field_sensitivityt::set_sparse_array_indices
+static std::shared_ptr<const field_sensitivityt::sparse_array_indicest>
+collect_sparse_array_indices(
+  const goto_symext::get_goto_functiont &get_goto_function,
+  const irep_idt &entry_point_id,
+  std::size_t max_array_size)
+{
+  auto indices = std::make_shared<field_sensitivityt::sparse_array_indicest>();
+
+  for(const auto &function :
+      reachable_functions(get_goto_function, entry_point_id))
+  {
+    field_sensitivityt::collect_sparse_array_indices(
+      function.second->body, max_array_size, *indices);
+  }
+
+  return indices;
+}
+
 std::unique_ptr<goto_symext::statet> goto_symext::initialize_entry_point_state(
   const get_goto_functiont &get_goto_function)
 {
@@ -440,6 +521,39 @@ std::unique_ptr<goto_symext::statet> goto_symext::initialize_entry_point_state(
 
   state->run_validation_checks = symex_config.run_validation_checks;
 
+  if(symex_config.points_to_oracle)
+  {
+    state->track_only_local_pointers = true;
+
+    if(!points_to_oracle)
+    {
+      log.status() << "Computing points-to sets of reachable functions"
+                   << messaget::eom;
+
+      points_to_oracle =
+        util_make_unique<value_set_oraclet>(namespacet{outer_symbol_table});
+      for(const auto &function :
+          reachable_functions(get_goto_function, entry_point_id))
+      {
+        points_to_oracle->add_function(function.first, function.second->body);
+      }
+      points_to_oracle->solve();
+
+      log.statistics() << "Points-to sets took "
+                       << points_to_oracle->iterations()
+                       << " passes over the program" << messaget::eom;
+    }
+  }
+
+  if(symex_config.sparse_array_field_sensitivity)
+  {
+    state->field_sensitivity.set_sparse_array_indices(
+      collect_sparse_array_indices(
+        get_goto_function,
+        entry_point_id,
+        symex_config.max_field_sensitivity_array_size));
+  }
+
   // initialize support analyses
   auto emplace_safe_pointers_result =
     path_storage.safe_pointers.emplace(entry_point_id, local_safe_pointerst{});
@@ -594,8 +708,15 @@ void goto_symext::symex_step(
 {
   // Print debug statements if they've been enabled.
   print_symex_step(state);
+
+  if(profiler.is_enabled())
+    profiler.begin_step(state, target, get_goto_function);
+
   execute_next_instruction(get_goto_function, state);
   kill_instruction_local_symbols(state);
+
+  if(profiler.is_enabled())
+    profiler.end_step(target);
 }
 
 void goto_symext::execute_next_instruction(
@@ -0,0 +1,262 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Attribution of the cost of symbolic execution to functions and loops
+
+#include "symex_profiler.h"
+
+#include <util/invariant.h>
+#include <util/json.h>
+#include <util/options.h>
+
+#include "goto_symex_state.h"
+#include "symex_target_equation.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+symex_profilert::symex_profilert(const optionst &options)
+  : enabled(!options.get_option("symex-profile").empty())
+{
+}
+
+symex_profilert::statisticst &symex_profilert::statisticst::
+operator+=(const statisticst &other)
+{
+  time += other.time;
+  instructions += other.instructions;
+  ssa_steps += other.ssa_steps;
+  assignments += other.assignments;
+  dereferences += other.dereferences;
+  phi_nodes += other.phi_nodes;
+  return *this;
+}
+
+const std::vector<symex_profilert::loopt> &symex_profilert::loops_of(
+  const irep_idt &function_id,
+  const get_goto_functiont &get_goto_function)
+{
+  auto entry = loops.insert({function_id, {}});
+  if(!entry.second)
+    return entry.first->second;
+
+  std::vector<loopt> &function_loops = entry.first->second;
+  const goto_programt &body = get_goto_function(function_id).body;
+  forall_goto_program_instructions(it, body)
+  {
+    if(it->is_backwards_goto())
+    {
+      function_loops.push_back(
+        {it->get_target()->location_number,
+         it->location_number,
+         goto_programt::loop_id(function_id, *it)});
+    }
+  }
+
+  std::sort(
+    function_loops.begin(),
+    function_loops.end(),
+    [](const loopt &a, const loopt &b) {
+      return a.begin < b.begin || (a.begin == b.begin && a.end > b.end);
+    });
+
+  return function_loops;
+}
+
+void symex_profilert::begin_step(
+  const goto_symex_statet &state,
+  const symex_target_equationt &equation,
+  const get_goto_functiont &get_goto_function)
+{
+  PRECONDITION(enabled);
+
+  step_stack.clear();
+  step_stack_is_loop.clear();
+  step_loop_id = irep_idt();
+
+  // The call site of each frame but the first is in the function of the frame
+  // below it, and the current instruction is in the function of the top frame.
+  const call_stackt &call_stack = state.call_stack();
+  for(std::size_t i = 0; i < call_stack.size(); ++i)
+  {
+    const symex_targett::sourcet &source =
+      i + 1 < call_stack.size() ? call_stack[i + 1].calling_location
+                                : state.source;
+    step_stack.push_back(source.function_id);
+    step_stack_is_loop.push_back(false);
+    step_loop_id = irep_idt();
+
+    const unsigned location_number = source.pc->location_number;
+    for(const loopt &loop : loops_of(source.function_id, get_goto_function))
+    {
+      if(loop.begin > location_number)
+        break;
+      if(location_number <= loop.end)
+      {
+        step_stack.push_back(loop.loop_id);
+        step_stack_is_loop.push_back(true);
+        step_loop_id = loop.loop_id;
+      }
+    }
+  }
+
+  step_function_id = state.source.function_id;
+  step_first_ssa_step = equation.SSA_steps.size();
+  step_assignments = 0;
+  step_dereferences = 0;
+  step_start = std::chrono::steady_clock::now();
+}
+
+void symex_profilert::end_step(const symex_target_equationt &equation)
+{
+  PRECONDITION(enabled);
+
+  statisticst step;
+  step.time = std::chrono::steady_clock::now() - step_start;
+  step.instructions = 1;
+  step.ssa_steps = equation.SSA_steps.size() - step_first_ssa_step;
+  step.assignments = step_assignments;
+  step.dereferences = step_dereferences;
+
+  // the steps of this instruction are the last ones of the equation
+  auto it = equation.SSA_steps.rbegin();
+  for(std::size_t n = step.ssa_steps; n != 0; --n, ++it)
+  {
+    if(
+      it->is_assignment() &&
+      it->assignment_type == symex_targett::assignment_typet::PHI)
+    {
+      ++step.phi_nodes;
+    }
+  }
+
+  auto entry = contexts.insert({step_stack, contextt{}});
+  if(entry.second)
+  {
+    contextt &context = entry.first->second;
+    context.function_id = step_function_id;
+    context.loop_id = step_loop_id;
+    for(std::size_t i = 0; i < step_stack.size(); ++i)
+    {
+      if(step_stack_is_loop[i])
+        context.enclosing_loops.insert(step_stack[i]);
+      else
+        context.enclosing_functions.insert(step_stack[i]);
+    }
+  }
+  entry.first->second.statistics += step;
+}
+
+json_objectt symex_profilert::statisticst::to_json() const
+{
+  return json_objectt{
+    {"time", json_numbert{std::to_string(time.count())}},
+    {"instructions", json_numbert{std::to_string(instructions)}},
+    {"ssaSteps", json_numbert{std::to_string(ssa_steps)}},
+    {"assignments", json_numbert{std::to_string(assignments)}},
+    {"dereferences", json_numbert{std::to_string(dereferences)}},
+    {"phiNodes", json_numbert{std::to_string(phi_nodes)}}};
+}
+
+/// Entries of \p totals as a JSON array, most expensive first, with the
+/// identifier of each entry as member \p key
+static json_arrayt sorted_json(
+  const std::map<irep_idt, symex_profilert::statisticst> &totals,
+  const std::string &key)
+{
+  std::vector<std::pair<irep_idt, symex_profilert::statisticst>> sorted(
+    totals.begin(), totals.end());
+  std::stable_sort(
+    sorted.begin(),
+    sorted.end(),
+    [](
+      const std::pair<irep_idt, symex_profilert::statisticst> &a,
+      const std::pair<irep_idt, symex_profilert::statisticst> &b) {
+      return a.second.time > b.second.time;
+    });
+
+  json_arrayt result;
+  for(const auto &entry : sorted)
+  {
+    json_objectt json = entry.second.to_json();
+    json[key] = json_stringt{entry.first};
+    result.push_back(std::move(json));
+  }
+  return result;
+}
+
+jsont symex_profilert::output_json() const
+{
+  statisticst total;
+  std::map<irep_idt, statisticst> functions;
+  std::map<irep_idt, statisticst> loops;
+  std::vector<std::pair<std::string, const contextt *>> sorted_contexts;
+
+  for(const auto &entry : contexts)
+  {
+    const contextt &context = entry.second;
+    total += context.statistics;
+    for(const irep_idt &function_id : context.enclosing_functions)
+      functions[function_id] += context.statistics;
+    for(const irep_idt &loop_id : context.enclosing_loops)
+      loops[loop_id] += context.statistics;
+
+    std::string stack;
+    for(const irep_idt &id : entry.first)
+    {
+      if(!stack.empty())
+        stack += ';';
+      stack += id2string(id);
+    }
+    sorted_contexts.emplace_back(std::move(stack), &context);
+  }
+
+  std::stable_sort(
+    sorted_contexts.begin(),
+    sorted_contexts.end(),
+    [](
+      const std::pair<std::string, const contextt *> &a,
+      const std::pair<std::string, const contextt *> &b) {
+      return a.second->statistics.time > b.second->statistics.time;
+    });
+
+  json_arrayt json_contexts;
+  for(const auto &entry : sorted_contexts)
+  {
+    json_objectt json = entry.second->statistics.to_json();
+    json["stack"] = json_stringt{entry.first};
+    json["function"] = json_stringt{entry.second->function_id};
+    if(!entry.second->loop_id.empty())
+      json["loop"] = json_stringt{entry.second->loop_id};
+    json_contexts.push_back(std::move(json));
+  }
+
+  return json_objectt{{"total", total.to_json()},
+                      {"functions", sorted_json(functions, "function")},
+                      {"loops", sorted_json(loops, "loop")},
+                      {"contexts", std::move(json_contexts)}};
+}
+
+bool symex_profilert::generate_report(const std::string &path) const
+{
+  PRECONDITION(!path.empty());
+
+  if(path == "-")
+  {
+    std::cout << output_json() << '\n';
+    return !std::cout.good();
+  }
+  else
+  {
+    std::ofstream out(path.c_str());
+    out << output_json() << '\n';
+    return !out.good();
+  }
+}
@@ -0,0 +1,142 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Attribution of the cost of symbolic execution to functions and loops
+
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_PROFILER_H
+#define CPROVER_GOTO_SYMEX_SYMEX_PROFILER_H
+
+#include <goto-programs/goto_functions.h>
+
+#include <chrono>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class goto_symex_statet;
+class json_objectt;
+class jsont;
+class optionst;
+class symex_target_equationt;
+
+/// Records, for each context in which symbolic execution executes an
+/// instruction, the time spent and the work done. A context is the stack of
+/// functions being executed together with the loops that the call sites and
+/// the current instruction are nested in, outermost first, for example
+/// `main;main.0;f;f.1`. The cost of an instruction is attributed to its own
+/// context only, which makes the contexts and their costs a flame graph.
+class symex_profilert
+{
+public:
+  /// The profiler is enabled if the `symex-profile` option is set.
+  explicit symex_profilert(const optionst &options);
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  /// Record a call of \ref goto_symext::symex_assign
+  void count_assignment()
+  {
+    ++step_assignments;
+  }
+
+  /// Record a call of \ref goto_symext::dereference
+  void count_dereference()
+  {
+    ++step_dereferences;
+  }
+
+  using get_goto_functiont =
+    std::function<const goto_functionst::goto_functiont &(const irep_idt &)>;
+
+  /// Start measuring the execution of the instruction `state.source.pc`.
+  void begin_step(
+    const goto_symex_statet &state,
+    const symex_target_equationt &equation,
+    const get_goto_functiont &get_goto_function);
+
+  /// Attribute the cost of the instruction since \ref begin_step to its
+  /// context.
+  void end_step(const symex_target_equationt &equation);
+
+  /// Write the report as JSON to \p path, or to the standard output if
+  /// \p path is `-`. The report lists the cost of each context, as well as
+  /// the cost of each function and each loop including everything executed
+  /// while they are active, most expensive first.
+  /// \return true if the report could not be written
+  bool generate_report(const std::string &path) const;
+
+  jsont output_json() const;
+
+  struct statisticst
+  {
+    std::chrono::duration<double> time{0};
+    std::size_t instructions = 0;
+    std::size_t ssa_steps = 0;
+    std::size_t assignments = 0;
+    std::size_t dereferences = 0;
+    std::size_t phi_nodes = 0;
+
+    statisticst &operator+=(const statisticst &other);
+
+    json_objectt to_json() const;
+  };
+
+protected:
+  bool enabled;
+
+  struct contextt
+  {
+    irep_idt function_id;
+    /// The innermost loop of \ref function_id containing the instruction, if
+    /// any
+    irep_idt loop_id;
+    /// Functions and loops that are active in this context
+    std::set<irep_idt> enclosing_functions;
+    std::set<irep_idt> enclosing_loops;
+    statisticst statistics;
+  };
+
+  /// Contexts by their stack of function and loop identifiers
+  std::map<std::vector<irep_idt>, contextt> contexts;
+
+  /// Loops of a function as the range of location numbers they span
+  struct loopt
+  {
+    unsigned begin;
+    unsigned end;
+    irep_idt loop_id;
+  };
+
+  /// Loops by function, sorted such that outer loops precede the loops
+  /// nested in them
+  std::unordered_map<irep_idt, std::vector<loopt>> loops;
+
+  const std::vector<loopt> &loops_of(
+    const irep_idt &function_id,
+    const get_goto_functiont &get_goto_function);
+
+  // the step that is currently measured
+  std::vector<irep_idt> step_stack;
+  std::vector<bool> step_stack_is_loop;
+  irep_idt step_function_id;
+  irep_idt step_loop_id;
+  std::chrono::steady_clock::time_point step_start;
+  std::size_t step_first_ssa_step = 0;
+  std::size_t step_assignments = 0;
+  std::size_t step_dereferences = 0;
+};
+
+#endif // CPROVER_GOTO_SYMEX_SYMEX_PROFILER_H
@@ -40,7 +40,7 @@ void symex_target_equationt::shared_read(
   SSA_step.ssa_lhs=ssa_object;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::shared_write(
@@ -56,7 +56,7 @@ void symex_target_equationt::shared_write(
   SSA_step.ssa_lhs=ssa_object;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// spawn a new thread
@@ -68,7 +68,7 @@ void symex_target_equationt::spawn(
   SSA_stept &SSA_step=SSA_steps.back();
   SSA_step.guard=guard;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::memory_barrier(
@@ -79,7 +79,7 @@ void symex_target_equationt::memory_barrier(
   SSA_stept &SSA_step=SSA_steps.back();
   SSA_step.guard=guard;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// start an atomic section
@@ -93,7 +93,7 @@ void symex_target_equationt::atomic_begin(
   SSA_step.guard=guard;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// end an atomic section
@@ -107,7 +107,7 @@ void symex_target_equationt::atomic_end(
   SSA_step.guard=guard;
   SSA_step.atomic_section_id=atomic_section_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::assignment(
@@ -129,7 +129,7 @@ void symex_target_equationt::assignment(
                                               ssa_rhs,
                                               assignment_type});
 
-  merge_ireps(SSA_steps.back());
+  step_added(SSA_steps.back());
 }
 
 void symex_target_equationt::decl(
@@ -154,7 +154,7 @@ void symex_target_equationt::decl(
   // there so we see the symbols
   SSA_step.cond_expr=equal_exprt(SSA_step.ssa_lhs, SSA_step.ssa_lhs);
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 /// declare a fresh variable
@@ -175,7 +175,7 @@ void symex_target_equationt::location(
 
   SSA_step.guard=guard;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::function_call(
@@ -194,7 +194,7 @@ void symex_target_equationt::function_call(
     SSA_step.ssa_function_arguments.emplace_back(arg.get());
   SSA_step.hidden = hidden;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::function_return(
@@ -210,7 +210,7 @@ void symex_target_equationt::function_return(
   SSA_step.called_function = function_id;
   SSA_step.hidden = hidden;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::output(
@@ -227,7 +227,7 @@ void symex_target_equationt::output(
     SSA_step.io_args.emplace_back(arg.get());
   SSA_step.io_id=output_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::output_fmt(
@@ -246,7 +246,7 @@ void symex_target_equationt::output_fmt(
   SSA_step.formatted=true;
   SSA_step.format_string=fmt;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::input(
@@ -262,7 +262,7 @@ void symex_target_equationt::input(
   SSA_step.io_args=args;
   SSA_step.io_id=input_id;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::assumption(
@@ -276,7 +276,7 @@ void symex_target_equationt::assumption(
   SSA_step.guard=guard;
   SSA_step.cond_expr=cond;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::assertion(
@@ -292,7 +292,7 @@ void symex_target_equationt::assertion(
   SSA_step.cond_expr=cond;
   SSA_step.comment=msg;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::goto_instruction(
@@ -306,7 +306,7 @@ void symex_target_equationt::goto_instruction(
   SSA_step.guard=guard;
   SSA_step.cond_expr = cond.get();
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
 void symex_target_equationt::constraint(
@@ -322,9 +322,41 @@ void symex_target_equationt::constraint(
   SSA_step.cond_expr=cond;
   SSA_step.comment=msg;
 
-  merge_ireps(SSA_step);
+  step_added(SSA_step);
 }
 
+namespace
+{
+/// Makes the expressions of a spilled SSA step available while in scope. Does
+/// nothing for steps that have not been spilled or are already loaded.
+class loaded_stept
+{
+public:
+  loaded_stept(ssa_step_spillt *spill, SSA_stept &step)
+    : spill(
+        spill && step.spill_position.has_value() && !spill->is_loaded(step)
+          ? spill
+          : nullptr),
+      step(step)
+  {
+    if(this->spill)
+      this->spill->load(step);
+  }
+
+  loaded_stept(const loaded_stept &) = delete;
+
+  ~loaded_stept()
+  {
+    if(spill)
+      spill->unload(step);
+  }
+
+private:
+  ssa_step_spillt *spill;
+  SSA_stept &step;
+};
+} // namespace
+
 void symex_target_equationt::convert_without_assertions(
   decision_proceduret &decision_procedure)
 {
@@ -332,6 +364,27 @@ void symex_target_equationt::convert_without_assertions(
     hardness.register_ssa_size(SSA_steps.size());
   });
 
+  if(has_spilled_steps())
+  {
+    // Convert step by step, so that each spilled step is read back only once.
+    std::size_t step_index = 0;
+    for(auto &step : SSA_steps)
+    {
+      const loaded_stept loaded{spill.get(), step};
+      convert_guard(decision_procedure, step, step_index);
+      convert_assignment(decision_procedure, step, step_index);
+      convert_decl(decision_procedure, step, step_index);
+      convert_assumption(decision_procedure, step, step_index);
+      convert_goto_instruction(decision_procedure, step, step_index);
+      convert_function_call(decision_procedure, step, step_index);
+      convert_io(decision_procedure, step, step_index);
+      convert_constraint(decision_procedure, step, step_index);
+      ++step_index;
+    }
+
+    return;
+  }
+
   convert_guards(decision_procedure);
   convert_assignments(decision_procedure);
   convert_decls(decision_procedure);
@@ -361,20 +414,27 @@ void symex_target_equationt::convert_assignments(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_assignment(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_assignment(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(step.is_assignment() && !step.ignore && !step.converted)
   {
-    if(step.is_assignment() && !step.ignore && !step.converted)
-    {
-      log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
-        step.output(mstream);
-        mstream << messaget::eom;
-      });
+    const loaded_stept loaded{spill.get(), step};
 
-      decision_procedure.set_to_true(step.cond_expr);
-      step.converted = true;
-      with_solver_hardness(
-        decision_procedure, hardness_register_ssa(step_index, step));
-    }
-    ++step_index;
+    log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+      step.output(mstream);
+      mstream << messaget::eom;
+    });
+
+    decision_procedure.set_to_true(step.cond_expr);
+    step.converted = true;
+    with_solver_hardness(
+      decision_procedure, hardness_register_ssa(step_index, step));
   }
 }
 
@@ -383,19 +443,26 @@ void symex_target_equationt::convert_decls(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_decl(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_decl(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(step.is_decl() && !step.ignore && !step.converted)
   {
-    if(step.is_decl() && !step.ignore && !step.converted)
-    {
-      // The result is not used, these have no impact on
-      // the satisfiability of the formula.
-      decision_procedure.handle(step.cond_expr);
-      decision_procedure.handle(
-        equal_exprt{step.ssa_full_lhs, step.ssa_full_lhs});
-      step.converted = true;
-      with_solver_hardness(
-        decision_procedure, hardness_register_ssa(step_index, step));
-    }
-    ++step_index;
+    const loaded_stept loaded{spill.get(), step};
+
+    // The result is not used, these have no impact on
+    // the satisfiability of the formula.
+    decision_procedure.handle(step.cond_expr);
+    decision_procedure.handle(
+      equal_exprt{step.ssa_full_lhs, step.ssa_full_lhs});
+    step.converted = true;
+    with_solver_hardness(
+      decision_procedure, hardness_register_ssa(step_index, step));
   }
 }
 
@@ -404,23 +471,30 @@ void symex_target_equationt::convert_guards(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_guard(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_guard(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(step.ignore)
+    step.guard_handle = false_exprt();
+  else
   {
-    if(step.ignore)
-      step.guard_handle = false_exprt();
-    else
-    {
-      log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
-        step.output(mstream);
-        mstream << messaget::eom;
-      });
+    const loaded_stept loaded{spill.get(), step};
 
-      step.guard_handle = decision_procedure.handle(step.guard);
-      with_solver_hardness(
-        decision_procedure, [step_index, &step](solver_hardnesst &hardness) {
-          hardness.register_ssa(step_index, step.guard, step.source.pc);
-        });
-    }
-    ++step_index;
+    log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+      step.output(mstream);
+      mstream << messaget::eom;
+    });
+
+    step.guard_handle = decision_procedure.handle(step.guard);
+    with_solver_hardness(
+      decision_procedure, [step_index, &step](solver_hardnesst &hardness) {
+        hardness.register_ssa(step_index, step.guard, step.source.pc);
+      });
   }
 }
 
@@ -429,26 +503,32 @@ void symex_target_equationt::convert_assumptions(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_assumption(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_assumption(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(step.is_assume())
   {
-    if(step.is_assume())
+    if(step.ignore)
+      step.cond_handle = true_exprt();
+    else
     {
-      if(step.ignore)
-        step.cond_handle = true_exprt();
-      else
-      {
-        log.conditional_output(
-          log.debug(), [&step](messaget::mstreamt &mstream) {
-            step.output(mstream);
-            mstream << messaget::eom;
-          });
+      const loaded_stept loaded{spill.get(), step};
+
+      log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+        step.output(mstream);
+        mstream << messaget::eom;
+      });
 
-        step.cond_handle = decision_procedure.handle(step.cond_expr);
+      step.cond_handle = decision_procedure.handle(step.cond_expr);
 
-        with_solver_hardness(
-          decision_procedure, hardness_register_ssa(step_index, step));
-      }
+      with_solver_hardness(
+        decision_procedure, hardness_register_ssa(step_index, step));
     }
-    ++step_index;
   }
 }
 
@@ -457,25 +537,31 @@ void symex_target_equationt::convert_goto_instructions(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_goto_instruction(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_goto_instruction(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(step.is_goto())
   {
-    if(step.is_goto())
+    if(step.ignore)
+      step.cond_handle = true_exprt();
+    else
     {
-      if(step.ignore)
-        step.cond_handle = true_exprt();
-      else
-      {
-        log.conditional_output(
-          log.debug(), [&step](messaget::mstreamt &mstream) {
-            step.output(mstream);
-            mstream << messaget::eom;
-          });
+      const loaded_stept loaded{spill.get(), step};
 
-        step.cond_handle = decision_procedure.handle(step.cond_expr);
-        with_solver_hardness(
-          decision_procedure, hardness_register_ssa(step_index, step));
-      }
+      log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+        step.output(mstream);
+        mstream << messaget::eom;
+      });
+
+      step.cond_handle = decision_procedure.handle(step.cond_expr);
+      with_solver_hardness(
+        decision_procedure, hardness_register_ssa(step_index, step));
     }
-    ++step_index;
   }
 }
 
@@ -484,21 +570,28 @@ void symex_target_equationt::convert_constraints(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_constraint(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_constraint(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(step.is_constraint() && !step.ignore && !step.converted)
   {
-    if(step.is_constraint() && !step.ignore && !step.converted)
-    {
-      log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
-        step.output(mstream);
-        mstream << messaget::eom;
-      });
+    const loaded_stept loaded{spill.get(), step};
 
-      decision_procedure.set_to_true(step.cond_expr);
-      step.converted = true;
+    log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+      step.output(mstream);
+      mstream << messaget::eom;
+    });
 
-      with_solver_hardness(
-        decision_procedure, hardness_register_ssa(step_index, step));
-    }
-    ++step_index;
+    decision_procedure.set_to_true(step.cond_expr);
+    step.converted = true;
+
+    with_solver_hardness(
+      decision_procedure, hardness_register_ssa(step_index, step));
   }
 }
 
@@ -525,6 +618,7 @@ void symex_target_equationt::convert_assertions(
 
       if(step.is_assert() && !step.ignore && !step.converted)
       {
+        const loaded_stept loaded{spill.get(), step};
         step.converted = true;
         decision_procedure.set_to_false(step.cond_expr);
         step.cond_handle = false_exprt();
@@ -535,6 +629,7 @@ void symex_target_equationt::convert_assertions(
       }
       else if(step.is_assume())
       {
+        const loaded_stept loaded{spill.get(), step};
         decision_procedure.set_to_true(step.cond_expr);
 
         with_solver_hardness(
@@ -563,6 +658,7 @@ void symex_target_equationt::convert_assertions(
 
     if(step.is_assert() && !step.ignore && !step.converted)
     {
+      const loaded_stept loaded{spill.get(), step};
       step.converted = true;
 
       log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
@@ -619,38 +715,45 @@ void symex_target_equationt::convert_function_calls(
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_function_call(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_function_call(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(!step.ignore)
   {
-    if(!step.ignore)
-    {
-      and_exprt::operandst conjuncts;
-      step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
+    const loaded_stept loaded{spill.get(), step};
 
-      for(const auto &arg : step.ssa_function_arguments)
+    and_exprt::operandst conjuncts;
+    step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
+
+    for(const auto &arg : step.ssa_function_arguments)
+    {
+      if(arg.is_constant() ||
+         arg.id()==ID_string_constant)
+        step.converted_function_arguments.push_back(arg);
+      else
       {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_function_arguments.push_back(arg);
-        else
-        {
-          const irep_idt identifier="symex::args::"+std::to_string(argument_count++);
-          symbol_exprt symbol(identifier, arg.type());
-
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
-
-          decision_procedure.set_to(eq, true);
-          conjuncts.push_back(eq);
-          step.converted_function_arguments.push_back(symbol);
-        }
+        const irep_idt identifier="symex::args::"+std::to_string(argument_count++);
+        symbol_exprt symbol(identifier, arg.type());
+
+        equal_exprt eq(arg, symbol);
+        merge_irep(eq);
+
+        decision_procedure.set_to(eq, true);
+        conjuncts.push_back(eq);
+        step.converted_function_arguments.push_back(symbol);
       }
-      with_solver_hardness(
-        decision_procedure,
-        [step_index, &conjuncts, &step](solver_hardnesst &hardness) {
-          hardness.register_ssa(
-            step_index, conjunction(conjuncts), step.source.pc);
-        });
     }
-    ++step_index;
+    with_solver_hardness(
+      decision_procedure,
+      [step_index, &conjuncts, &step](solver_hardnesst &hardness) {
+        hardness.register_ssa(
+          step_index, conjunction(conjuncts), step.source.pc);
+      });
   }
 }
 
@@ -658,38 +761,105 @@ void symex_target_equationt::convert_io(decision_proceduret &decision_procedure)
 {
   std::size_t step_index = 0;
   for(auto &step : SSA_steps)
+    convert_io(decision_procedure, step, step_index++);
+}
+
+void symex_target_equationt::convert_io(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step,
+  std::size_t step_index)
+{
+  if(!step.ignore)
   {
-    if(!step.ignore)
+    const loaded_stept loaded{spill.get(), step};
+
+    and_exprt::operandst conjuncts;
+    for(const auto &arg : step.io_args)
     {
-      and_exprt::operandst conjuncts;
-      for(const auto &arg : step.io_args)
+      if(arg.is_constant() ||
+         arg.id()==ID_string_constant)
+        step.converted_io_args.push_back(arg);
+      else
       {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_io_args.push_back(arg);
-        else
-        {
-          const irep_idt identifier =
-            "symex::io::" + std::to_string(io_count++);
-          symbol_exprt symbol(identifier, arg.type());
-
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
-
-          decision_procedure.set_to(eq, true);
-          conjuncts.push_back(eq);
-          step.converted_io_args.push_back(symbol);
-        }
+        const irep_idt identifier =
+          "symex::io::" + std::to_string(io_count++);
+        symbol_exprt symbol(identifier, arg.type());
+
+        equal_exprt eq(arg, symbol);
+        merge_irep(eq);
+
+        decision_procedure.set_to(eq, true);
+        conjuncts.push_back(eq);
+        step.converted_io_args.push_back(symbol);
       }
-      with_solver_hardness(
-        decision_procedure,
-        [step_index, &conjuncts, &step](solver_hardnesst &hardness) {
-          hardness.register_ssa(
-            step_index, conjunction(conjuncts), step.source.pc);
-        });
     }
-    ++step_index;
+    with_solver_hardness(
+      decision_procedure,
+      [step_index, &conjuncts, &step](solver_hardnesst &hardness) {
+        hardness.register_ssa(
+          step_index, conjunction(conjuncts), step.source.pc);
+      });
+  }
+}
+
+void symex_target_equationt::step_added(SSA_stept &SSA_step)
+{
+  if(!spill)
+  {
+    merge_ireps(SSA_step);
+    return;
   }
+
+  // Sharing is not enforced when spilling, as merge_irep would keep all
+  // expressions in memory.
+  if(passed_steps == 0)
+    next_step_to_spill = SSA_steps.begin();
+
+  while(SSA_steps.size() - passed_steps > resident_steps_limit)
+  {
+    // Assertions are few and are inspected to determine the status of
+    // properties, hence they are kept in memory.
+    if(!next_step_to_spill->is_assert())
+    {
+      spill->spill(*next_step_to_spill);
+      ++spilled_steps;
+    }
+    ++next_step_to_spill;
+    ++passed_steps;
+  }
+}
+
+void symex_target_equationt::enable_spilling(std::size_t limit)
+{
+  PRECONDITION(limit > 0);
+  PRECONDITION(passed_steps == 0);
+
+  if(!spill)
+    spill = std::make_shared<ssa_step_spillt>();
+  resident_steps_limit = limit;
+
+  // merge_irep would keep spilled expressions in memory
+  merge_irep = merge_irept{};
+}
+
+void symex_target_equationt::restore_spilled_steps()
+{
+  if(!spill)
+    return;
+
+  for(auto &step : SSA_steps)
+  {
+    if(step.spill_position.has_value())
+      spill->restore(step);
+  }
+
+  log.statistics() << "Restored " << spilled_steps << " spilled SSA steps"
+                   << messaget::eom;
+
+  spill.reset();
+  resident_steps_limit = 0;
+  spilled_steps = 0;
+  passed_steps = 0;
 }
 
 /// Merging causes identical ireps to be shared.
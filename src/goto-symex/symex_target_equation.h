@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <algorithm>
 #include <iosfwd>
 #include <list>
+#include <memory>
 
 #include <util/invariant.h>
 #include <util/merge_irep.h>
@@ -22,6 +23,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/narrow.h>
 
 #include "ssa_step.h"
+#include "ssa_step_spill.h"
 #include "symex_target.h"
 
 class decision_proceduret;
@@ -265,8 +267,33 @@ class symex_target_equationt:public symex_targett
   void clear()
   {
     SSA_steps.clear();
+    spill.reset();
+    resident_steps_limit = 0;
+    spilled_steps = 0;
+    passed_steps = 0;
   }
 
+  /// Keep the expressions of at most \p limit SSA steps, plus all assertions,
+  /// in memory: whenever a step is added beyond that, the expressions of the
+  /// oldest step still in memory are written to a temporary file, see
+  /// \ref ssa_step_spillt.
+  /// Symex only ever appends steps, hence such a step cannot be touched again
+  /// by merging states. Conversion reads back one step at a time; any other
+  /// operation that uses the expressions of the steps (such as slicing,
+  /// output or trace generation) requires \ref restore_spilled_steps to be
+  /// called first.
+  /// \pre The equation is not copied once spilling has been enabled.
+  void enable_spilling(std::size_t limit);
+
+  bool has_spilled_steps() const
+  {
+    return spilled_steps != 0;
+  }
+
+  /// Read the expressions of all spilled steps back into memory and stop
+  /// spilling.
+  void restore_spilled_steps();
+
   bool has_threads() const
   {
     return std::any_of(
@@ -288,6 +315,53 @@ class symex_target_equationt:public symex_targett
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
 
+  // for spilling the expressions of steps to disk
+  std::shared_ptr<ssa_step_spillt> spill;
+  std::size_t resident_steps_limit = 0;
+  std::size_t spilled_steps = 0;
+  /// Number of steps that have been considered for spilling, which are
+  /// exactly those before \ref next_step_to_spill
+  std::size_t passed_steps = 0;
+  SSA_stepst::iterator next_step_to_spill;
+
+  /// Enforce sharing in the step that has just been added, or spill the
+  /// oldest step if there are more than \ref resident_steps_limit steps in
+  /// memory.
+  void step_added(SSA_stept &SSA_step);
+
+  void convert_guard(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_assignment(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_decl(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_assumption(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_goto_instruction(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_constraint(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_function_call(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+  void convert_io(
+    decision_proceduret &decision_procedure,
+    SSA_stept &step,
+    std::size_t step_index);
+
   // for unique I/O identifiers
   std::size_t io_count = 0;
 
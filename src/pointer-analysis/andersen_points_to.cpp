@@ -0,0 +1,716 @@
+/*******************************************************************\
+
+Module: Inclusion-Based Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Whole-program, flow- and context-insensitive inclusion-based (Andersen
+/// style) points-to analysis
+
+#include "andersen_points_to.h"
+
+#include <util/byte_operators.h>
+#include <util/expr_util.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol_table_base.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+typedef std::vector<std::pair<std::size_t, std::uint64_t>> wordst;
+
+static const std::size_t word_bits = 64;
+
+static bool word_less(
+  const std::pair<std::size_t, std::uint64_t> &word,
+  std::size_t index)
+{
+  return word.first < index;
+}
+
+/// The union of two sorted sequences of words
+static wordst unite(const wordst &a, const wordst &b)
+{
+  wordst result;
+  result.reserve(a.size() + b.size());
+
+  auto it_a = a.begin();
+  auto it_b = b.begin();
+  while(it_a != a.end() || it_b != b.end())
+  {
+    if(it_b == b.end() || (it_a != a.end() && it_a->first < it_b->first))
+      result.push_back(*it_a++);
+    else if(it_a == a.end() || it_b->first < it_a->first)
+      result.push_back(*it_b++);
+    else
+    {
+      result.emplace_back(it_a->first, it_a->second | it_b->second);
+      ++it_a;
+      ++it_b;
+    }
+  }
+
+  return result;
+}
+
+bool points_to_sett::insert(std::size_t element)
+{
+  const std::size_t index = element / word_bits;
+  const std::uint64_t bit = std::uint64_t{1} << (element % word_bits);
+
+  auto it = std::lower_bound(words.begin(), words.end(), index, word_less);
+  if(it != words.end() && it->first == index)
+  {
+    if(it->second & bit)
+      return false;
+    it->second |= bit;
+    return true;
+  }
+
+  words.emplace(it, index, bit);
+  return true;
+}
+
+bool points_to_sett::contains(std::size_t element) const
+{
+  const std::size_t index = element / word_bits;
+  const std::uint64_t bit = std::uint64_t{1} << (element % word_bits);
+
+  auto it = std::lower_bound(words.begin(), words.end(), index, word_less);
+  return it != words.end() && it->first == index && (it->second & bit) != 0;
+}
+
+bool points_to_sett::insert(const points_to_sett &other, points_to_sett &added)
+{
+  wordst new_words;
+
+  auto it = words.begin();
+  for(const auto &word : other.words)
+  {
+    while(it != words.end() && it->first < word.first)
+      ++it;
+
+    const std::uint64_t new_bits =
+      it != words.end() && it->first == word.first ? word.second & ~it->second
+                                                   : word.second;
+    if(new_bits != 0)
+      new_words.emplace_back(word.first, new_bits);
+  }
+
+  if(new_words.empty())
+    return false;
+
+  words = unite(words, new_words);
+  added.words = unite(added.words, new_words);
+  return true;
+}
+
+std::size_t points_to_sett::size() const
+{
+  std::size_t result = 0;
+  for(const auto &word : words)
+  {
+    for(std::uint64_t bits = word.second; bits != 0; bits &= bits - 1)
+      ++result;
+  }
+  return result;
+}
+
+std::vector<std::size_t> points_to_sett::elements() const
+{
+  std::vector<std::size_t> result;
+  for(const auto &word : words)
+  {
+    for(std::size_t bit = 0; bit < word_bits; ++bit)
+    {
+      if((word.second >> bit) & 1)
+        result.push_back(word.first * word_bits + bit);
+    }
+  }
+  return result;
+}
+
+/// Whether a value of type \p type may contain a pointer
+static bool may_hold_pointer(const typet &type)
+{
+  return type.id() == ID_pointer || type.id() == ID_struct_tag ||
+         type.id() == ID_union_tag || type.id() == ID_struct ||
+         type.id() == ID_union || type.id() == ID_array;
+}
+
+andersen_points_tot::nodet andersen_points_tot::new_node()
+{
+  const nodet node = nodes.size();
+  nodes.emplace_back();
+  parent.push_back(node);
+  queued.push_back(false);
+  ++stats.nodes;
+  return node;
+}
+
+andersen_points_tot::nodet andersen_points_tot::find(nodet node)
+{
+  nodet root = node;
+  while(parent[root] != root)
+    root = parent[root];
+
+  while(parent[node] != root)
+  {
+    const nodet next = parent[node];
+    parent[node] = root;
+    node = next;
+  }
+
+  return root;
+}
+
+andersen_points_tot::nodet
+andersen_points_tot::variable_node(const irep_idt &identifier)
+{
+  auto entry = variable_nodes.find(identifier);
+  if(entry != variable_nodes.end())
+    return entry->second;
+
+  const nodet node = new_node();
+  variable_nodes.emplace(identifier, node);
+  return node;
+}
+
+andersen_points_tot::nodet
+andersen_points_tot::return_node(const irep_idt &function_id)
+{
+  auto entry = return_nodes.find(function_id);
+  if(entry != return_nodes.end())
+    return entry->second;
+
+  const nodet node = new_node();
+  return_nodes.emplace(function_id, node);
+  return node;
+}
+
+std::size_t andersen_points_tot::object(nodet node)
+{
+  auto entry = node_objects.find(node);
+  if(entry != node_objects.end())
+    return entry->second;
+
+  const std::size_t object = object_nodes.size();
+  object_nodes.push_back(node);
+  object_functions.emplace_back();
+  node_objects.emplace(node, object);
+  ++stats.objects;
+  return object;
+}
+
+std::size_t andersen_points_tot::function_object(const irep_idt &function_id)
+{
+  const std::size_t result = object(variable_node(function_id));
+  object_functions[result] = function_id;
+  return result;
+}
+
+void andersen_points_tot::enqueue(nodet node)
+{
+  if(!queued[node])
+  {
+    queued[node] = true;
+    worklist.push_back(node);
+  }
+}
+
+void andersen_points_tot::add_object(nodet node, std::size_t object)
+{
+  node = find(node);
+  if(nodes[node].points_to.insert(object))
+  {
+    nodes[node].delta.insert(object);
+    enqueue(node);
+  }
+}
+
+void andersen_points_tot::add_edge(nodet from, nodet to)
+{
+  from = find(from);
+  to = find(to);
+  if(from == to || !nodes[from].successors.insert(to).second)
+    return;
+
+  ++stats.edges;
+  if(nodes[to].points_to.insert(nodes[from].points_to, nodes[to].delta))
+    enqueue(to);
+}
+
+void andersen_points_tot::assign_address(nodet node, const exprt &object)
+{
+  if(object.id() == ID_symbol)
+  {
+    const irep_idt &identifier = to_symbol_expr(object).get_identifier();
+    if(object.type().id() == ID_code)
+      add_object(node, function_object(identifier));
+    else
+      add_object(node, this->object(variable_node(identifier)));
+  }
+  else if(object.id() == ID_member)
+    assign_address(node, to_member_expr(object).compound());
+  else if(object.id() == ID_index)
+    assign_address(node, to_index_expr(object).array());
+  else if(object.id() == ID_dereference)
+    assign_value(node, to_dereference_expr(object).pointer());
+  else if(object.id() == ID_if)
+  {
+    assign_address(node, to_if_expr(object).true_case());
+    assign_address(node, to_if_expr(object).false_case());
+  }
+  else if(object.id() == ID_typecast)
+    assign_address(node, to_typecast_expr(object).op());
+  else if(
+    object.id() == ID_byte_extract_little_endian ||
+    object.id() == ID_byte_extract_big_endian)
+  {
+    assign_address(node, to_byte_extract_expr(object).op());
+  }
+}
+
+void andersen_points_tot::assign_value(nodet node, const exprt &expr)
+{
+  if(expr.type().id() == ID_bool || expr.type().id() == ID_c_bool)
+    return;
+
+  if(expr.id() == ID_symbol)
+  {
+    const irep_idt &identifier = to_symbol_expr(expr).get_identifier();
+    if(expr.type().id() == ID_code)
+      add_object(node, function_object(identifier));
+    else
+      add_edge(variable_node(identifier), node);
+  }
+  else if(expr.id() == ID_address_of)
+    assign_address(node, to_address_of_expr(expr).object());
+  else if(expr.id() == ID_dereference)
+  {
+    const nodet pointer = value_node(to_dereference_expr(expr).pointer());
+    nodes[find(pointer)].loads.push_back(node);
+  }
+  else if(expr.id() == ID_member)
+    assign_value(node, to_member_expr(expr).compound());
+  else if(expr.id() == ID_index)
+    assign_value(node, to_index_expr(expr).array());
+  else if(expr.id() == ID_if)
+  {
+    assign_value(node, to_if_expr(expr).true_case());
+    assign_value(node, to_if_expr(expr).false_case());
+  }
+  else if(expr.id() == ID_side_effect)
+  {
+    const irep_idt &statement = to_side_effect_expr(expr).get_statement();
+    if(
+      statement == ID_allocate || statement == ID_cpp_new ||
+      statement == ID_cpp_new_array || statement == ID_java_new ||
+      statement == ID_java_new_array_data)
+    {
+      add_object(node, object(new_node()));
+    }
+    else if(statement == ID_nondet)
+    {
+      if(may_hold_pointer(expr.type()))
+        add_object(node, unknown_object);
+    }
+    else
+    {
+      for(const auto &op : expr.operands())
+        assign_value(node, op);
+    }
+  }
+  else if(expr.is_constant())
+  {
+    // integer addresses other than null cannot be tracked
+    if(expr.type().id() == ID_pointer && !is_null_pointer(to_constant_expr(expr)))
+      add_object(node, unknown_object);
+  }
+  else
+  {
+    for(const auto &op : expr.operands())
+      assign_value(node, op);
+  }
+}
+
+andersen_points_tot::nodet andersen_points_tot::value_node(const exprt &expr)
+{
+  if(expr.id() == ID_symbol && expr.type().id() != ID_code)
+    return variable_node(to_symbol_expr(expr).get_identifier());
+
+  const nodet node = new_node();
+  assign_value(node, expr);
+  return node;
+}
+
+void andersen_points_tot::assign(const exprt &lhs, nodet node)
+{
+  if(lhs.id() == ID_symbol)
+    add_edge(node, variable_node(to_symbol_expr(lhs).get_identifier()));
+  else if(lhs.id() == ID_member)
+    assign(to_member_expr(lhs).compound(), node);
+  else if(lhs.id() == ID_index)
+    assign(to_index_expr(lhs).array(), node);
+  else if(lhs.id() == ID_dereference)
+  {
+    const nodet pointer = value_node(to_dereference_expr(lhs).pointer());
+    nodes[find(pointer)].stores.push_back(node);
+  }
+  else if(lhs.id() == ID_if)
+  {
+    assign(to_if_expr(lhs).true_case(), node);
+    assign(to_if_expr(lhs).false_case(), node);
+  }
+  else if(lhs.id() == ID_typecast)
+    assign(to_typecast_expr(lhs).op(), node);
+  else if(
+    lhs.id() == ID_byte_extract_little_endian ||
+    lhs.id() == ID_byte_extract_big_endian)
+  {
+    assign(to_byte_extract_expr(lhs).op(), node);
+  }
+}
+
+void andersen_points_tot::generate_call(goto_programt::const_targett call)
+{
+  const exprt &function = call->call_function();
+  const exprt &lhs = call->call_lhs();
+  const exprt::operandst &arguments = call->call_arguments();
+
+  if(function.id() == ID_symbol)
+  {
+    const irep_idt &callee = to_symbol_expr(function).get_identifier();
+    auto entry = functions.find(callee);
+    if(entry != functions.end() && entry->second.has_body)
+    {
+      const auto &parameters = entry->second.parameters;
+      for(std::size_t i = 0; i < arguments.size() && i < parameters.size(); ++i)
+        add_edge(value_node(arguments[i]), variable_node(parameters[i]));
+
+      if(lhs.is_not_nil())
+        assign(lhs, return_node(callee));
+    }
+    else if(lhs.is_not_nil() && may_hold_pointer(lhs.type()))
+    {
+      const nodet result = new_node();
+      add_object(result, unknown_object);
+      assign(lhs, result);
+    }
+  }
+  else if(function.id() == ID_dereference)
+  {
+    const nodet pointer = value_node(to_dereference_expr(function).pointer());
+
+    callt indirect_call;
+    for(const auto &argument : arguments)
+      indirect_call.arguments.push_back(value_node(argument));
+    indirect_call.result = new_node();
+    if(lhs.is_not_nil())
+      assign(lhs, indirect_call.result);
+
+    nodes[find(pointer)].calls.push_back(calls.size());
+    calls.push_back(std::move(indirect_call));
+    call_sites.emplace(&*call, pointer);
+  }
+}
+
+void andersen_points_tot::resolve_call(
+  std::size_t call,
+  const irep_idt &function_id)
+{
+  if(!calls[call].resolved.insert(function_id).second)
+    return;
+
+  auto entry = functions.find(function_id);
+  if(entry == functions.end() || !entry->second.has_body)
+  {
+    add_object(calls[call].result, unknown_object);
+    return;
+  }
+
+  const auto &parameters = entry->second.parameters;
+  const auto &arguments = calls[call].arguments;
+  for(std::size_t i = 0; i < arguments.size() && i < parameters.size(); ++i)
+    add_edge(arguments[i], variable_node(parameters[i]));
+
+  add_edge(return_node(function_id), calls[call].result);
+}
+
+void andersen_points_tot::generate_constraints(
+  const irep_idt &function_id,
+  const goto_programt &goto_program)
+{
+  forall_goto_program_instructions(it, goto_program)
+  {
+    if(it->is_assign())
+      assign(it->assign_lhs(), value_node(it->assign_rhs()));
+    else if(it->is_set_return_value())
+      add_edge(value_node(it->return_value()), return_node(function_id));
+    else if(it->is_function_call())
+      generate_call(it);
+    else if(it->is_other())
+      generate_other(it->get_other());
+  }
+}
+
+void andersen_points_tot::generate_other(const codet &code)
+{
+  const irep_idt &statement = code.get_statement();
+
+  if(
+    (statement == ID_array_copy || statement == ID_array_replace) &&
+    code.operands().size() == 2)
+  {
+    // *dest = *src
+    const nodet value = new_node();
+    nodes[find(value_node(code.op1()))].loads.push_back(value);
+    nodes[find(value_node(code.op0()))].stores.push_back(value);
+  }
+  else if(statement == ID_array_set && code.operands().size() == 2)
+  {
+    // *dest = value
+    const nodet value = value_node(code.op1());
+    nodes[find(value_node(code.op0()))].stores.push_back(value);
+  }
+  else if(statement == ID_havoc_object && code.operands().size() == 1)
+  {
+    const nodet value = new_node();
+    add_object(value, unknown_object);
+    nodes[find(value_node(code.op0()))].stores.push_back(value);
+  }
+}
+
+void andersen_points_tot::merge_nodes(nodet into, nodet from)
+{
+  parent[from] = into;
+  ++stats.collapsed_nodes;
+
+  node_datat &target = nodes[into];
+  node_datat &source = nodes[from];
+
+  points_to_sett ignored;
+  target.points_to.insert(source.points_to, ignored);
+  target.successors.insert(source.successors.begin(), source.successors.end());
+  target.successors.erase(from);
+  target.successors.erase(into);
+  target.loads.insert(
+    target.loads.end(), source.loads.begin(), source.loads.end());
+  target.stores.insert(
+    target.stores.end(), source.stores.begin(), source.stores.end());
+  target.calls.insert(
+    target.calls.end(), source.calls.begin(), source.calls.end());
+
+  source = node_datat{};
+
+  // Edges, loads and stores of either node may not have seen all objects
+  // of the other one
+  target.delta = target.points_to;
+}
+
+void andersen_points_tot::collapse_cycle(nodet start)
+{
+  // Tarjan's algorithm, iteratively, on the graph of representatives
+  struct framet
+  {
+    nodet node;
+    std::vector<nodet> successors;
+    std::size_t next;
+  };
+
+  std::unordered_map<nodet, std::size_t> index;
+  std::unordered_map<nodet, std::size_t> lowlink;
+  std::vector<nodet> stack;
+  std::unordered_set<nodet> on_stack;
+  std::vector<framet> frames;
+  std::vector<std::vector<nodet>> components;
+
+  auto visit = [&](nodet node) {
+    const std::size_t number = index.size();
+    index[node] = number;
+    lowlink[node] = number;
+    stack.push_back(node);
+    on_stack.insert(node);
+
+    framet frame{node, {}, 0};
+    for(const nodet successor : nodes[node].successors)
+    {
+      const nodet representative = find(successor);
+      if(representative != node)
+        frame.successors.push_back(representative);
+    }
+    frames.push_back(std::move(frame));
+  };
+
+  visit(find(start));
+
+  while(!frames.empty())
+  {
+    framet &frame = frames.back();
+    if(frame.next < frame.successors.size())
+    {
+      const nodet node = frame.node;
+      const nodet successor = frame.successors[frame.next++];
+      if(index.find(successor) == index.end())
+        visit(successor);
+      else if(on_stack.count(successor) != 0)
+        lowlink[node] = std::min(lowlink[node], index[successor]);
+      continue;
+    }
+
+    const nodet node = frame.node;
+    frames.pop_back();
+    if(!frames.empty())
+    {
+      const nodet caller = frames.back().node;
+      lowlink[caller] = std::min(lowlink[caller], lowlink[node]);
+    }
+
+    if(lowlink[node] != index[node])
+      continue;
+
+    std::vector<nodet> component;
+    nodet member;
+    do
+    {
+      member = stack.back();
+      stack.pop_back();
+      on_stack.erase(member);
+      component.push_back(member);
+    } while(member != node);
+
+    if(component.size() > 1)
+      components.push_back(std::move(component));
+  }
+
+  for(const auto &component : components)
+  {
+    const nodet representative = component.back();
+    for(const nodet member : component)
+    {
+      if(member != representative)
+        merge_nodes(representative, member);
+    }
+    enqueue(representative);
+  }
+}
+
+void andersen_points_tot::solve()
+{
+  while(!worklist.empty())
+  {
+    const nodet queued_node = worklist.front();
+    worklist.pop_front();
+    queued[queued_node] = false;
+
+    const nodet node = find(queued_node);
+    if(nodes[node].delta.empty())
+      continue;
+
+    ++stats.iterations;
+
+    points_to_sett delta;
+    std::swap(delta, nodes[node].delta);
+
+    for(const std::size_t object : delta.elements())
+    {
+      const nodet object_node = object_nodes[object];
+
+      for(std::size_t i = 0; i < nodes[node].loads.size(); ++i)
+        add_edge(object_node, nodes[node].loads[i]);
+
+      for(std::size_t i = 0; i < nodes[node].stores.size(); ++i)
+        add_edge(nodes[node].stores[i], object_node);
+
+      if(!object_functions[object].empty())
+      {
+        for(std::size_t i = 0; i < nodes[node].calls.size(); ++i)
+          resolve_call(nodes[node].calls[i], object_functions[object]);
+      }
+    }
+
+    // A successor that already has all objects may be on a cycle with this
+    // node
+    bool look_for_cycle = false;
+    for(const nodet successor : nodes[node].successors)
+    {
+      const nodet representative = find(successor);
+      if(representative == node)
+        continue;
+
+      node_datat &target = nodes[representative];
+      if(target.points_to.insert(delta, target.delta))
+        enqueue(representative);
+      else if(
+        target.points_to == nodes[node].points_to &&
+        cycle_checked.emplace(node, representative).second)
+      {
+        look_for_cycle = true;
+      }
+    }
+
+    if(look_for_cycle)
+      collapse_cycle(node);
+  }
+}
+
+void andersen_points_tot::operator()(const goto_functionst &goto_functions)
+{
+  // Anything loaded from an unknown object is unknown
+  const nodet unknown_node = new_node();
+  unknown_object = object(unknown_node);
+  add_object(unknown_node, unknown_object);
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    functions.emplace(
+      gf_entry.first,
+      functiont{gf_entry.second.parameter_identifiers,
+                gf_entry.second.body_available()});
+  }
+
+  for(const auto &symbol_entry : ns.get_symbol_table().symbols)
+  {
+    const symbolt &symbol = symbol_entry.second;
+    if(
+      symbol.is_static_lifetime && symbol.type.id() != ID_code &&
+      symbol.value.is_not_nil())
+    {
+      assign(symbol.symbol_expr(), value_node(symbol.value));
+    }
+  }
+
+  for(const auto &gf_entry : goto_functions.function_map)
+    generate_constraints(gf_entry.first, gf_entry.second.body);
+
+  solve();
+}
+
+optionalt<std::set<irep_idt>>
+andersen_points_tot::called_functions(goto_programt::const_targett call) const
+{
+  auto entry = call_sites.find(&*call);
+  if(entry == call_sites.end())
+    return {};
+
+  nodet node = entry->second;
+  while(parent[node] != node)
+    node = parent[node];
+
+  std::set<irep_idt> result;
+  for(const std::size_t object : nodes[node].points_to.elements())
+  {
+    if(object_functions[object].empty())
+      return {};
+    result.insert(object_functions[object]);
+  }
+
+  return result;
+}
@@ -0,0 +1,214 @@
+/*******************************************************************\
+
+Module: Inclusion-Based Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Whole-program, flow- and context-insensitive inclusion-based (Andersen
+/// style) points-to analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
+#define CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
+
+#include <util/optional.h>
+
+#include <goto-programs/goto_program.h>
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class goto_functionst;
+
+/// A set of small natural numbers, stored as a sorted sequence of the
+/// non-zero 64-bit words of a bit-vector. This keeps sparse sets small and
+/// makes unions and comparisons linear in the number of words.
+class points_to_sett
+{
+public:
+  /// \return True if \p element was not in the set
+  bool insert(std::size_t element);
+
+  bool contains(std::size_t element) const;
+
+  /// Insert all elements of \p other and add those that were new to
+  /// \p added
+  /// \return True if any element was new
+  bool insert(const points_to_sett &other, points_to_sett &added);
+
+  bool empty() const
+  {
+    return words.empty();
+  }
+
+  void clear()
+  {
+    words.clear();
+  }
+
+  std::size_t size() const;
+
+  /// The elements in ascending order
+  std::vector<std::size_t> elements() const;
+
+  bool operator==(const points_to_sett &other) const
+  {
+    return words == other.words;
+  }
+
+protected:
+  /// Pairs of word index and non-zero word, ordered by index
+  std::vector<std::pair<std::size_t, std::uint64_t>> words;
+};
+
+/// Inclusion-based points-to analysis of a whole program. Each variable,
+/// each allocation site and each function is an abstract object; struct
+/// members and array elements are not distinguished from the object that
+/// contains them. Assignments generate constraints between the points-to
+/// sets of nodes, which the solver propagates to a fixed point:
+///
+///  - `p = &x` puts x into the set of p,
+///  - `p = q` makes the set of p include the set of q,
+///  - `p = *q` and `*p = q` add such inclusion edges for each object in the
+///    set of q and p, respectively, as the objects are found,
+///  - a call through a pointer binds arguments and return value of each
+///    function found in the set of the pointer,
+///  - `array_copy(p, q)` and `array_replace(p, q)`, which implement memcpy
+///    and memmove, are treated as `*p = *q`, and `array_set(p, v)` as
+///    `*p = v`; `havoc_object(p)` stores the unknown object through p.
+///
+/// Only the objects newly added to a set are propagated along its edges
+/// (difference propagation). When propagating along an edge does not change
+/// the set at its end, the analysis looks for a cycle through the edge and
+/// collapses all nodes on it into one (lazy cycle detection).
+///
+/// Values that the analysis cannot track, such as non-deterministic pointers
+/// or those returned by functions without body, point to an unknown object.
+class andersen_points_tot
+{
+public:
+  explicit andersen_points_tot(const namespacet &_ns) : ns(_ns)
+  {
+  }
+
+  /// Generate and solve the constraints of all functions in
+  /// \p goto_functions and of the initial values of all variables with
+  /// static lifetime
+  void operator()(const goto_functionst &goto_functions);
+
+  /// The functions that the pointer called by the function call \p call may
+  /// point to
+  /// \return An empty optional if the pointer may point to an object other
+  ///   than a function, or to an unknown object
+  optionalt<std::set<irep_idt>>
+  called_functions(goto_programt::const_targett call) const;
+
+  struct statisticst
+  {
+    std::size_t nodes = 0;
+    std::size_t objects = 0;
+    std::size_t edges = 0;
+    /// Nodes that were merged into another node on the same cycle
+    std::size_t collapsed_nodes = 0;
+    /// Nodes taken from the worklist
+    std::size_t iterations = 0;
+  };
+
+  const statisticst &statistics() const
+  {
+    return stats;
+  }
+
+protected:
+  const namespacet &ns;
+  statisticst stats;
+
+  typedef std::size_t nodet;
+
+  struct node_datat
+  {
+    points_to_sett points_to;
+    /// Objects in points_to not yet propagated
+    points_to_sett delta;
+    std::set<nodet> successors;
+    /// Nodes whose set includes the sets of all objects in this set
+    std::vector<nodet> loads;
+    /// Nodes whose sets are included in the sets of all objects in this set
+    std::vector<nodet> stores;
+    /// Calls through this node, as indices into \ref calls
+    std::vector<std::size_t> calls;
+  };
+
+  std::vector<node_datat> nodes;
+  /// The representative of each node, for nodes merged by cycle collapsing
+  std::vector<nodet> parent;
+  std::unordered_map<irep_idt, nodet> variable_nodes;
+  std::unordered_map<irep_idt, nodet> return_nodes;
+
+  /// The node holding the contents of each object
+  std::vector<nodet> object_nodes;
+  /// The function each object stands for, or the empty string
+  std::vector<irep_idt> object_functions;
+  std::unordered_map<nodet, std::size_t> node_objects;
+  std::size_t unknown_object = 0;
+
+  struct functiont
+  {
+    std::vector<irep_idt> parameters;
+    bool has_body;
+  };
+  std::unordered_map<irep_idt, functiont> functions;
+
+  struct callt
+  {
+    std::vector<nodet> arguments;
+    /// The node receiving the return value
+    nodet result;
+    std::set<irep_idt> resolved;
+  };
+  std::vector<callt> calls;
+  std::unordered_map<const goto_programt::instructiont *, nodet> call_sites;
+
+  std::deque<nodet> worklist;
+  std::vector<bool> queued;
+  std::set<std::pair<nodet, nodet>> cycle_checked;
+
+  nodet new_node();
+  nodet find(nodet node);
+  nodet variable_node(const irep_idt &identifier);
+  nodet return_node(const irep_idt &function_id);
+  std::size_t object(nodet node);
+  std::size_t function_object(const irep_idt &function_id);
+
+  void add_object(nodet node, std::size_t object);
+  void add_edge(nodet from, nodet to);
+  void enqueue(nodet node);
+
+  /// Make the set of \p node include the values \p expr may evaluate to
+  void assign_value(nodet node, const exprt &expr);
+  void assign_address(nodet node, const exprt &object);
+
+  /// A node whose set includes the values \p expr may evaluate to
+  nodet value_node(const exprt &expr);
+
+  /// Make the values of \p lhs include the set of \p node
+  void assign(const exprt &lhs, nodet node);
+
+  void generate_constraints(
+    const irep_idt &function_id,
+    const goto_programt &goto_program);
+  void generate_call(goto_programt::const_targett call);
+  void generate_other(const codet &code);
+  void resolve_call(std::size_t call, const irep_idt &function_id);
+
+  void solve();
+  void collapse_cycle(nodet start);
+  void merge_nodes(nodet into, nodet from);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
@@ -129,11 +129,10 @@ bool value_sett::insert(
   if(insert_action == insert_actiont::NONE)
     return false;
 
-  auto &new_offset = dest.write()[n];
   if(insert_action == insert_actiont::INSERT)
-    new_offset = offset;
+    dest.write().insert_or_assign(n, offset);
   else
-    new_offset.reset();
+    dest.write().insert_or_assign(n, offsett());
 
   return true;
 }
@@ -273,33 +272,28 @@ bool value_sett::make_union_would_change(
   const object_mapt &dest,
   const object_mapt &src) const
 {
-  for(const auto &number_and_offset : src.read())
-  {
-    if(
-      get_insert_action(
-        dest, number_and_offset.first, number_and_offset.second) !=
-      insert_actiont::NONE)
-    {
-      return true;
-    }
-  }
+  if(dest.get_d() == src.get_d())
+    return false;
 
-  return false;
+  return dest.read().merge_would_change(src.read());
 }
 
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  if(dest.get_d() == src.get_d() || src.read().empty())
+    return false;
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  // share the object map rather than copying it
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    dest = src;
+    return true;
   }
 
-  return result;
+  if(!dest.read().merge_would_change(src.read()))
+    return false;
+
+  return dest.write().merge(src.read());
 }
 
 bool value_sett::eval_pointer_offset(
@@ -1703,12 +1697,27 @@ void value_sett::apply_code_rec(
   }
   else if(statement==ID_array_set)
   {
+    // *dest = value, which may only update part of the object
+    DATA_INVARIANT(
+      code.operands().size() == 2,
+      "array_set statement expected to have two operands");
+    assign(dereference_exprt{code.op0()}, code.op1(), ns, false, true);
   }
-  else if(statement==ID_array_copy)
-  {
-  }
-  else if(statement==ID_array_replace)
+  else if(statement==ID_array_copy ||
+          statement==ID_array_replace)
   {
+    // *dest = *src; the operands may point to objects of any type (memcpy
+    // and memmove are implemented this way), hence all values of the source
+    // object are added to the destination object
+    DATA_INVARIANT(
+      code.operands().size() == 2,
+      "array_copy/array_replace statement expected to have two operands");
+    assign(
+      dereference_exprt{code.op0()},
+      dereference_exprt{code.op1()},
+      ns,
+      false,
+      true);
   }
   else if(statement == ID_array_equal)
   {
@@ -1736,6 +1745,11 @@ void value_sett::apply_code_rec(
   }
   else if(statement == ID_havoc_object)
   {
+    DATA_INVARIANT(
+      code.operands().size() == 1,
+      "havoc_object statement expected to have one operand");
+    const dereference_exprt object{code.op0()};
+    assign(object, exprt{ID_unknown, object.type()}, ns, false, true);
   }
   else
   {
@@ -1789,7 +1803,7 @@ void value_sett::erase_values_from_entry(
 
   std::vector<object_map_dt::key_type> keys_to_erase;
 
-  for(auto &key_value : entry->object_map.read())
+  for(const auto &key_value : entry->object_map.read())
   {
     const auto &rhs_object = to_expr(key_value);
     if(values_to_erase.count(rhs_object))
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/sharing_map.h>
 
 #include "object_numbering.h"
+#include "value_set_object_map.h"
 #include "value_sets.h"
 
 class namespacet;
@@ -84,7 +85,7 @@ class value_sett
   /// the enclosing `value_sett`, such as `{ null, dynamic_object1 }`.
   /// The set is represented as a map from numbered `exprt`s to `offsett`
   /// instead of a set of pairs to make lookup by `exprt` easier.
-  using object_map_dt = std::map<object_numberingt::number_type, offsett>;
+  using object_map_dt = value_set_object_mapt;
 
   static const object_map_dt empty_object_map;
 
@@ -115,7 +116,7 @@ class value_sett
   /// \param it: iterator pointing to new element
   void set(object_mapt &dest, const object_map_dt::value_type &it) const
   {
-    dest.write()[it.first]=it.second;
+    dest.write().insert_or_assign(it.first, it.second);
   }
 
   /// Merges an existing element into an object map. If the destination map
@@ -0,0 +1,252 @@
+/*******************************************************************\
+
+Module: Value Set Object Map
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Compact map from object numbers to offsets used by value_sett
+
+#include "value_set_object_map.h"
+
+#include <util/invariant.h>
+
+#include <algorithm>
+
+value_set_object_mapt::const_iterator
+value_set_object_mapt::find(key_type key) const
+{
+  const auto it = lower_bound(key);
+  if(it == entries.end() || it->key != key)
+    return end();
+  return {this, it};
+}
+
+void value_set_object_mapt::insert_or_assign(
+  key_type key,
+  const mapped_type &offset)
+{
+  auto it = lower_bound(key);
+  if(it == entries.end() || it->key != key)
+    it = entries.insert(it, entryt{key, 0, offset_kindt::UNKNOWN});
+  set_offset(*it, offset);
+}
+
+void value_set_object_mapt::insert(const_iterator first, const_iterator last)
+{
+  for(; first != last; ++first)
+  {
+    const value_type value = *first;
+    auto it = lower_bound(value.first);
+    if(it == entries.end() || it->key != value.first)
+    {
+      it = entries.insert(it, entryt{value.first, 0, offset_kindt::UNKNOWN});
+      set_offset(*it, value.second);
+    }
+  }
+}
+
+std::size_t value_set_object_mapt::erase(key_type key)
+{
+  const auto it = lower_bound(key);
+  if(it == entries.end() || it->key != key)
+    return 0;
+  entries.erase(it);
+  return 1;
+}
+
+bool value_set_object_mapt::merge(const value_set_object_mapt &other)
+{
+  if(other.entries.empty())
+    return false;
+
+  if(entries.empty())
+  {
+    *this = other;
+    return true;
+  }
+
+  // Most merges either change nothing or only reset offsets, which can be
+  // done in place. Only build a new vector when keys need to be inserted.
+  bool changed = false;
+  bool has_new_keys = false;
+  auto it = entries.begin();
+  for(const entryt &other_entry : other.entries)
+  {
+    while(it != entries.end() && it->key < other_entry.key)
+      ++it;
+
+    if(it == entries.end() || it->key != other_entry.key)
+      has_new_keys = true;
+    else if(
+      it->kind != offset_kindt::UNKNOWN &&
+      (other_entry.kind == offset_kindt::UNKNOWN ||
+       !same_offset(*it, other_entry, other)))
+    {
+      it->kind = offset_kindt::UNKNOWN;
+      changed = true;
+    }
+  }
+
+  if(!has_new_keys)
+    return changed;
+
+  std::vector<entryt> merged;
+  merged.reserve(entries.size() + other.entries.size());
+  auto this_it = entries.begin();
+  for(const entryt &other_entry : other.entries)
+  {
+    while(this_it != entries.end() && this_it->key < other_entry.key)
+      merged.push_back(*this_it++);
+
+    if(this_it != entries.end() && this_it->key == other_entry.key)
+      merged.push_back(*this_it++);
+    else
+    {
+      merged.push_back(other_entry);
+      copy_offset(merged.back(), other_entry, other);
+    }
+  }
+  merged.insert(merged.end(), this_it, entries.end());
+
+  entries = std::move(merged);
+  return true;
+}
+
+bool value_set_object_mapt::merge_would_change(
+  const value_set_object_mapt &other) const
+{
+  auto it = entries.begin();
+  for(const entryt &other_entry : other.entries)
+  {
+    while(it != entries.end() && it->key < other_entry.key)
+      ++it;
+
+    if(it == entries.end() || it->key != other_entry.key)
+      return true;
+
+    if(
+      it->kind != offset_kindt::UNKNOWN &&
+      (other_entry.kind == offset_kindt::UNKNOWN ||
+       !same_offset(*it, other_entry, other)))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool value_set_object_mapt::operator==(const value_set_object_mapt &other) const
+{
+  if(entries.size() != other.entries.size())
+    return false;
+
+  for(std::size_t i = 0; i < entries.size(); ++i)
+  {
+    const entryt &entry = entries[i];
+    const entryt &other_entry = other.entries[i];
+    if(entry.key != other_entry.key || entry.kind != other_entry.kind)
+      return false;
+    if(
+      entry.kind != offset_kindt::UNKNOWN &&
+      !same_offset(entry, other_entry, other))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+value_set_object_mapt::mapped_type
+value_set_object_mapt::offset(const entryt &entry) const
+{
+  switch(entry.kind)
+  {
+  case offset_kindt::UNKNOWN:
+    return {};
+  case offset_kindt::SMALL:
+    return mp_integer{static_cast<long long>(entry.offset)};
+  case offset_kindt::LARGE:
+    return large_offsets[static_cast<std::size_t>(entry.offset)];
+  }
+
+  UNREACHABLE;
+}
+
+void value_set_object_mapt::set_offset(entryt &entry, const mapped_type &offset)
+{
+  if(!offset.has_value())
+    entry.kind = offset_kindt::UNKNOWN;
+  else if(offset->is_long())
+  {
+    entry.kind = offset_kindt::SMALL;
+    entry.offset = static_cast<std::int64_t>(offset->to_long());
+  }
+  else
+  {
+    entry.kind = offset_kindt::LARGE;
+    entry.offset = static_cast<std::int64_t>(large_offsets.size());
+    large_offsets.push_back(*offset);
+  }
+}
+
+void value_set_object_mapt::copy_offset(
+  entryt &entry,
+  const entryt &other,
+  const value_set_object_mapt &other_map)
+{
+  entry.kind = other.kind;
+  entry.offset = other.offset;
+  if(other.kind == offset_kindt::LARGE)
+  {
+    entry.offset = static_cast<std::int64_t>(large_offsets.size());
+    large_offsets.push_back(
+      other_map.large_offsets[static_cast<std::size_t>(other.offset)]);
+  }
+}
+
+bool value_set_object_mapt::same_offset(
+  const entryt &entry,
+  const entryt &other,
+  const value_set_object_mapt &other_map) const
+{
+  // Offsets are only stored as LARGE when they do not fit into SMALL, so
+  // offsets of different kinds always differ.
+  if(entry.kind != other.kind)
+    return false;
+
+  switch(entry.kind)
+  {
+  case offset_kindt::UNKNOWN:
+    return true;
+  case offset_kindt::SMALL:
+    return entry.offset == other.offset;
+  case offset_kindt::LARGE:
+    return large_offsets[static_cast<std::size_t>(entry.offset)] ==
+           other_map.large_offsets[static_cast<std::size_t>(other.offset)];
+  }
+
+  UNREACHABLE;
+}
+
+std::vector<value_set_object_mapt::entryt>::iterator
+value_set_object_mapt::lower_bound(key_type key)
+{
+  return std::lower_bound(
+    entries.begin(), entries.end(), key, [](const entryt &entry, key_type k) {
+      return entry.key < k;
+    });
+}
+
+std::vector<value_set_object_mapt::entryt>::const_iterator
+value_set_object_mapt::lower_bound(key_type key) const
+{
+  return std::lower_bound(
+    entries.begin(), entries.end(), key, [](const entryt &entry, key_type k) {
+      return entry.key < k;
+    });
+}
@@ -0,0 +1,219 @@
+/*******************************************************************\
+
+Module: Value Set Object Map
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Compact map from object numbers to offsets used by value_sett
+
+#ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_OBJECT_MAP_H
+#define CPROVER_POINTER_ANALYSIS_VALUE_SET_OBJECT_MAP_H
+
+#include <util/mp_arith.h>
+#include <util/optional.h>
+
+#include "object_numbering.h"
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/// A map from object numbers to optional offsets, stored as a vector of
+/// entries ordered by object number. Offsets that fit into 64 bits are kept
+/// in the entry itself, larger ones in a separate vector of `mp_integer`.
+///
+/// Most value sets hold just a handful of objects; compared to a `std::map`
+/// this avoids one allocation per entry and one `mp_integer` allocation per
+/// known offset. Lookups use binary search and the union of two maps is a
+/// single merge of the two sorted vectors.
+///
+/// The interface follows that of `std::map` where possible. Iterators yield
+/// `value_type` pairs by value, so entries can only be modified through
+/// \ref insert_or_assign, \ref erase and \ref merge.
+class value_set_object_mapt
+{
+public:
+  typedef object_numberingt::number_type key_type;
+  typedef optionalt<mp_integer> mapped_type;
+  typedef std::pair<key_type, mapped_type> value_type;
+
+protected:
+  enum class offset_kindt : std::uint8_t
+  {
+    UNKNOWN,
+    /// The offset is stored in \ref entryt::offset
+    SMALL,
+    /// The offset is stored in \ref large_offsets at index
+    /// \ref entryt::offset
+    LARGE
+  };
+
+  struct entryt
+  {
+    key_type key;
+    std::int64_t offset;
+    offset_kindt kind;
+  };
+
+public:
+  class const_iteratort
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef value_set_object_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type reference;
+
+    /// Gives access to the members of the value pointed to by an iterator
+    /// that does not hold the value itself
+    class pointer
+    {
+    public:
+      explicit pointer(value_type _value) : value(std::move(_value))
+      {
+      }
+
+      const value_type *operator->() const
+      {
+        return &value;
+      }
+
+    private:
+      value_type value;
+    };
+
+    const_iteratort() = default;
+
+    const_iteratort(
+      const value_set_object_mapt *_map,
+      std::vector<entryt>::const_iterator _it)
+      : map(_map), it(_it)
+    {
+    }
+
+    reference operator*() const
+    {
+      return {it->key, map->offset(*it)};
+    }
+
+    pointer operator->() const
+    {
+      return pointer{**this};
+    }
+
+    const_iteratort &operator++()
+    {
+      ++it;
+      return *this;
+    }
+
+    const_iteratort operator++(int)
+    {
+      const_iteratort tmp = *this;
+      ++it;
+      return tmp;
+    }
+
+    bool operator==(const const_iteratort &other) const
+    {
+      return it == other.it;
+    }
+
+    bool operator!=(const const_iteratort &other) const
+    {
+      return it != other.it;
+    }
+
+  private:
+    const value_set_object_mapt *map = nullptr;
+    std::vector<entryt>::const_iterator it;
+  };
+
+  typedef const_iteratort const_iterator;
+  typedef const_iteratort iterator;
+
+  const_iterator begin() const
+  {
+    return {this, entries.begin()};
+  }
+
+  const_iterator end() const
+  {
+    return {this, entries.end()};
+  }
+
+  bool empty() const
+  {
+    return entries.empty();
+  }
+
+  std::size_t size() const
+  {
+    return entries.size();
+  }
+
+  const_iterator find(key_type key) const;
+
+  /// Set the offset of \p key to \p offset, inserting \p key if not present
+  void insert_or_assign(key_type key, const mapped_type &offset);
+
+  /// Insert the elements in the range [\p first, \p last) whose keys are
+  /// not present yet
+  void insert(const_iterator first, const_iterator last);
+
+  /// \return The number of elements removed
+  std::size_t erase(key_type key);
+
+  void clear()
+  {
+    entries.clear();
+    large_offsets.clear();
+  }
+
+  /// Insert the elements of \p other the way `value_sett::insert` does:
+  /// keys not present are inserted with their offset and keys present with
+  /// a differing offset get an unknown offset.
+  /// \return True if this map changed
+  bool merge(const value_set_object_mapt &other);
+
+  /// \return True if \ref merge with \p other would change this map
+  bool merge_would_change(const value_set_object_mapt &other) const;
+
+  bool operator==(const value_set_object_mapt &other) const;
+
+  bool operator!=(const value_set_object_mapt &other) const
+  {
+    return !(*this == other);
+  }
+
+protected:
+  std::vector<entryt> entries;
+  /// Offsets that do not fit into an `std::int64_t`. Entries that are
+  /// overwritten or erased leave their offset behind until the next
+  /// \ref clear.
+  std::vector<mp_integer> large_offsets;
+
+  mapped_type offset(const entryt &entry) const;
+
+  /// Store \p offset in \p entry
+  void set_offset(entryt &entry, const mapped_type &offset);
+
+  /// Store the offset of \p other, taken from \p other_map, in \p entry
+  void copy_offset(
+    entryt &entry,
+    const entryt &other,
+    const value_set_object_mapt &other_map);
+
+  bool same_offset(
+    const entryt &entry,
+    const entryt &other,
+    const value_set_object_mapt &other_map) const;
+
+  std::vector<entryt>::iterator lower_bound(key_type key);
+  std::vector<entryt>::const_iterator lower_bound(key_type key) const;
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_VALUE_SET_OBJECT_MAP_H
@@ -0,0 +1,250 @@
+/*******************************************************************\
+
+Module: Flow-Insensitive Value Set Oracle
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// A single, flow-insensitive value set for a whole program that answers
+/// points-to queries on demand
+
+#include "value_set_oracle.h"
+
+#include <util/expr_iterator.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol.h>
+
+void value_set_oraclet::add_function(
+  const irep_idt &function_id,
+  const goto_programt &body)
+{
+  functions[function_id] = &body;
+}
+
+void value_set_oraclet::solve()
+{
+  // All assignments add to the existing values, hence a pass that does not
+  // add anything has reached the fixed point.
+  bool changed = true;
+  while(changed)
+  {
+    ++passes;
+    value_sett before{value_set};
+
+    for(const auto &function : functions)
+      apply(function.first, *function.second);
+
+    changed = before.make_union(value_set);
+  }
+}
+
+void value_set_oraclet::add_dynamic_object(
+  const symbol_exprt &object,
+  unsigned allocation_site)
+{
+  if(allocation_sites.emplace(object.get_identifier(), allocation_site).second)
+    dynamic_objects[allocation_site].push_back(object);
+}
+
+std::vector<exprt> value_set_oraclet::get_value_set(const exprt &expr) const
+{
+  std::vector<exprt> result;
+  bool has_unknown = false;
+  for(const auto &value :
+      value_set.get_value_set(to_allocation_sites(expr), ns))
+  {
+    // Which instance of a function-local object is meant depends on the
+    // call stack, which the analysis does not distinguish
+    if(value.id() == ID_unknown || is_local_object(value))
+    {
+      if(!has_unknown)
+        result.push_back(exprt{ID_unknown, expr.type()});
+      has_unknown = true;
+    }
+    else
+      from_allocation_sites(value, result);
+  }
+  return result;
+}
+
+bool value_set_oraclet::is_local_object(const exprt &value) const
+{
+  if(value.id() != ID_object_descriptor)
+    return false;
+
+  const exprt &object = to_object_descriptor_expr(value).root_object();
+  const symbolt *symbol;
+  if(object.id() != ID_symbol || ns.lookup(to_symbol_expr(object).get_identifier(), symbol))
+    return false;
+
+  return !symbol->is_static_lifetime && symbol->type.id() != ID_code &&
+         !symbol->type.get_bool(ID_C_dynamic);
+}
+
+symbol_exprt value_set_oraclet::return_value(
+  const irep_idt &function_id,
+  const typet &type) const
+{
+  return symbol_exprt{id2string(function_id) + "#return_value", type};
+}
+
+void value_set_oraclet::apply(
+  const irep_idt &function_id,
+  const goto_programt &body)
+{
+  forall_goto_program_instructions(it, body)
+  {
+    value_set.location_number = it->location_number;
+
+    if(it->is_assign())
+      value_set.assign(it->assign_lhs(), it->assign_rhs(), ns, false, true);
+    else if(it->is_set_return_value())
+    {
+      value_set.assign(
+        return_value(function_id, it->return_value().type()),
+        it->return_value(),
+        ns,
+        false,
+        true);
+    }
+    else if(it->is_function_call())
+      apply_call(it);
+    else if(it->is_other())
+      apply_other(it->get_other());
+  }
+}
+
+void value_set_oraclet::apply_other(const codet &code)
+{
+  // The C library implements memcpy, memmove and memset using these
+  const irep_idt &statement = code.get_statement();
+  if(
+    statement == ID_array_copy || statement == ID_array_replace ||
+    statement == ID_array_set || statement == ID_havoc_object)
+  {
+    value_set.apply_code(code, ns);
+  }
+}
+
+void value_set_oraclet::apply_call(goto_programt::const_targett call)
+{
+  const exprt &function = call->call_function();
+  const exprt &lhs = call->call_lhs();
+
+  // Calls through function pointers are expected to have been removed
+  if(function.id() != ID_symbol)
+  {
+    if(lhs.is_not_nil())
+      value_set.assign(lhs, exprt{ID_unknown, lhs.type()}, ns, true, true);
+    return;
+  }
+
+  const irep_idt &callee = to_symbol_expr(function).get_identifier();
+  auto entry = functions.find(callee);
+  if(entry == functions.end() || entry->second->instructions.empty())
+  {
+    if(lhs.is_not_nil())
+      value_set.assign(lhs, exprt{ID_unknown, lhs.type()}, ns, true, true);
+    return;
+  }
+
+  const auto &parameters = to_code_type(function.type()).parameters();
+  const auto &arguments = call->call_arguments();
+  for(std::size_t i = 0; i < parameters.size() && i < arguments.size(); ++i)
+  {
+    const irep_idt &identifier = parameters[i].get_identifier();
+    if(identifier.empty())
+      continue;
+
+    value_set.assign(
+      symbol_exprt{identifier, parameters[i].type()},
+      arguments[i],
+      ns,
+      false,
+      true);
+  }
+
+  if(lhs.is_not_nil())
+  {
+    value_set.assign(lhs, return_value(callee, lhs.type()), ns, true, true);
+  }
+}
+
+exprt value_set_oraclet::to_allocation_sites(exprt expr) const
+{
+  if(allocation_sites.empty())
+    return expr;
+
+  for(auto it = expr.depth_begin(), end = expr.depth_end(); it != end;)
+  {
+    auto entry =
+      it->id() == ID_symbol
+        ? allocation_sites.find(to_symbol_expr(*it).get_identifier())
+        : allocation_sites.end();
+    if(entry == allocation_sites.end())
+    {
+      ++it;
+      continue;
+    }
+
+    dynamic_object_exprt dynamic_object(it->type());
+    dynamic_object.set_instance(entry->second);
+    dynamic_object.valid() = true_exprt{};
+    it.mutate() = std::move(dynamic_object);
+    it.next_sibling_or_parent();
+  }
+
+  return expr;
+}
+
+void value_set_oraclet::from_allocation_sites(
+  const exprt &value,
+  std::vector<exprt> &dest) const
+{
+  if(value.id() != ID_object_descriptor)
+  {
+    dest.push_back(value);
+    return;
+  }
+
+  const exprt &object = to_object_descriptor_expr(value).root_object();
+  if(object.id() != ID_dynamic_object)
+  {
+    dest.push_back(value);
+    return;
+  }
+
+  // Sites at which no object has been registered did not allocate anything
+  // yet
+  auto entry =
+    dynamic_objects.find(to_dynamic_object_expr(object).get_instance());
+  if(entry == dynamic_objects.end())
+    return;
+
+  for(const symbol_exprt &dynamic_object : entry->second)
+  {
+    object_descriptor_exprt descriptor = to_object_descriptor_expr(value);
+    if(descriptor.object().id() == ID_dynamic_object)
+      descriptor.object() = dynamic_object;
+    else
+    {
+      // A member or element of the object
+      for(auto it = descriptor.object().depth_begin(),
+               end = descriptor.object().depth_end();
+          it != end;
+          ++it)
+      {
+        if(it->id() == ID_dynamic_object)
+        {
+          it.mutate() = dynamic_object;
+          break;
+        }
+      }
+    }
+    dest.push_back(std::move(descriptor));
+  }
+}
@@ -0,0 +1,105 @@
+/*******************************************************************\
+
+Module: Flow-Insensitive Value Set Oracle
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// A single, flow-insensitive value set for a whole program that answers
+/// points-to queries on demand
+
+#ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_ORACLE_H
+#define CPROVER_POINTER_ANALYSIS_VALUE_SET_ORACLE_H
+
+#include <util/namespace.h>
+
+#include <goto-programs/goto_program.h>
+
+#include "value_set.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/// One \ref value_sett that over-approximates the values of all pointers at
+/// all program locations. Every assignment, parameter binding and return of
+/// each function added via \ref add_function is applied to it, adding to the
+/// existing values rather than replacing them, until nothing changes. So are
+/// the array_copy, array_replace, array_set and havoc_object statements that
+/// implement memcpy, memmove and memset. Struct members are distinguished the
+/// same way \ref value_sett does.
+///
+/// Objects allocated at run time are represented by one dynamic object per
+/// allocation site. A client that creates concrete objects for allocations,
+/// such as symbolic execution, can register them via
+/// \ref add_dynamic_object; queries may then refer to these objects, and
+/// answers list them instead of the allocation site they were created at.
+class value_set_oraclet
+{
+public:
+  explicit value_set_oraclet(const namespacet &_ns) : ns(_ns)
+  {
+  }
+
+  /// Include the instructions of \p body, the body of function
+  /// \p function_id, in the analysis. \p body has to outlive the next call
+  /// to \ref solve.
+  void add_function(const irep_idt &function_id, const goto_programt &body);
+
+  /// Compute the values of all pointers in the functions added so far
+  void solve();
+
+  /// Record that \p object was allocated by the instruction with location
+  /// number \p allocation_site
+  void
+  add_dynamic_object(const symbol_exprt &object, unsigned allocation_site);
+
+  /// The objects that \p expr may point to, in the format of
+  /// \ref value_sett::get_value_set
+  /// \param expr: A pointer expression over symbols and registered dynamic
+  ///   objects (and not SSA expressions)
+  /// \return The objects, with function-local objects replaced by an unknown
+  ///   object: the analysis does not distinguish the instances of a local
+  ///   variable in different calls of a function, such as under recursion
+  std::vector<exprt> get_value_set(const exprt &expr) const;
+
+  /// The number of passes over all instructions \ref solve took
+  std::size_t iterations() const
+  {
+    return passes;
+  }
+
+protected:
+  const namespacet ns;
+  value_sett value_set;
+  std::size_t passes = 0;
+
+  std::map<irep_idt, const goto_programt *> functions;
+
+  std::unordered_map<irep_idt, unsigned> allocation_sites;
+  std::unordered_map<unsigned, std::vector<symbol_exprt>> dynamic_objects;
+
+  /// The symbol holding the return value of function \p function_id
+  symbol_exprt return_value(const irep_idt &function_id, const typet &type)
+    const;
+
+  void apply(const irep_idt &function_id, const goto_programt &body);
+  void apply_call(goto_programt::const_targett call);
+  void apply_other(const codet &code);
+
+  /// True if \p value, an entry of a value set, refers to an object that is
+  /// local to a function, such as a local variable or parameter
+  bool is_local_object(const exprt &value) const;
+
+  /// Replace registered dynamic objects in \p expr by their allocation site
+  exprt to_allocation_sites(exprt expr) const;
+
+  /// Add \p value to \p dest, once for each dynamic object registered for
+  /// the allocation site that \p value refers to, if any
+  void from_allocation_sites(const exprt &value, std::vector<exprt> &dest)
+    const;
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_VALUE_SET_ORACLE_H
@@ -162,6 +162,14 @@ class bdd_managert
     return bdd_nodet(bdd.bdd.getNode());
   }
 
+  /// Reorder the variables by sifting whenever the number of nodes grows
+  /// past a threshold. Indexes of variables and existing BDDs are not
+  /// affected.
+  void enable_variable_reordering()
+  {
+    cudd.AutodynEnable(CUDD_REORDER_SIFT);
+  }
+
 private:
   Cudd cudd;
 };
@@ -177,6 +177,12 @@ class bdd_managert : private mini_bdd_mgrt
     return bdd_nodet(bdd.node, bdd_var_to_index);
   }
 
+  /// miniBDD does not support reordering variables, the order remains that
+  /// of the calls to \ref bdd_variable
+  void enable_variable_reordering()
+  {
+  }
+
   bdd_managert(const bdd_managert &) = delete;
   bdd_managert() = default;
 
@@ -172,5 +172,18 @@ exprt bdd_exprt::as_expr(const bddt &root) const
 {
   std::unordered_map<bdd_nodet::idt, exprt> cache;
   bdd_nodet node = bdd_mgr.bdd_node(root);
-  return as_expr(node, cache);
+
+  if(as_expr_cache_limit == 0)
+    return as_expr(node, cache);
+
+  const auto cached = as_expr_cache.find(node.id());
+  if(cached != as_expr_cache.end())
+    return cached->second.second;
+
+  if(as_expr_cache.size() >= as_expr_cache_limit)
+    as_expr_cache.clear();
+
+  exprt result = as_expr(node, cache);
+  as_expr_cache.emplace(node.id(), std::make_pair(root, result));
+  return result;
 }
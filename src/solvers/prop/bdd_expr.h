@@ -36,6 +36,26 @@ class bdd_exprt
   bddt from_expr(const exprt &expr);
   exprt as_expr(const bddt &root) const;
 
+  /// Remember the results of \ref as_expr(const bddt &) for up to \p limit
+  /// distinct BDDs, which pays off when the same BDDs are converted
+  /// repeatedly, as is the case for guards in symbolic execution. Cached BDDs
+  /// are kept alive by the cache; once the limit is reached the cache is
+  /// cleared, which allows the BDD manager to reclaim their nodes.
+  /// A \p limit of 0 (the default) disables caching.
+  void set_as_expr_cache_limit(std::size_t limit)
+  {
+    as_expr_cache_limit = limit;
+    as_expr_cache.clear();
+  }
+
+  /// Let the BDD library reorder the variables, which are otherwise ordered
+  /// by their first occurrence in \ref from_expr. This is only supported when
+  /// using CUDD.
+  void enable_variable_reordering()
+  {
+    bdd_mgr.enable_variable_reordering();
+  }
+
 protected:
   bdd_managert bdd_mgr;
 
@@ -47,6 +67,13 @@ class bdd_exprt
   /// of \p node_map corresponds to the i-th variable
   std::vector<exprt> node_map;
 
+  std::size_t as_expr_cache_limit = 0;
+
+  /// Results of \ref as_expr(const bddt &), indexed by the root node. The BDD
+  /// is stored to make sure the node is not freed and re-used while cached.
+  mutable std::unordered_map<bdd_nodet::idt, std::pair<bddt, exprt>>
+    as_expr_cache;
+
   bddt from_expr_rec(const exprt &expr);
   exprt as_expr(
     const bdd_nodet &r,
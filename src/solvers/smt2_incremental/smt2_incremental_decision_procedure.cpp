@@ -566,6 +566,11 @@ void smt2_incremental_decision_proceduret::pop()
   UNIMPLEMENTED_FEATURE("`pop`.");
 }
 
+bool smt2_incremental_decision_proceduret::can_push_assumptions() const
+{
+  return false;
+}
+
 NODISCARD
 static decision_proceduret::resultt lookup_decision_procedure_result(
   const smt_check_sat_response_kindt &response_kind)
@@ -49,6 +49,7 @@ class smt2_incremental_decision_proceduret final
   void push(const std::vector<exprt> &assumptions) override;
   void push() override;
   void pop() override;
+  bool can_push_assumptions() const override;
 
   /// Gets the value of \p descriptor from the solver and returns the solver
   /// response expressed as an exprt of type \p type. This is an implementation
@@ -75,6 +75,13 @@ class stack_decision_proceduret : public decision_proceduret
   /// Popping from the empty stack results in an invariant violation.
   virtual void pop() = 0;
 
+  /// Returns true if \ref push(const std::vector<exprt> &) and \ref pop are
+  /// supported, i.e. the decision procedure can solve under assumptions.
+  virtual bool can_push_assumptions() const
+  {
+    return true;
+  }
+
   virtual ~stack_decision_proceduret() = default;
 };
 
@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Running Jobs in Separate Processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Running jobs in separate processes
+
+#include "run_in_processes.h"
+
+#include "tempfile.h"
+
+#include <iostream>
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+/// \return True if \p worker fails on \p job or throws an exception
+static bool run_job(
+  std::size_t job,
+  const std::string &file_name,
+  const std::function<bool(std::size_t, const std::string &)> &worker)
+{
+  try
+  {
+    return worker(job, file_name);
+  }
+  catch(...)
+  {
+    return true;
+  }
+}
+
+std::vector<bool> run_in_processes(
+  const std::vector<temporary_filet> &files,
+  const std::function<bool(std::size_t job, const std::string &file_name)>
+    &worker)
+{
+  std::vector<bool> failed(files.size(), true);
+
+#ifdef _WIN32
+  for(std::size_t job = 0; job < files.size(); ++job)
+    failed[job] = run_job(job, files[job](), worker);
+#else
+  std::vector<pid_t> workers(files.size(), -1);
+
+  // buffered output would be written by each worker otherwise
+  std::cout.flush();
+  std::cerr.flush();
+
+  for(std::size_t job = 0; job < files.size(); ++job)
+  {
+    workers[job] = fork();
+    if(workers[job] == 0)
+    {
+      // do not run the destructors and exit handlers of the parent
+      _exit(run_job(job, files[job](), worker) ? 1 : 0);
+    }
+  }
+
+  for(std::size_t job = 0; job < files.size(); ++job)
+  {
+    if(workers[job] < 0)
+      continue;
+
+    int status;
+    while(waitpid(workers[job], &status, 0) == -1)
+    {
+      if(errno != EINTR)
+      {
+        status = -1;
+        break;
+      }
+    }
+
+    failed[job] =
+      status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+  }
+#endif
+
+  return failed;
+}
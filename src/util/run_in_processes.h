@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+Module: Running Jobs in Separate Processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Running jobs in separate processes
+
+#ifndef CPROVER_UTIL_RUN_IN_PROCESSES_H
+#define CPROVER_UTIL_RUN_IN_PROCESSES_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+class temporary_filet;
+
+/// Runs \p worker once for each of \p files, each time in a separate
+/// process forked from this one, and waits for all of these processes. The
+/// worker of job `i` is given `i` and the name of `files[i]`, to which it
+/// writes its results for this process to read; it returns true on failure.
+/// On Windows, which does not support fork, the jobs are run one after the
+/// other in this process instead.
+/// \return For each job, whether it failed, that is, whether its process
+///   could not be started, did not exit normally, or its worker returned
+///   true or threw an exception
+std::vector<bool> run_in_processes(
+  const std::vector<temporary_filet> &files,
+  const std::function<bool(std::size_t job, const std::string &file_name)>
+    &worker);
+
+#endif // CPROVER_UTIL_RUN_IN_PROCESSES_H
@@ -0,0 +1,72 @@
+/*******************************************************************\
+
+Module: Stable IREP Hashing
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Hashes of ireps that can be compared across runs
+
+#ifndef CPROVER_UTIL_STABLE_IREP_HASH_H
+#define CPROVER_UTIL_STABLE_IREP_HASH_H
+
+#include "irep.h"
+#include "irep_hash.h"
+#include "string_hash.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+/// Hashes of ireps that, unlike \ref irept::hash, do not depend on the order
+/// in which strings were added to the string table, and can thus be compared
+/// across runs. Comments such as source locations are ignored, such that
+/// moving code does not change its hash.
+class stable_irep_hashert
+{
+public:
+  std::size_t operator()(const irept &irep)
+  {
+    const auto entry = cache.find(irep);
+    if(entry != cache.end())
+      return entry->second;
+
+    std::size_t result = hash_string(irep.id_string());
+    for(const auto &sub : irep.get_sub())
+      result = hash_combine(result, (*this)(sub));
+
+    // named_sub is ordered by the numbers of the strings in the string table,
+    // which depend on the order in which strings were added, hence sort by
+    // the strings themselves
+    std::vector<const irept::named_subt::value_type *> named_subs;
+    for(const auto &named_sub : irep.get_named_sub())
+    {
+      if(!irept::is_comment(named_sub.first))
+        named_subs.push_back(&named_sub);
+    }
+    std::sort(
+      named_subs.begin(),
+      named_subs.end(),
+      [](
+        const irept::named_subt::value_type *a,
+        const irept::named_subt::value_type *b) {
+        return id2string(a->first) < id2string(b->first);
+      });
+
+    for(const auto named_sub : named_subs)
+    {
+      result = hash_combine(result, hash_string(id2string(named_sub->first)));
+      result = hash_combine(result, (*this)(named_sub->second));
+    }
+
+    cache.emplace(irep, result);
+    return result;
+  }
+
+private:
+  std::unordered_map<irept, std::size_t, irep_hash> cache;
+};
+
+#endif // CPROVER_UTIL_STABLE_IREP_HASH_H
@@ -0,0 +1,208 @@
+/*******************************************************************\
+
+Module: Unit tests for cfg_dominators_templatet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for cfg_dominators_templatet
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/cfg_dominators.h>
+
+#include <util/std_expr.h>
+
+#include <random>
+
+/// Whether \p to can be reached from \p from without passing through
+/// \p removed, following the edges backwards if \p backwards is set
+static bool reachable_without(
+  const std::vector<goto_programt::const_targett> &instructions,
+  const goto_programt &goto_program,
+  goto_programt::const_targett from,
+  const std::function<bool(goto_programt::const_targett)> &is_target,
+  optionalt<goto_programt::const_targett> removed,
+  bool backwards)
+{
+  std::set<goto_programt::const_targett> visited;
+  std::vector<goto_programt::const_targett> stack;
+  if(from != removed)
+    stack.push_back(from);
+
+  while(!stack.empty())
+  {
+    const auto current = stack.back();
+    stack.pop_back();
+    if(!visited.insert(current).second)
+      continue;
+    if(is_target(current))
+      return true;
+
+    for(const auto &other : instructions)
+    {
+      const auto successors = goto_program.get_successors(
+        backwards ? other : current);
+      const auto next = backwards ? current : other;
+      if(
+        next != removed &&
+        std::find(successors.begin(), successors.end(), next) !=
+          successors.end())
+      {
+        stack.push_back(other);
+      }
+    }
+  }
+
+  return false;
+}
+
+/// A program of \p size instructions with random jumps
+static goto_programt random_program(std::mt19937 &generator, std::size_t size)
+{
+  const symbol_exprt condition{"c", bool_typet{}};
+
+  goto_programt goto_program;
+  std::vector<goto_programt::targett> jumps;
+  for(std::size_t i = 0; i + 1 < size; ++i)
+  {
+    switch(generator() % 4)
+    {
+    case 0:
+      goto_program.add(goto_programt::make_skip());
+      break;
+    case 1:
+      jumps.push_back(goto_program.add(goto_programt::make_incomplete_goto(
+        true_exprt{}, source_locationt{})));
+      break;
+    default:
+      jumps.push_back(goto_program.add(
+        goto_programt::make_incomplete_goto(condition, source_locationt{})));
+    }
+  }
+  goto_program.add(goto_programt::make_end_function());
+
+  for(auto &jump : jumps)
+  {
+    auto target = goto_program.instructions.begin();
+    std::advance(target, generator() % size);
+    jump->complete_goto(target);
+  }
+
+  goto_program.compute_location_numbers();
+  return goto_program;
+}
+
+SCENARIO("cfg_dominators", "[core][analyses][cfg_dominators]")
+{
+  GIVEN("Random programs")
+  {
+    std::mt19937 generator(42);
+
+    for(std::size_t program_number = 0; program_number < 50; ++program_number)
+    {
+      const goto_programt goto_program = random_program(generator, 12);
+      std::vector<goto_programt::const_targett> instructions;
+      forall_goto_program_instructions(it, goto_program)
+        instructions.push_back(it);
+
+      cfg_dominatorst dominators;
+      dominators(goto_program);
+      cfg_post_dominatorst post_dominators;
+      post_dominators(goto_program);
+
+      const auto entry = goto_program.instructions.begin();
+      const auto exit = std::prev(goto_program.instructions.end());
+      const auto is_exit = [&](goto_programt::const_targett t) {
+        const auto successors = goto_program.get_successors(t);
+        return t == exit || successors.empty() ||
+               (successors.size() == 1 && successors.front() == t);
+      };
+
+      for(const auto &v : instructions)
+      {
+        const bool reachable = reachable_without(
+          instructions,
+          goto_program,
+          entry,
+          [&](goto_programt::const_targett t) { return t == v; },
+          {},
+          false);
+        REQUIRE(dominators.program_point_reachable(v) == reachable);
+
+        const bool reaches_exit = reachable_without(
+          instructions, goto_program, v, is_exit, {}, false);
+        REQUIRE(post_dominators.program_point_reachable(v) == reaches_exit);
+
+        for(const auto &d : instructions)
+        {
+          const bool dominates =
+            reachable &&
+            (d == v || !reachable_without(
+                         instructions,
+                         goto_program,
+                         entry,
+                         [&](goto_programt::const_targett t) { return t == v; },
+                         d,
+                         false));
+          REQUIRE(dominators.dominates(d, v) == dominates);
+
+          const bool post_dominates =
+            reaches_exit &&
+            (d == v ||
+             !reachable_without(
+               instructions, goto_program, v, is_exit, d, false));
+          REQUIRE(post_dominators.dominates(d, v) == post_dominates);
+        }
+
+        const auto dominator_set =
+          dominators.get_dominators(dominators.get_node(v));
+        for(const auto &d : instructions)
+          REQUIRE((dominator_set.count(d) != 0) == dominators.dominates(d, v));
+      }
+    }
+  }
+
+  GIVEN("A large program with a sequence of loops containing a branch")
+  {
+    const symbol_exprt condition{"c", bool_typet{}};
+    const std::size_t number_of_loops = 1000;
+
+    goto_programt goto_program;
+    std::vector<goto_programt::targett> heads;
+    std::vector<goto_programt::targett> branches;
+    for(std::size_t i = 0; i < number_of_loops; ++i)
+    {
+      auto head = goto_program.add(goto_programt::make_skip());
+      auto branch = goto_program.add(
+        goto_programt::make_incomplete_goto(condition, source_locationt{}));
+      goto_program.add(goto_programt::make_skip());
+      auto latch = goto_program.add(goto_programt::make_goto(head, condition));
+      branch->complete_goto(latch);
+      heads.push_back(head);
+      branches.push_back(branch);
+    }
+    auto end = goto_program.add(goto_programt::make_end_function());
+    goto_program.compute_location_numbers();
+
+    cfg_dominatorst dominators;
+    dominators(goto_program);
+
+    THEN("All but the conditionally skipped instructions dominate the end")
+    {
+      REQUIRE(dominators.dominates(heads.front(), end));
+      REQUIRE(dominators.dominates(heads.back(), end));
+      REQUIRE_FALSE(dominators.dominates(std::next(branches.front()), end));
+      REQUIRE_FALSE(dominators.dominates(std::next(branches.back()), end));
+      REQUIRE_FALSE(dominators.dominates(end, heads.back()));
+      REQUIRE(
+        dominators.get_node(end).number_of_dominators ==
+        3 * number_of_loops + 1);
+      REQUIRE(
+        dominators.get_dominators(dominators.get_node(end)).size() ==
+        3 * number_of_loops + 1);
+    }
+  }
+}
@@ -0,0 +1,99 @@
+/*******************************************************************\
+
+Module: Unit tests for guardt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for guardt
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/guard.h>
+#include <util/options.h>
+#include <util/std_expr.h>
+
+SCENARIO("guard", "[core][analyses][guard]")
+{
+  const symbol_exprt a("a", bool_typet());
+  const symbol_exprt b("b", bool_typet());
+
+  GIVEN("Options selecting the kind of guards")
+  {
+    optionst options;
+
+    THEN("The default kind is used if none is given")
+    {
+      guard_managert guard_manager{options};
+      REQUIRE(guard_manager.kind() == guard_managert::default_kind());
+    }
+
+    THEN("BDD guards can be selected")
+    {
+      options.set_option("symex-guards", "bdd");
+      guard_managert guard_manager{options};
+      REQUIRE(guard_manager.kind() == guard_kindt::BDD);
+    }
+
+    THEN("Expression guards can be selected")
+    {
+      options.set_option("symex-guards", "expr");
+      guard_managert guard_manager{options};
+      REQUIRE(guard_manager.kind() == guard_kindt::EXPR);
+    }
+
+    THEN("Other values are rejected by parse_kind")
+    {
+      REQUIRE_FALSE(guard_managert::parse_kind("sat").has_value());
+    }
+  }
+
+  for(const auto kind : {guard_kindt::EXPR, guard_kindt::BDD})
+  {
+    GIVEN(
+      std::string{"A manager for "} +
+      (kind == guard_kindt::BDD ? "BDD" : "expression") + " guards")
+    {
+      guard_managert guard_manager{kind};
+
+      WHEN("A guard is extended by a condition and by false")
+      {
+        guardt guard{true_exprt{}, guard_manager};
+        guard.add(a);
+        REQUIRE_FALSE(guard.is_true());
+        guard.add(false_exprt{});
+
+        THEN("It is false")
+        {
+          REQUIRE(guard.is_false());
+        }
+      }
+
+      WHEN("The guards a&b and a&!b are merged")
+      {
+        guardt guard1{a, guard_manager};
+        guard1.add(b);
+        guardt guard2{a, guard_manager};
+        guard2.add(not_exprt{b});
+        guard1 |= guard2;
+
+        THEN("The result is equivalent to a")
+        {
+          REQUIRE(guard1.as_expr() == a);
+        }
+      }
+
+      WHEN("A guard is used to guard false")
+      {
+        const guardt guard{a, guard_manager};
+
+        THEN("The result is the negation of the guard")
+        {
+          REQUIRE(guard.guard_expr(false_exprt{}) == not_exprt{a});
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,165 @@
+/*******************************************************************\
+
+Module: Unit tests for integer_interval_mapt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for integer_interval_mapt
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/integer_interval_map.h>
+
+#include <util/arith_tools.h>
+
+#include <limits>
+#include <map>
+#include <random>
+
+typedef std::map<irep_idt, integer_intervalt> reference_mapt;
+
+static void require_equal(
+  const integer_interval_mapt &map,
+  const reference_mapt &reference)
+{
+  reference_mapt contents;
+  map.iterate(
+    [&contents](const irep_idt &identifier, const integer_intervalt &interval) {
+      REQUIRE_FALSE(interval.is_top());
+      REQUIRE(contents.emplace(identifier, interval).second);
+    });
+
+  reference_mapt non_top;
+  for(const auto &entry : reference)
+  {
+    if(!entry.second.is_top())
+      non_top.insert(entry);
+  }
+
+  REQUIRE(contents == non_top);
+}
+
+/// Join as interval_domaint did with a std::map: identifiers that only one
+/// side constrains become unconstrained
+static bool reference_join(reference_mapt &dest, const reference_mapt &other)
+{
+  bool changed = false;
+  for(auto it = dest.begin(); it != dest.end();)
+  {
+    const auto other_it = other.find(it->first);
+    if(other_it == other.end())
+    {
+      changed |= !it->second.is_top();
+      it = dest.erase(it);
+    }
+    else
+    {
+      const integer_intervalt previous = it->second;
+      it->second.join(other_it->second);
+      changed |= it->second != previous;
+      ++it;
+    }
+  }
+  return changed;
+}
+
+SCENARIO("integer_interval_mapt", "[core][analyses][integer_interval_map]")
+{
+  GIVEN("An empty map")
+  {
+    integer_interval_mapt map;
+
+    THEN("All identifiers are unconstrained")
+    {
+      REQUIRE(map.empty());
+      REQUIRE(map.get("x").is_top());
+    }
+
+    WHEN("Intervals are set")
+    {
+      const mp_integer wide = power(2, 70);
+      map.set("x", integer_intervalt{1, 5});
+      map.set("y", integer_intervalt{-wide, 3});
+      integer_intervalt lower_bounded;
+      lower_bounded.make_ge_than(std::numeric_limits<std::int64_t>::max());
+      map.set("z", lower_bounded);
+
+      THEN("They are returned unchanged")
+      {
+        REQUIRE(map.get("x") == integer_intervalt(1, 5));
+        REQUIRE(map.get("y") == integer_intervalt(-wide, 3));
+        REQUIRE(map.get("z") == lower_bounded);
+      }
+
+      THEN("Setting an interval to top removes it")
+      {
+        map.set("x", integer_intervalt{});
+        map.set("y", integer_intervalt{});
+        map.set("z", integer_intervalt{});
+        REQUIRE(map.empty());
+      }
+    }
+  }
+
+  GIVEN("Random maps")
+  {
+    std::mt19937 generator(42);
+    const std::vector<irep_idt> identifiers{"a", "b", "c", "d", "e", "f"};
+
+    const auto random_interval = [&generator]() {
+      integer_intervalt interval;
+      // a few bounds are too large for the packed representation
+      const auto random_bound = [&generator]() {
+        const mp_integer bound = mp_integer{generator() % 21} - 10;
+        return generator() % 8 == 0 ? bound * power(2, 64) : bound;
+      };
+      if(generator() % 4 != 0)
+        interval.make_ge_than(random_bound());
+      if(generator() % 4 != 0)
+        interval.make_le_than(random_bound());
+      return interval;
+    };
+
+    const auto random_maps = [&]() {
+      std::pair<integer_interval_mapt, reference_mapt> result;
+      for(const irep_idt &identifier : identifiers)
+      {
+        if(generator() % 3 == 0)
+          continue;
+        const integer_intervalt interval = random_interval();
+        result.first.set(identifier, interval);
+        result.second[identifier] = interval;
+      }
+      return result;
+    };
+
+    THEN("Join gives the same result as on std::map")
+    {
+      for(std::size_t i = 0; i < 1000; ++i)
+      {
+        auto lhs = random_maps();
+        const auto rhs = random_maps();
+        require_equal(lhs.first, lhs.second);
+
+        const bool changed = lhs.first.join(rhs.first);
+        const bool reference_changed = reference_join(lhs.second, rhs.second);
+        REQUIRE(changed == reference_changed);
+        require_equal(lhs.first, lhs.second);
+      }
+    }
+
+    THEN("Join with itself changes nothing")
+    {
+      for(std::size_t i = 0; i < 100; ++i)
+      {
+        auto map = random_maps().first;
+        const integer_interval_mapt copy = map;
+        REQUIRE_FALSE(map.join(copy));
+        REQUIRE(map == copy);
+      }
+    }
+  }
+}
@@ -0,0 +1,238 @@
+/*******************************************************************\
+
+Module: Unit tests for octagon_matrixt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for octagon_matrixt
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/octagon_matrix.h>
+
+#include <algorithm>
+#include <random>
+
+typedef octagon_matrixt::boundt boundt;
+
+/// A constraint node_a + node_b <= c
+struct constraintt
+{
+  std::size_t node_a;
+  std::size_t node_b;
+  boundt c;
+};
+
+static boundt node_value(const std::vector<boundt> &point, std::size_t node)
+{
+  return node % 2 == 0 ? point[node / 2] : -point[node / 2];
+}
+
+/// All integer points of [-range, range]^variables that satisfy the
+/// constraints
+static std::vector<std::vector<boundt>> integer_points(
+  std::size_t variables,
+  boundt range,
+  const std::vector<constraintt> &constraints)
+{
+  std::vector<std::vector<boundt>> points;
+  std::vector<boundt> point(variables, -range);
+
+  while(true)
+  {
+    if(std::all_of(
+         constraints.begin(),
+         constraints.end(),
+         [&point](const constraintt &constraint) {
+           return node_value(point, constraint.node_a) +
+                    node_value(point, constraint.node_b) <=
+                  constraint.c;
+         }))
+    {
+      points.push_back(point);
+    }
+
+    std::size_t k = 0;
+    while(k < variables && point[k] == range)
+      point[k++] = -range;
+    if(k == variables)
+      return points;
+    ++point[k];
+  }
+}
+
+SCENARIO("octagon_matrixt", "[core][analyses][octagon_matrix]")
+{
+  GIVEN("An octagon over two variables")
+  {
+    octagon_matrixt matrix{2};
+    const std::size_t x = octagon_matrixt::positive(0);
+    const std::size_t y = octagon_matrixt::positive(1);
+
+    THEN("It is unconstrained")
+    {
+      REQUIRE(matrix.is_top());
+    }
+
+    WHEN("x <= y - 1 and y <= 10")
+    {
+      matrix.add_sum_constraint(x, octagon_matrixt::bar(y), -1);
+      matrix.add_sum_constraint(y, y, 20);
+      REQUIRE(matrix.close());
+
+      THEN("x <= 9 follows")
+      {
+        REQUIRE(matrix.get_sum_bound(x, x) == 18);
+        REQUIRE(matrix.get_sum_bound(x, y) == 19);
+      }
+
+      THEN("Shifting x by 1 gives x <= y")
+      {
+        matrix.shift(0, 1);
+        REQUIRE(matrix.get_sum_bound(x, octagon_matrixt::bar(y)) == 0);
+        REQUIRE(matrix.get_sum_bound(x, x) == 20);
+      }
+
+      THEN("Negating x gives -x <= y - 1")
+      {
+        matrix.negate(0);
+        REQUIRE(
+          matrix.get_sum_bound(
+            octagon_matrixt::bar(x), octagon_matrixt::bar(y)) == -1);
+      }
+
+      THEN("Forgetting x keeps the bound of y")
+      {
+        matrix.forget(0);
+        REQUIRE(matrix.get_sum_bound(x, x) == octagon_matrixt::infinity);
+        REQUIRE(matrix.get_sum_bound(y, y) == 20);
+      }
+
+      THEN("Adding y <= x makes it empty")
+      {
+        matrix.add_sum_constraint(y, octagon_matrixt::bar(x), 0);
+        REQUIRE_FALSE(matrix.close());
+      }
+    }
+
+    WHEN("x + y is odd and both are equal")
+    {
+      // 2x <= 1 and 2x >= 1 has no integer solution
+      matrix.add_sum_constraint(x, y, 1);
+      matrix.add_sum_constraint(
+        octagon_matrixt::bar(x), octagon_matrixt::bar(y), -1);
+      matrix.add_sum_constraint(x, octagon_matrixt::bar(y), 0);
+      matrix.add_sum_constraint(y, octagon_matrixt::bar(x), 0);
+
+      THEN("The octagon is empty")
+      {
+        REQUIRE_FALSE(matrix.close());
+      }
+    }
+  }
+
+  GIVEN("Random octagons")
+  {
+    std::mt19937 generator(42);
+    const std::size_t variables = 3;
+    const boundt range = 3;
+
+    THEN("The closure gives the best bounds of the integer points")
+    {
+      for(std::size_t test = 0; test < 500; ++test)
+      {
+        octagon_matrixt matrix{variables};
+        std::vector<constraintt> constraints;
+
+        // Keep all points within the enumerated range
+        for(std::size_t v = 0; v < variables; ++v)
+        {
+          constraints.push_back({octagon_matrixt::positive(v),
+                                 octagon_matrixt::positive(v),
+                                 2 * range});
+          constraints.push_back({octagon_matrixt::negative(v),
+                                 octagon_matrixt::negative(v),
+                                 2 * range});
+        }
+
+        const std::size_t count = 1 + generator() % 6;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+          const std::size_t node_a = generator() % (2 * variables);
+          const std::size_t node_b = generator() % (2 * variables);
+          const boundt c = static_cast<boundt>(generator() % 13) - 6;
+          constraints.push_back({node_a, node_b, c});
+        }
+
+        for(const auto &constraint : constraints)
+        {
+          matrix.add_sum_constraint(
+            constraint.node_a, constraint.node_b, constraint.c);
+        }
+
+        const auto points = integer_points(variables, range, constraints);
+        const bool non_empty = matrix.close();
+        REQUIRE(non_empty == !points.empty());
+        if(!non_empty)
+          continue;
+
+        for(std::size_t i = 0; i < 2 * variables; ++i)
+        {
+          for(std::size_t j = 0; j < 2 * variables; ++j)
+          {
+            boundt best = node_value(points.front(), j) -
+                          node_value(points.front(), i);
+            for(const auto &point : points)
+            {
+              best =
+                std::max(best, node_value(point, j) - node_value(point, i));
+            }
+            REQUIRE(matrix.get(i, j) == best);
+          }
+        }
+      }
+    }
+
+    THEN("Joining closed octagons gives an upper bound of both")
+    {
+      for(std::size_t test = 0; test < 100; ++test)
+      {
+        std::vector<octagon_matrixt> matrices;
+        while(matrices.size() < 2)
+        {
+          octagon_matrixt matrix{variables};
+          for(std::size_t i = 0; i < 4; ++i)
+          {
+            matrix.add_sum_constraint(
+              generator() % (2 * variables),
+              generator() % (2 * variables),
+              static_cast<boundt>(generator() % 13) - 6);
+          }
+          if(matrix.close())
+            matrices.push_back(matrix);
+        }
+
+        octagon_matrixt joined = matrices[0];
+        joined.join(matrices[1]);
+        octagon_matrixt widened = matrices[0];
+        widened.widen(matrices[1]);
+
+        for(std::size_t i = 0; i < 2 * variables; ++i)
+        {
+          for(std::size_t j = 0; j < 2 * variables; ++j)
+          {
+            REQUIRE(joined.get(i, j) >= matrices[0].get(i, j));
+            REQUIRE(joined.get(i, j) >= matrices[1].get(i, j));
+            REQUIRE(widened.get(i, j) >= joined.get(i, j));
+          }
+        }
+
+        REQUIRE_FALSE(joined.join(matrices[1]));
+        REQUIRE_FALSE(widened.widen(joined));
+      }
+    }
+  }
+}
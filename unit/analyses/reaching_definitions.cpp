@@ -0,0 +1,114 @@
+/*******************************************************************\
+
+Module: Unit tests for reaching_definitions_analysist
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for reaching_definitions_analysist
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/reaching_definitions.h>
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/symbol_table.h>
+
+#include <set>
+
+/// The instructions whose definitions of \p identifier reach \p target
+static std::set<goto_programt::const_targett> definitions(
+  const reaching_definitions_analysist &rd,
+  goto_programt::const_targett target,
+  const irep_idt &identifier)
+{
+  std::set<goto_programt::const_targett> result;
+  for(const auto &entry : rd[target].get(identifier))
+    result.insert(entry.first);
+  return result;
+}
+
+static symbolt make_variable(
+  const irep_idt &identifier,
+  const typet &type,
+  bool is_static_lifetime)
+{
+  symbolt symbol{identifier, type, ID_C};
+  symbol.base_name = identifier;
+  symbol.is_lvalue = true;
+  symbol.is_static_lifetime = is_static_lifetime;
+  symbol.is_thread_local = !is_static_lifetime;
+  symbol.is_file_local = !is_static_lifetime;
+  return symbol;
+}
+
+SCENARIO(
+  "reaching_definitions_analysist",
+  "[core][analyses][reaching_definitions]")
+{
+  const signedbv_typet int_type{32};
+
+  symbol_tablet symbol_table;
+  const symbolt x_symbol = make_variable("main::1::x", int_type, false);
+  const symbolt g_symbol = make_variable("g", int_type, true);
+  const symbolt c_symbol = make_variable("c", bool_typet{}, true);
+  symbol_table.add(x_symbol);
+  symbol_table.add(g_symbol);
+  symbol_table.add(c_symbol);
+  const symbol_exprt x = x_symbol.symbol_expr();
+  const symbol_exprt g = g_symbol.symbol_expr();
+  const symbol_exprt c = c_symbol.symbol_expr();
+
+  // int x; x = 1; if(c) x = 2; g = x; x = 3; g = 4;
+  goto_functionst goto_functions;
+  goto_programt &body =
+    goto_functions.function_map[goto_functionst::entry_point()].body;
+  body.add(goto_programt::make_decl(x));
+  const auto assign_x_1 =
+    body.add(goto_programt::make_assignment(x, from_integer(1, int_type)));
+  const auto branch = body.add(goto_programt::make_incomplete_goto(not_exprt{c}));
+  const auto assign_x_2 =
+    body.add(goto_programt::make_assignment(x, from_integer(2, int_type)));
+  const auto assign_g_x = body.add(goto_programt::make_assignment(g, x));
+  branch->complete_goto(assign_g_x);
+  const auto assign_x_3 =
+    body.add(goto_programt::make_assignment(x, from_integer(3, int_type)));
+  const auto assign_g_4 =
+    body.add(goto_programt::make_assignment(g, from_integer(4, int_type)));
+  const auto end = body.add(goto_programt::make_end_function());
+  goto_functions.update();
+
+  const namespacet ns{symbol_table};
+  reaching_definitions_analysist rd{ns};
+  rd(goto_functions, ns);
+
+  THEN("Definitions on both branches reach the join")
+  {
+    REQUIRE(
+      definitions(rd, assign_g_x, x.get_identifier()) ==
+      std::set<goto_programt::const_targett>{assign_x_1, assign_x_2});
+  }
+
+  THEN("A definition of the whole variable kills earlier ones")
+  {
+    REQUIRE(
+      definitions(rd, assign_x_2, x.get_identifier()) ==
+      std::set<goto_programt::const_targett>{assign_x_1});
+    REQUIRE(
+      definitions(rd, assign_g_4, x.get_identifier()) ==
+      std::set<goto_programt::const_targett>{assign_x_3});
+  }
+
+  THEN("Variables that are not written keep their definitions")
+  {
+    REQUIRE(
+      definitions(rd, assign_g_4, g.get_identifier()) ==
+      std::set<goto_programt::const_targett>{assign_g_x});
+    REQUIRE(
+      definitions(rd, end, g.get_identifier()) ==
+      std::set<goto_programt::const_targett>{assign_g_4});
+  }
+}
@@ -0,0 +1,147 @@
+/*******************************************************************\
+
+Module: Unit tests for system_dependence_grapht
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for system_dependence_grapht
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/system_dependence_graph.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_code.h>
+
+#include <set>
+#include <sstream>
+
+/// The instructions that \p target depends on directly or through join and
+/// object nodes
+static std::set<goto_programt::const_targett> dependencies(
+  const system_dependence_grapht &sdg,
+  goto_programt::const_targett target)
+{
+  std::set<goto_programt::const_targett> result;
+  std::set<system_dependence_grapht::node_indext> visited;
+  std::vector<system_dependence_grapht::node_indext> stack{
+    sdg.instruction_node(target)};
+
+  while(!stack.empty())
+  {
+    const auto &node = sdg[stack.back()];
+    stack.pop_back();
+
+    for(const auto &edge : node.in)
+    {
+      const auto &dependency = sdg[edge.first];
+      if(dependency.kind == sdg_nodet::kindt::INSTRUCTION)
+        result.insert(dependency.PC);
+      else if(visited.insert(edge.first).second)
+        stack.push_back(edge.first);
+    }
+  }
+
+  return result;
+}
+
+SCENARIO(
+  "system_dependence_grapht links uses to reaching definitions",
+  "[core][analyses][system_dependence_graph]")
+{
+  const typet int_type = signed_int_type();
+  const symbol_exprt x{"main::x", int_type};
+  const symbol_exprt c{"c", bool_typet{}};
+  const symbol_exprt g{"g", int_type};
+  const symbol_exprt h{"h", int_type};
+  const symbol_exprt p{"f::p", int_type};
+
+  goto_functionst goto_functions;
+
+  // void f(int p) { h = p; }
+  goto_functionst::goto_functiont &f = goto_functions.function_map["f"];
+  f.parameter_identifiers.push_back(p.get_identifier());
+  const auto assign_h = f.body.add(goto_programt::make_assignment(h, p));
+  f.body.add(goto_programt::make_end_function());
+
+  // int x; x = 1; if(c) x = 2; g = x; f(x); assert(g == 0);
+  goto_programt &body = goto_functions.function_map["main"].body;
+  body.add(goto_programt::make_decl(x));
+  const auto assign_x_1 =
+    body.add(goto_programt::make_assignment(x, from_integer(1, int_type)));
+  const auto branch = body.add(goto_programt::make_incomplete_goto(not_exprt{c}));
+  const auto assign_x_2 =
+    body.add(goto_programt::make_assignment(x, from_integer(2, int_type)));
+  const auto assign_g = body.add(goto_programt::make_assignment(g, x));
+  branch->complete_goto(assign_g);
+  const code_typet f_type{{code_typet::parametert{int_type}}, empty_typet{}};
+  const auto call = body.add(goto_programt::make_function_call(
+    code_function_callt{symbol_exprt{"f", f_type}, {x}}));
+  const auto assertion = body.add(goto_programt::make_assertion(
+    equal_exprt{g, from_integer(0, int_type)}));
+  body.add(goto_programt::make_end_function());
+
+  goto_functions.update();
+
+  system_dependence_grapht sdg;
+  sdg(goto_functions);
+
+  THEN("Definitions on both branches reach the join")
+  {
+    const auto deps = dependencies(sdg, assign_g);
+    REQUIRE(deps.count(assign_x_1) == 1);
+    REQUIRE(deps.count(assign_x_2) == 1);
+    REQUIRE(deps.count(branch) == 0);
+  }
+
+  THEN("A strong definition kills earlier ones")
+  {
+    const auto deps = dependencies(sdg, assign_x_2);
+    REQUIRE(deps.count(assign_x_1) == 0);
+    REQUIRE(deps.count(branch) == 1);
+  }
+
+  THEN("Global variables link writes to reads")
+  {
+    REQUIRE(dependencies(sdg, assertion).count(assign_g) == 1);
+  }
+
+  THEN("Parameters depend on the arguments of calls")
+  {
+    const auto deps = dependencies(sdg, assign_h);
+    REQUIRE(deps.count(call) == 1);
+    REQUIRE(dependencies(sdg, call).count(assign_x_2) == 1);
+  }
+  THEN("A graph that was written can be read for the same program")
+  {
+    std::stringstream stream;
+    REQUIRE_FALSE(sdg.write(stream, goto_functions));
+
+    system_dependence_grapht read_sdg;
+    REQUIRE_FALSE(read_sdg.read(stream, goto_functions));
+    REQUIRE(read_sdg.size() == sdg.size());
+    REQUIRE(read_sdg.cfg_post_dominators().size() == 2);
+    for(const auto target : {assign_g, assign_x_2, assertion, assign_h, call})
+      REQUIRE(dependencies(read_sdg, target) == dependencies(sdg, target));
+  }
+
+  THEN("A graph that was written cannot be read for another program")
+  {
+    std::stringstream stream;
+    REQUIRE_FALSE(sdg.write(stream, goto_functions));
+
+    goto_functionst other_functions;
+    other_functions.copy_from(goto_functions);
+    other_functions.function_map["f"].body.instructions.front() =
+      goto_programt::make_assignment(h, from_integer(0, int_type));
+    other_functions.update();
+
+    system_dependence_grapht read_sdg;
+    REQUIRE(read_sdg.read(stream, other_functions));
+    REQUIRE(read_sdg.size() == 0);
+  }
+}
@@ -0,0 +1,96 @@
+/*******************************************************************\
+
+ Module: Tests for abstract_environmentt::merge
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+
+#include <analyses/variable-sensitivity/abstract_environment.h>
+#include <analyses/variable-sensitivity/abstract_object_statistics.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_object_factory.h>
+#include <analyses/variable-sensitivity/variable_sensitivity_test_helpers.h>
+
+// NOLINTNEXTLINE(whitespace/line_length)
+#include <analyses/variable-sensitivity/interval_abstract_value.h> // IWYU pragma: keep
+#include <testing-utils/use_catch.h>
+
+SCENARIO(
+  "abstract_environment merge",
+  "[core][analyses][variable-sensitivity][abstract_environment][merge]")
+{
+  auto config = vsd_configt::intervals();
+  config.context_tracking.data_dependency_context = false;
+  config.context_tracking.last_write_context = false;
+  auto object_factory =
+    variable_sensitivity_object_factoryt::configured_with(config);
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+
+  const typet type = signedbv_typet(32);
+  const exprt val0 = from_integer(0, type);
+  const exprt val1 = from_integer(1, type);
+  const exprt val2 = from_integer(2, type);
+  const exprt val5 = from_integer(5, type);
+  const symbol_exprt x{"x", type};
+  const symbol_exprt y{"y", type};
+  const goto_programt::const_targett location{};
+
+  abstract_environmentt env{object_factory};
+  env.make_top();
+  env.assign(x, make_interval(val1, val2, env, ns), ns);
+  env.assign(y, make_interval(val0, val5, env, ns), ns);
+  const abstract_object_pointert x_value = env.eval(x, ns);
+  const abstract_object_pointert y_value = env.eval(y, ns);
+
+  GIVEN("an environment with x in [1, 2] and y in [0, 5]")
+  {
+    WHEN("merging it with a copy of itself")
+    {
+      abstract_environmentt merged = env;
+      const bool modified = merged.merge(env, location, widen_modet::no);
+
+      THEN("nothing changes and the objects remain shared")
+      {
+        REQUIRE_FALSE(modified);
+        REQUIRE(merged.eval(x, ns) == x_value);
+        REQUIRE(merged.eval(y, ns) == y_value);
+      }
+    }
+
+    WHEN("merging it with an environment that includes it")
+    {
+      abstract_environmentt other = env;
+      const auto wider = make_interval(val0, val5, env, ns);
+      other.assign(x, wider, ns);
+
+      abstract_environmentt merged = env;
+      const bool modified = merged.merge(other, location, widen_modet::no);
+
+      THEN("x shares the object of the other environment")
+      {
+        REQUIRE(modified);
+        REQUIRE(merged.eval(x, ns) == wider);
+        REQUIRE(merged.eval(y, ns) == y_value);
+      }
+
+      THEN("the statistics count the shared objects")
+      {
+        abstract_object_visitedt bound_objects;
+        const auto env_statistics = env.gather_statistics(ns, bound_objects);
+        const auto merged_statistics =
+          merged.gather_statistics(ns, bound_objects);
+
+        REQUIRE(env_statistics.number_of_bindings == 2);
+        REQUIRE(env_statistics.number_of_allocated_objects == 2);
+        REQUIRE(merged_statistics.number_of_bindings == 2);
+        REQUIRE(merged_statistics.number_of_allocated_objects == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,120 @@
+/*******************************************************************\
+
+Module: Unit tests for weak_topological_ordert
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for weak_topological_ordert
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/weak_topological_order.h>
+
+#include <util/std_expr.h>
+
+#include <sstream>
+
+static std::string to_string(const weak_topological_ordert &wto)
+{
+  std::ostringstream out;
+  wto.output(out);
+  return out.str();
+}
+
+SCENARIO(
+  "weak_topological_order",
+  "[core][analyses][weak_topological_order]")
+{
+  const symbol_exprt condition{"c", bool_typet{}};
+
+  GIVEN("A program without loops")
+  {
+    goto_programt goto_program;
+    auto skip = goto_program.add(goto_programt::make_skip());
+    auto end = goto_program.add(goto_programt::make_end_function());
+    goto_program.insert_before(
+      skip, goto_programt::make_goto(end, condition));
+    goto_program.compute_location_numbers();
+
+    const weak_topological_ordert wto{goto_program};
+
+    THEN("The order is topological and has no components")
+    {
+      REQUIRE(to_string(wto) == "0 1 2");
+      REQUIRE_FALSE(wto.is_head(goto_program.instructions.begin()));
+    }
+  }
+
+  GIVEN("A program with nested loops and an unreachable instruction")
+  {
+    // 0: SKIP
+    // 1: SKIP                   <- outer loop head
+    // 2: SKIP                   <- inner loop head
+    // 3: IF c THEN GOTO 2
+    // 4: SKIP
+    // 5: IF c THEN GOTO 1
+    // 6: GOTO 8
+    // 7: SKIP                   <- unreachable
+    // 8: END_FUNCTION
+    goto_programt goto_program;
+    goto_program.add(goto_programt::make_skip());
+    auto outer = goto_program.add(goto_programt::make_skip());
+    auto inner = goto_program.add(goto_programt::make_skip());
+    goto_program.add(goto_programt::make_goto(inner, condition));
+    goto_program.add(goto_programt::make_skip());
+    goto_program.add(goto_programt::make_goto(outer, condition));
+    auto jump = goto_program.add(goto_programt::make_goto(outer));
+    auto unreachable = goto_program.add(goto_programt::make_skip());
+    auto end = goto_program.add(goto_programt::make_end_function());
+    jump->set_target(end);
+    goto_program.compute_location_numbers();
+
+    const weak_topological_ordert wto{goto_program};
+
+    THEN("The loops are nested components")
+    {
+      REQUIRE(to_string(wto) == "0 (1 (2 3) 4 5) 6 8");
+    }
+
+    THEN("Only the loop heads are heads")
+    {
+      REQUIRE(wto.is_head(outer));
+      REQUIRE(wto.is_head(inner));
+      REQUIRE_FALSE(wto.is_head(std::next(inner)));
+      REQUIRE_FALSE(wto.is_head(end));
+    }
+
+    THEN("Unreachable instructions come after all others")
+    {
+      REQUIRE(wto.position(outer) < wto.position(inner));
+      REQUIRE(wto.position(end) == wto.elements().size() - 1);
+      REQUIRE(wto.position(unreachable) == wto.elements().size());
+    }
+  }
+
+  GIVEN("A loop with a very long body")
+  {
+    // Bourdoncle's recursion nests once per instruction of the body
+    const std::size_t length = 300000;
+    goto_programt goto_program;
+    auto head = goto_program.add(goto_programt::make_skip());
+    for(std::size_t i = 1; i < length; ++i)
+      goto_program.add(goto_programt::make_skip());
+    goto_program.add(goto_programt::make_goto(head, condition));
+    auto end = goto_program.add(goto_programt::make_end_function());
+    goto_program.compute_location_numbers();
+
+    const weak_topological_ordert wto{goto_program};
+
+    THEN("The body is a single component")
+    {
+      REQUIRE(wto.is_head(head));
+      REQUIRE_FALSE(wto.is_head(std::next(head)));
+      REQUIRE(wto.elements().front().component_end == length + 1);
+      REQUIRE(wto.position(end) == length + 1);
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/*******************************************************************\
+
+Module: Unit tests for cover_goals_subsumptiont
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_expr.h>
+
+#include <goto-checker/cover_goals_subsumption.h>
+#include <goto-programs/goto_functions.h>
+#include <testing-utils/use_catch.h>
+
+static source_locationt goal_location(const irep_idt &property_id)
+{
+  source_locationt location;
+  location.set_property_id(property_id);
+  return location;
+}
+
+TEST_CASE(
+  "cover_goals_subsumptiont targets goals not implied by other goals",
+  "[core][goto-checker][cover_goals_subsumption]")
+{
+  // entry:  ASSERT false          // entry point
+  //         ASSERT c              // branch false
+  //         ASSERT !c             // branch true
+  //         IF c THEN GOTO taken
+  //         x = 1
+  //         GOTO end
+  // taken:  ASSERT false          // location in the taken branch
+  // end:    END_FUNCTION
+  goto_functionst goto_functions;
+  goto_programt &body = goto_functions.function_map["main"].body;
+  const symbol_exprt c("c", bool_typet());
+  const symbol_exprt x("x", signedbv_typet(32));
+
+  body.add(goto_programt::make_assertion(false_exprt(), goal_location("e")));
+  body.add(goto_programt::make_assertion(c, goal_location("bf")));
+  body.add(goto_programt::make_assertion(not_exprt(c), goal_location("bt")));
+  auto jump = body.add(goto_programt::make_incomplete_goto(c));
+  body.add(goto_programt::make_assignment(x, from_integer(1, x.type())));
+  auto jump_to_end =
+    body.add(goto_programt::make_incomplete_goto(true_exprt()));
+  auto taken = body.add(
+    goto_programt::make_assertion(false_exprt(), goal_location("l")));
+  auto end = body.add(goto_programt::make_end_function());
+  jump->complete_goto(taken);
+  jump_to_end->complete_goto(end);
+  goto_functions.update();
+
+  propertiest properties;
+  for(const irep_idt property_id : {"e", "bf", "bt", "l"})
+  {
+    properties.emplace(
+      property_id,
+      property_infot{
+        body.instructions.begin(), "ignored", property_statust::UNKNOWN});
+  }
+
+  const cover_goals_subsumptiont subsumption(goto_functions, properties);
+
+  // the entry point dominates everything, and the taken branch dominates "l"
+  REQUIRE(subsumption.number_of_subsumable_goals() == 2);
+  REQUIRE(
+    subsumption.get_targets(properties) ==
+    std::unordered_set<irep_idt>{"bf", "l"});
+
+  properties.at("bf").status = property_statust::PASS;
+  properties.at("l").status = property_statust::FAIL;
+  REQUIRE(
+    subsumption.get_targets(properties) == std::unordered_set<irep_idt>{"bt"});
+
+  properties.at("bt").status = property_statust::FAIL;
+  REQUIRE(
+    subsumption.get_targets(properties) == std::unordered_set<irep_idt>{"e"});
+
+  properties.at("e").status = property_statust::FAIL;
+  REQUIRE(subsumption.get_targets(properties).empty());
+}
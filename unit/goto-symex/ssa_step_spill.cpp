@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+Module: Unit tests for spilling SSA steps to disk
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+
+#include <goto-symex/symex_target_equation.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+SCENARIO(
+  "Spilling SSA steps of an equation",
+  "[core][goto-symex][ssa_step_spill]")
+{
+  const signedbv_typet int_type{32};
+  const symbol_exprt x{"x", int_type};
+
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source{"main", goto_program};
+
+  symex_target_equationt equation{null_message_handler};
+  equation.enable_spilling(1);
+
+  GIVEN("An equation with three assignments and one assertion")
+  {
+    for(int i = 0; i < 3; ++i)
+    {
+      ssa_exprt lhs{x};
+      lhs.set_level_2(i);
+      equation.assignment(
+        true_exprt{},
+        lhs,
+        lhs,
+        x,
+        from_integer(i, int_type),
+        source,
+        symex_targett::assignment_typet::STATE);
+    }
+    equation.assertion(true_exprt{}, false_exprt{}, "property", source);
+
+    THEN("All steps but the last one are spilled")
+    {
+      REQUIRE(equation.has_spilled_steps());
+      auto step = equation.SSA_steps.begin();
+      for(int i = 0; i < 3; ++i, ++step)
+      {
+        REQUIRE(step->spill_position.has_value());
+        REQUIRE(step->ssa_rhs.is_nil());
+      }
+      REQUIRE(step->is_assert());
+      REQUIRE_FALSE(step->spill_position.has_value());
+    }
+
+    WHEN("Another assignment is added")
+    {
+      equation.assignment(
+        true_exprt{},
+        ssa_exprt{x},
+        x,
+        x,
+        from_integer(3, int_type),
+        source,
+        symex_targett::assignment_typet::STATE);
+
+      THEN("The assertion is not spilled")
+      {
+        const auto &assertion = *std::next(equation.SSA_steps.begin(), 3);
+        REQUIRE(assertion.is_assert());
+        REQUIRE_FALSE(assertion.spill_position.has_value());
+        REQUIRE(assertion.cond_expr == false_exprt{});
+      }
+    }
+
+    WHEN("The spilled steps are restored")
+    {
+      equation.restore_spilled_steps();
+
+      THEN("The steps are the ones originally added")
+      {
+        REQUIRE_FALSE(equation.has_spilled_steps());
+        int i = 0;
+        for(const auto &step : equation.SSA_steps)
+        {
+          REQUIRE_FALSE(step.spill_position.has_value());
+          if(!step.is_assignment())
+            continue;
+          REQUIRE(step.guard == true_exprt{});
+          REQUIRE(step.ssa_lhs.get_level_2() == std::to_string(i));
+          REQUIRE(step.original_full_lhs == x);
+          REQUIRE(step.ssa_rhs == from_integer(i, int_type));
+          ++i;
+        }
+        REQUIRE(i == 3);
+      }
+    }
+  }
+}
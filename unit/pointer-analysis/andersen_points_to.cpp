@@ -0,0 +1,204 @@
+/*******************************************************************\
+
+Module: Unit tests for andersen_points_tot
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for andersen_points_tot
+
+#include <util/c_types.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <pointer-analysis/andersen_points_to.h>
+#include <testing-utils/use_catch.h>
+
+static symbol_exprt add_variable(
+  symbol_tablet &symbol_table,
+  const irep_idt &identifier,
+  const typet &type)
+{
+  symbolt symbol;
+  symbol.name = identifier;
+  symbol.base_name = identifier;
+  symbol.type = type;
+  symbol.is_lvalue = true;
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+static symbol_exprt add_function(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  const irep_idt &identifier,
+  const code_typet &type)
+{
+  symbolt symbol;
+  symbol.name = identifier;
+  symbol.base_name = identifier;
+  symbol.type = type;
+  symbol_table.add(symbol);
+
+  goto_functiont &goto_function = goto_functions.function_map[identifier];
+  for(const auto &parameter : type.parameters())
+    goto_function.parameter_identifiers.push_back(parameter.get_identifier());
+  goto_function.body.add(goto_programt::make_end_function());
+
+  return symbol.symbol_expr();
+}
+
+static goto_programt::targett
+add_call(goto_programt &goto_program, const exprt &pointer)
+{
+  return goto_program.add(goto_programt::make_function_call(
+    code_function_callt{dereference_exprt{pointer}}));
+}
+
+SCENARIO("points_to_sett", "[core][pointer-analysis][andersen_points_to]")
+{
+  GIVEN("Two sets with elements in different words")
+  {
+    points_to_sett a;
+    points_to_sett b;
+    REQUIRE(a.insert(3));
+    REQUIRE_FALSE(a.insert(3));
+    REQUIRE(a.insert(200));
+    REQUIRE(b.insert(3));
+    REQUIRE(b.insert(64));
+
+    THEN("Inserting one into the other records the new elements")
+    {
+      points_to_sett added;
+      REQUIRE(a.insert(b, added));
+      REQUIRE(a.elements() == std::vector<std::size_t>{3, 64, 200});
+      REQUIRE(added.elements() == std::vector<std::size_t>{64});
+      REQUIRE(a.size() == 3);
+      REQUIRE(a.contains(64));
+      REQUIRE_FALSE(a.contains(65));
+      REQUIRE_FALSE(a.insert(b, added));
+    }
+  }
+}
+
+SCENARIO(
+  "andersen_points_tot resolves function pointers",
+  "[core][pointer-analysis][andersen_points_to]")
+{
+  symbol_tablet symbol_table;
+  goto_functionst goto_functions;
+  const code_typet void_function{{}, empty_typet{}};
+  const pointer_typet function_pointer = pointer_type(void_function);
+
+  const symbol_exprt f =
+    add_function(symbol_table, goto_functions, "f", void_function);
+  const symbol_exprt g =
+    add_function(symbol_table, goto_functions, "g", void_function);
+  const symbol_exprt h =
+    add_function(symbol_table, goto_functions, "h", void_function);
+
+  goto_programt &main = goto_functions.function_map["main"].body;
+
+  GIVEN("A pointer that is assigned directly and through another pointer")
+  {
+    const symbol_exprt fp = add_variable(symbol_table, "fp", function_pointer);
+    const symbol_exprt q =
+      add_variable(symbol_table, "q", pointer_type(function_pointer));
+    main.add(goto_programt::make_assignment(fp, address_of_exprt{f}));
+    main.add(goto_programt::make_assignment(q, address_of_exprt{fp}));
+    main.add(goto_programt::make_assignment(
+      dereference_exprt{q}, address_of_exprt{g}));
+    const auto call = add_call(main, fp);
+    main.add(goto_programt::make_end_function());
+
+    const namespacet ns{symbol_table};
+    andersen_points_tot points_to{ns};
+    points_to(goto_functions);
+
+    THEN("The call may go to both functions")
+    {
+      REQUIRE(
+        points_to.called_functions(call) ==
+        std::set<irep_idt>{f.get_identifier(), g.get_identifier()});
+    }
+  }
+
+  GIVEN("Pointers that are copied in a cycle")
+  {
+    const symbol_exprt a = add_variable(symbol_table, "a", function_pointer);
+    const symbol_exprt b = add_variable(symbol_table, "b", function_pointer);
+    main.add(goto_programt::make_assignment(a, b));
+    main.add(goto_programt::make_assignment(b, a));
+    main.add(goto_programt::make_assignment(a, address_of_exprt{h}));
+    const auto call = add_call(main, b);
+    main.add(goto_programt::make_end_function());
+
+    const namespacet ns{symbol_table};
+    andersen_points_tot points_to{ns};
+    points_to(goto_functions);
+
+    THEN("The cycle is collapsed and the call goes to h")
+    {
+      REQUIRE(
+        points_to.called_functions(call) ==
+        std::set<irep_idt>{h.get_identifier()});
+      REQUIRE(points_to.statistics().collapsed_nodes == 1);
+    }
+  }
+
+  GIVEN("A pointer passed to a function called through a pointer")
+  {
+    code_typet::parametert parameter{function_pointer};
+    parameter.set_identifier("k::p");
+    const code_typet k_type{{parameter}, empty_typet{}};
+    const symbol_exprt k =
+      add_function(symbol_table, goto_functions, "k", k_type);
+    const symbol_exprt p = add_variable(symbol_table, "k::p", function_pointer);
+    goto_programt &k_body = goto_functions.function_map["k"].body;
+    k_body.clear();
+    const auto call_in_k = add_call(k_body, p);
+    k_body.add(goto_programt::make_end_function());
+
+    const symbol_exprt kp =
+      add_variable(symbol_table, "kp", pointer_type(k_type));
+    main.add(goto_programt::make_assignment(kp, address_of_exprt{k}));
+    main.add(goto_programt::make_function_call(
+      code_function_callt{dereference_exprt{kp}, {address_of_exprt{f}}}));
+    main.add(goto_programt::make_end_function());
+
+    const namespacet ns{symbol_table};
+    andersen_points_tot points_to{ns};
+    points_to(goto_functions);
+
+    THEN("The argument is bound to the parameter")
+    {
+      REQUIRE(
+        points_to.called_functions(call_in_k) ==
+        std::set<irep_idt>{f.get_identifier()});
+    }
+  }
+
+  GIVEN("A non-deterministic pointer")
+  {
+    const symbol_exprt r = add_variable(symbol_table, "r", function_pointer);
+    main.add(goto_programt::make_assignment(
+      r, side_effect_expr_nondett{function_pointer, source_locationt{}}));
+    const auto call = add_call(main, r);
+    main.add(goto_programt::make_end_function());
+
+    const namespacet ns{symbol_table};
+    andersen_points_tot points_to{ns};
+    points_to(goto_functions);
+
+    THEN("The targets of the call are unknown")
+    {
+      REQUIRE_FALSE(points_to.called_functions(call).has_value());
+    }
+  }
+}
@@ -0,0 +1,253 @@
+/*******************************************************************\
+
+Module: Unit tests for value_set_object_mapt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for value_set_object_mapt
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/symbol_table.h>
+
+#include <pointer-analysis/value_set.h>
+#include <pointer-analysis/value_set_object_map.h>
+#include <testing-utils/use_catch.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+
+static const mp_integer large_offset = power(2, 70);
+
+SCENARIO(
+  "value_set_object_mapt stores offsets",
+  "[core][pointer-analysis][value_set_object_map]")
+{
+  value_set_object_mapt map;
+  map.insert_or_assign(5, mp_integer{-3});
+  map.insert_or_assign(1, {});
+  map.insert_or_assign(3, large_offset);
+
+  THEN("Elements are ordered by key and offsets are preserved")
+  {
+    REQUIRE(map.size() == 3);
+    auto it = map.begin();
+    REQUIRE(it->first == 1);
+    REQUIRE_FALSE(it->second.has_value());
+    ++it;
+    REQUIRE(*it == value_set_object_mapt::value_type{3, large_offset});
+    ++it;
+    REQUIRE(*it == value_set_object_mapt::value_type{5, mp_integer{-3}});
+    ++it;
+    REQUIRE(it == map.end());
+  }
+
+  THEN("Elements can be found, overwritten and erased")
+  {
+    REQUIRE(map.find(2) == map.end());
+    REQUIRE(map.find(3)->second == large_offset);
+    map.insert_or_assign(3, mp_integer{7});
+    REQUIRE(map.find(3)->second == mp_integer{7});
+    REQUIRE(map.erase(3) == 1);
+    REQUIRE(map.erase(3) == 0);
+    REQUIRE(map.find(3) == map.end());
+    REQUIRE(map.size() == 2);
+  }
+}
+
+SCENARIO(
+  "value_set_object_mapt merges like value_sett::insert",
+  "[core][pointer-analysis][value_set_object_map]")
+{
+  value_set_object_mapt dest;
+  dest.insert_or_assign(1, mp_integer{0});
+  dest.insert_or_assign(2, mp_integer{4});
+  dest.insert_or_assign(3, large_offset);
+  dest.insert_or_assign(4, {});
+
+  GIVEN("A map with the same keys and offsets")
+  {
+    value_set_object_mapt src = dest;
+
+    THEN("Merging does not change the destination")
+    {
+      REQUIRE_FALSE(dest.merge_would_change(src));
+      REQUIRE_FALSE(dest.merge(src));
+      REQUIRE(dest == src);
+    }
+  }
+
+  GIVEN("A map with new keys and different offsets")
+  {
+    value_set_object_mapt src;
+    src.insert_or_assign(0, large_offset);
+    src.insert_or_assign(2, mp_integer{8});
+    src.insert_or_assign(3, large_offset);
+    src.insert_or_assign(4, mp_integer{1});
+    src.insert_or_assign(6, {});
+
+    THEN("New keys are added and differing offsets become unknown")
+    {
+      REQUIRE(dest.merge_would_change(src));
+      REQUIRE(dest.merge(src));
+
+      value_set_object_mapt expected;
+      expected.insert_or_assign(0, large_offset);
+      expected.insert_or_assign(1, mp_integer{0});
+      expected.insert_or_assign(2, {});
+      expected.insert_or_assign(3, large_offset);
+      expected.insert_or_assign(4, {});
+      expected.insert_or_assign(6, {});
+      REQUIRE(dest == expected);
+      REQUIRE_FALSE(dest.merge_would_change(src));
+    }
+  }
+
+  GIVEN("A map that only differs in offsets")
+  {
+    value_set_object_mapt src;
+    src.insert_or_assign(1, {});
+
+    THEN("The offset is reset in place")
+    {
+      REQUIRE(dest.merge(src));
+      REQUIRE(dest.size() == 4);
+      REQUIRE_FALSE(dest.find(1)->second.has_value());
+    }
+  }
+}
+
+/// The std::map that value_set_object_mapt replaced
+typedef std::
+  map<value_set_object_mapt::key_type, value_set_object_mapt::mapped_type>
+    reference_mapt;
+
+/// The element-wise merge that value_sett::make_union performed on a
+/// \ref reference_mapt
+static bool reference_merge(reference_mapt &dest, const reference_mapt &src)
+{
+  bool result = false;
+  for(const auto &entry : src)
+  {
+    const auto it = dest.find(entry.first);
+    if(it == dest.end())
+    {
+      dest.insert(entry);
+      result = true;
+    }
+    else if(it->second.has_value() && it->second != entry.second)
+    {
+      it->second.reset();
+      result = true;
+    }
+  }
+  return result;
+}
+
+/// Seconds taken by \p iterations calls of \p f, each of which has to
+/// return true
+template <typename F>
+static double time_calls(std::size_t iterations, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t succeeded = 0;
+  for(std::size_t i = 0; i < iterations; ++i)
+    succeeded += f() ? 1 : 0;
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+  REQUIRE(succeeded == iterations);
+  return duration.count();
+}
+
+// Hidden by default, run with `unit "[benchmark]"`
+SCENARIO(
+  "value_set_object_mapt merges faster than std::map",
+  "[.][benchmark][pointer-analysis][value_set_object_map]")
+{
+  const std::size_t iterations = 200000;
+
+  for(const std::size_t size : {2, 8, 64})
+  {
+    // half of the keys are shared, of which half have differing offsets
+    value_set_object_mapt dest, src;
+    reference_mapt reference_dest, reference_src;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      const mp_integer offset = i % 4 == 0 ? mp_integer{1} : mp_integer{0};
+      dest.insert_or_assign(2 * i, mp_integer{0});
+      reference_dest.emplace(2 * i, mp_integer{0});
+      src.insert_or_assign(i, offset);
+      reference_src.emplace(i, offset);
+    }
+
+    const double reference_time = time_calls(iterations, [&]() {
+      reference_mapt copy = reference_dest;
+      return reference_merge(copy, reference_src);
+    });
+    const double time = time_calls(iterations, [&]() {
+      value_set_object_mapt copy = dest;
+      return copy.merge(src);
+    });
+
+    WARN(
+      "merging maps of " << size << " objects " << iterations
+                         << " times: std::map " << reference_time
+                         << "s, value_set_object_mapt " << time << "s");
+  }
+}
+
+// Hidden by default, run with `unit "[benchmark]"`
+SCENARIO(
+  "value_sett merges and queries object maps",
+  "[.][benchmark][pointer-analysis][value_set_object_map]")
+{
+  const std::size_t iterations = 200000;
+
+  symbol_tablet symbol_table;
+  const namespacet ns{symbol_table};
+  const signedbv_typet int_type{32};
+  const pointer_typet int_ptr{int_type, 64};
+  const symbol_exprt p{"p", int_ptr};
+
+  for(const std::size_t size : {2, 8, 64})
+  {
+    // half of the objects are shared
+    value_sett dest, src;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      const symbol_exprt object{"x" + std::to_string(i), int_type};
+      src.assign(p, address_of_exprt{object}, ns, false, true);
+      if(i % 2 == 0)
+      {
+        dest.assign(
+          p,
+          address_of_exprt{symbol_exprt{"y" + std::to_string(i), int_type}},
+          ns,
+          false,
+          true);
+      }
+      else
+        dest.assign(p, address_of_exprt{object}, ns, false, true);
+    }
+
+    const double union_time = time_calls(iterations, [&]() {
+      value_sett copy{dest};
+      return copy.make_union(src);
+    });
+    const double query_time = time_calls(iterations, [&]() {
+      return dest.get_value_set(p, ns).size() == size;
+    });
+
+    WARN(
+      "value sets of " << size << " objects, " << iterations
+                       << " times: value_sett::make_union " << union_time
+                       << "s, value_sett::get_value_set " << query_time
+                       << "s");
+  }
+}
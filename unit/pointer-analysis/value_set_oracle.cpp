@@ -0,0 +1,180 @@
+/*******************************************************************\
+
+Module: Unit tests for value_set_oraclet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for value_set_oraclet
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+#include <pointer-analysis/value_set_oracle.h>
+#include <testing-utils/use_catch.h>
+
+/// \return The objects in \p values, which have to be object descriptors
+static std::vector<exprt> objects(const std::vector<exprt> &values)
+{
+  std::vector<exprt> result;
+  for(const auto &value : values)
+  {
+    REQUIRE(value.id() == ID_object_descriptor);
+    result.push_back(to_object_descriptor_expr(value).object());
+  }
+  return result;
+}
+
+SCENARIO(
+  "value_set_oraclet combines the values of all program locations",
+  "[core][pointer-analysis][value_set_oracle]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns{symbol_table};
+
+  const typet int_type = signed_int_type();
+  const pointer_typet int_ptr = pointer_type(int_type);
+
+  const symbol_exprt x{"x", int_type};
+  const symbol_exprt y{"y", int_type};
+  const symbol_exprt global{"global", int_ptr};
+  const symbol_exprt heap{"heap", int_ptr};
+  const symbol_exprt parameter{"set_global::p", int_ptr};
+
+  // void set_global(int *p) { global = p; }
+  code_typet::parametert p_parameter{int_ptr};
+  p_parameter.set_identifier(parameter.get_identifier());
+  const code_typet set_global_type{{p_parameter}, empty_typet{}};
+  goto_programt set_global;
+  set_global.add(goto_programt::make_assignment(global, parameter));
+  set_global.add(goto_programt::make_end_function());
+
+  // set_global(&x); set_global(&y); heap = malloc(sizeof(int));
+  goto_programt main;
+  const symbol_exprt set_global_function{"set_global", set_global_type};
+  main.add(goto_programt::make_function_call(
+    code_function_callt{set_global_function, {address_of_exprt{x}}}));
+  main.add(goto_programt::make_function_call(
+    code_function_callt{set_global_function, {address_of_exprt{y}}}));
+  side_effect_exprt allocate{
+    ID_allocate, {from_integer(4, size_type()), false_exprt{}}, int_ptr, {}};
+  allocate.set(ID_C_cxx_alloc_type, int_type);
+  main.add(goto_programt::make_assignment(heap, allocate));
+  main.add(goto_programt::make_end_function());
+
+  unsigned location_number = 0;
+  for(auto &instruction : set_global.instructions)
+    instruction.location_number = location_number++;
+  for(auto &instruction : main.instructions)
+    instruction.location_number = location_number++;
+  const unsigned allocation_site = location_number - 2;
+
+  value_set_oraclet oracle{ns};
+  oracle.add_function("set_global", set_global);
+  oracle.add_function("main", main);
+  oracle.solve();
+
+  THEN("A pointer assigned in a callee points to all arguments")
+  {
+    const auto values = objects(oracle.get_value_set(global));
+    REQUIRE(values.size() == 2);
+    REQUIRE(std::find(values.begin(), values.end(), x) != values.end());
+    REQUIRE(std::find(values.begin(), values.end(), y) != values.end());
+    REQUIRE(oracle.iterations() >= 2);
+  }
+
+  THEN("Allocation sites without registered objects are omitted")
+  {
+    REQUIRE(oracle.get_value_set(heap).empty());
+  }
+
+  WHEN("Objects are registered for the allocation site")
+  {
+    const symbol_exprt object1{"dynamic_object1", int_type};
+    const symbol_exprt object2{"dynamic_object2", int_type};
+    oracle.add_dynamic_object(object1, allocation_site);
+    oracle.add_dynamic_object(object2, allocation_site);
+
+    THEN("Pointers to the allocation site point to all of these objects")
+    {
+      REQUIRE(
+        objects(oracle.get_value_set(heap)) ==
+        std::vector<exprt>{object1, object2});
+    }
+  }
+}
+
+SCENARIO(
+  "value_set_oraclet follows copies made by the C library",
+  "[core][pointer-analysis][value_set_oracle]")
+{
+  symbol_tablet symbol_table;
+
+  const typet int_type = signed_int_type();
+  const pointer_typet int_ptr = pointer_type(int_type);
+  const pointer_typet void_ptr = pointer_type(empty_typet{});
+
+  auto add_variable = [&symbol_table](
+                        const irep_idt &identifier,
+                        const typet &type,
+                        bool is_static_lifetime) {
+    symbolt symbol{identifier, type, ID_C};
+    symbol.base_name = identifier;
+    symbol.is_lvalue = true;
+    symbol.is_static_lifetime = is_static_lifetime;
+    symbol_table.add(symbol);
+    return symbol.symbol_expr();
+  };
+  const symbol_exprt x = add_variable("x", int_type, true);
+  const symbol_exprt local = add_variable("main::1::local", int_type, false);
+  const symbol_exprt to_x = add_variable("to_x", int_ptr, true);
+  const symbol_exprt to_local = add_variable("to_local", int_ptr, true);
+  const symbol_exprt copy_x = add_variable("copy_x", int_ptr, true);
+  const symbol_exprt copy_local = add_variable("copy_local", int_ptr, true);
+
+  auto array_copy = [&void_ptr](const exprt &dest, const exprt &src) {
+    return goto_programt::make_other(codet{
+      ID_array_copy,
+      {typecast_exprt{address_of_exprt{dest}, void_ptr},
+       typecast_exprt{address_of_exprt{src}, void_ptr}}});
+  };
+
+  // to_x = &x; memcpy(&copy_x, &to_x, sizeof(int *));
+  // to_local = &local; memcpy(&copy_local, &to_local, sizeof(int *));
+  goto_programt main;
+  main.add(goto_programt::make_assignment(to_x, address_of_exprt{x}));
+  main.add(array_copy(copy_x, to_x));
+  main.add(goto_programt::make_assignment(to_local, address_of_exprt{local}));
+  main.add(array_copy(copy_local, to_local));
+  main.add(goto_programt::make_end_function());
+
+  unsigned location_number = 0;
+  for(auto &instruction : main.instructions)
+    instruction.location_number = location_number++;
+
+  const namespacet ns{symbol_table};
+  value_set_oraclet oracle{ns};
+  oracle.add_function("main", main);
+  oracle.solve();
+
+  THEN("A pointer copied by array_copy points to the copied objects")
+  {
+    REQUIRE(objects(oracle.get_value_set(copy_x)) == std::vector<exprt>{x});
+  }
+
+  THEN("Function-local objects are answered as unknown")
+  {
+    for(const symbol_exprt &pointer : {to_local, copy_local})
+    {
+      const auto values = oracle.get_value_set(pointer);
+      REQUIRE(values.size() == 1);
+      REQUIRE(values.front().id() == ID_unknown);
+    }
+  }
+}
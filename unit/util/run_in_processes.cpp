@@ -0,0 +1,48 @@
+/*******************************************************************\
+
+Module: Unit test for run_in_processes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/run_in_processes.h>
+#include <util/tempfile.h>
+
+#include <fstream>
+#include <stdexcept>
+
+SCENARIO("run_in_processes", "[core][util][run_in_processes]")
+{
+  std::vector<temporary_filet> files;
+  for(std::size_t job = 0; job < 4; ++job)
+    files.emplace_back("run_in_processes_", ".txt");
+
+  const std::vector<bool> failed =
+    run_in_processes(files, [](std::size_t job, const std::string &file_name) {
+      if(job == 2)
+        throw std::runtime_error("job failed");
+
+      std::ofstream out(file_name);
+      out << job * job << '\n';
+      return job == 3;
+    });
+
+  THEN("Each job writes its own file")
+  {
+    for(std::size_t job : {0, 1, 3})
+    {
+      std::ifstream in(files[job]());
+      std::size_t result;
+      REQUIRE(in >> result);
+      REQUIRE(result == job * job);
+    }
+  }
+
+  THEN("Jobs that return true or throw fail")
+  {
+    REQUIRE(failed == std::vector<bool>{false, false, true, true});
+  }
+}
@@ -0,0 +1,37 @@
+/*******************************************************************\
+
+Module: Unit tests for stable_irep_hashert
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <util/stable_irep_hash.h>
+
+#include <testing-utils/use_catch.h>
+
+TEST_CASE(
+  "stable_irep_hashert does not depend on the string table order",
+  "[core][util][stable_irep_hash]")
+{
+  // add the names to the string table in reverse alphabetical order, such
+  // that named_sub orders them differently from their strings
+  const irep_idt second_name = "stable_irep_hash_test_z";
+  const irep_idt first_name = "stable_irep_hash_test_a";
+  REQUIRE(second_name.get_no() < first_name.get_no());
+
+  irept irep{"test"};
+  irep.set(second_name, "2");
+  irep.set(first_name, "1");
+  irep.set(ID_C_source_location, "ignored");
+
+  stable_irep_hashert hasher;
+
+  std::size_t expected = hash_string("test");
+  expected = hash_combine(expected, hash_string(id2string(first_name)));
+  expected = hash_combine(expected, hasher(irept{"1"}));
+  expected = hash_combine(expected, hash_string(id2string(second_name)));
+  expected = hash_combine(expected, hasher(irept{"2"}));
+
+  REQUIRE(hasher(irep) == expected);
+}